@@ -0,0 +1,186 @@
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <AnchoredElement.h>
+#include <AnchorLayout.h>
+#include <AnchorLayoutBatch.h>
+
+//--------------------------------------------------------------
+//	Compares per-frame anchor cost of the old busy loop, which
+//	re-ran every AnchoredElement each frame, with AnchorLayout,
+//	which only recomputes after a resize, and with the
+//	structure-of-arrays AnchorLayoutBatch.
+//--------------------------------------------------------------
+
+namespace
+{
+	struct Cell
+	{
+		sf::Vector2f position;
+		sf::Vector2f size;
+	};
+
+	// Minimal widget so the batch solver writes into the same kind of storage
+	class CellWidget : public Widget
+	{
+	public:
+		void draw(sf::RenderTarget&) override {}
+		void handleEvent(const sf::RenderTarget&, const sf::Event&) override {}
+		void setPosition(const sf::Vector2f& pos) override { _cell.position = pos; }
+		void setSize(const sf::Vector2f& size) override { _cell.size = size; }
+		sf::FloatRect getBounds() const override { return { _cell.position, _cell.size }; }
+
+	private:
+		Cell _cell;
+	};
+
+	constexpr std::size_t DEFAULT_ELEMENTS = 10000;
+	constexpr std::size_t FRAMES = 600;
+	constexpr std::size_t RESIZE_EVERY = 120;
+
+	using BenchClock = std::chrono::steady_clock;
+
+	double toMicroseconds(BenchClock::duration duration)
+	{
+		return std::chrono::duration<double, std::micro>(duration).count();
+	}
+
+	AnchoredElement::UpdateCallback makeCallback(std::vector<Cell>& cells, std::size_t i)
+	{
+		return [&cells, i](const sf::Vector2f& offset, const sf::Vector2f& size)
+			{
+				cells[i].position = { offset.x, offset.y + static_cast<float>(i) * (size.y + 10.f) };
+				cells[i].size = size;
+			};
+	}
+
+	sf::Vector2u windowSizeForFrame(std::size_t frame)
+	{
+		const unsigned int step = static_cast<unsigned int>(frame / RESIZE_EVERY);
+		return { 800u + step * 16u, 600u + step * 9u };
+	}
+
+	void report(const std::string& name, const std::vector<double>& frameTimes, std::size_t recomputed)
+	{
+		double total = 0.0;
+		double idleTotal = 0.0;
+		double resizeTotal = 0.0;
+		std::size_t idleFrames = 0;
+
+		for (std::size_t frame = 0; frame < frameTimes.size(); ++frame)
+		{
+			total += frameTimes[frame];
+			if (frame % RESIZE_EVERY != 0)
+			{
+				idleTotal += frameTimes[frame];
+				++idleFrames;
+			}
+			else
+			{
+				resizeTotal += frameTimes[frame];
+			}
+		}
+
+		const std::size_t resizeFrames = frameTimes.size() - idleFrames;
+
+		std::cout << std::left << std::setw(16) << name
+			<< " avg/frame: " << std::setw(10) << total / frameTimes.size() << " us"
+			<< " avg/idle frame: " << std::setw(10) << (idleFrames ? idleTotal / idleFrames : 0.0) << " us"
+			<< " avg/resize frame: " << std::setw(10) << (resizeFrames ? resizeTotal / resizeFrames : 0.0) << " us"
+			<< " recomputed: " << recomputed << '\n';
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	const std::size_t elementCount = argc > 1 ? std::stoul(argv[1]) : DEFAULT_ELEMENTS;
+
+	std::vector<Cell> cells(elementCount);
+	std::vector<double> frameTimes(FRAMES);
+
+	std::cout << "Anchored elements: " << elementCount << ", frames: " << FRAMES
+		<< ", resize every " << RESIZE_EVERY << " frames\n";
+
+	// Old behaviour: every element recomputed unconditionally each frame
+	{
+		std::vector<AnchoredElement> anchors;
+		anchors.reserve(elementCount);
+		for (std::size_t i = 0; i < elementCount; ++i)
+		{
+			anchors.emplace_back(AnchorHorizontal::CENTER, AnchorVertical::TOP,
+				sf::Vector2f(-70.f, 20.f), sf::Vector2f(240.f, 50.f), makeCallback(cells, i));
+		}
+
+		std::size_t recomputed = 0;
+		for (std::size_t frame = 0; frame < FRAMES; ++frame)
+		{
+			const sf::Vector2u windowSize = windowSizeForFrame(frame);
+			const auto start = BenchClock::now();
+
+			for (auto& anchor : anchors)
+			{
+				anchor.invalidate();
+				if (anchor.update(windowSize)) ++recomputed;
+			}
+
+			frameTimes[frame] = toMicroseconds(BenchClock::now() - start);
+		}
+
+		report("per-frame", frameTimes, recomputed);
+	}
+
+	// Event driven: the layout only runs after the window size changed
+	{
+		AnchorLayout layout;
+		for (std::size_t i = 0; i < elementCount; ++i)
+		{
+			layout.add(AnchorHorizontal::CENTER, AnchorVertical::TOP,
+				sf::Vector2f(-70.f, 20.f), sf::Vector2f(240.f, 50.f), makeCallback(cells, i));
+		}
+
+		std::size_t recomputed = 0;
+		for (std::size_t frame = 0; frame < FRAMES; ++frame)
+		{
+			const auto start = BenchClock::now();
+
+			layout.setWindowSize(windowSizeForFrame(frame));
+			recomputed += layout.apply();
+
+			frameTimes[frame] = toMicroseconds(BenchClock::now() - start);
+		}
+
+		report("event-driven", frameTimes, recomputed);
+	}
+
+	// Structure of arrays: one arithmetic pass, then one write-back sweep
+	{
+		std::vector<CellWidget> widgets(elementCount);
+
+		AnchorLayoutBatch batch;
+		batch.reserve(elementCount);
+		for (std::size_t i = 0; i < elementCount; ++i)
+		{
+			batch.add(widgets[i], AnchorHorizontal::CENTER, AnchorVertical::TOP,
+				sf::Vector2f(-70.f, 20.f + static_cast<float>(i) * 60.f), sf::Vector2f(240.f, 50.f));
+		}
+
+		std::size_t recomputed = 0;
+		for (std::size_t frame = 0; frame < FRAMES; ++frame)
+		{
+			const auto start = BenchClock::now();
+
+			batch.setWindowSize(windowSizeForFrame(frame));
+			recomputed += batch.apply();
+
+			frameTimes[frame] = toMicroseconds(BenchClock::now() - start);
+		}
+
+		report("soa-batch", frameTimes, recomputed);
+	}
+
+	return EXIT_SUCCESS;
+}
\ No newline at end of file
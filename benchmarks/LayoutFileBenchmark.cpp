@@ -0,0 +1,147 @@
+#include <chrono>
+#include <cstdlib>
+#include <string>
+#include <iomanip>
+#include <iostream>
+#include <filesystem>
+
+#include <GraphicsManager.h>
+
+//--------------------------------------------------------------
+//	Startup cost of a large screen: parsing the text layout
+//	against mapping its compiled cache, building widgets from
+//	the result, and reloading it unchanged.
+//
+//	Usage: LayoutFileBenchmark [widgets] [runs]
+//--------------------------------------------------------------
+
+namespace
+{
+	constexpr std::size_t DEFAULT_WIDGETS = 5000;
+	constexpr std::size_t DEFAULT_RUNS = 20;
+	constexpr std::size_t WIDGETS_PER_STACK = 50;
+
+	using BenchClock = std::chrono::steady_clock;
+
+	double toMilliseconds(BenchClock::duration duration)
+	{
+		return std::chrono::duration<double, std::milli>(duration).count();
+	}
+
+	// Columns of stacked widgets of every type sharing one style
+	std::string generateLayout(std::size_t widgetCount)
+	{
+		std::string source =
+			"style cell\n{\n\tfill 21 21 178\n\thover 20 66 241\n\toutline 255 255 255\n\toutlineThickness 2\n}\n";
+
+		for (std::size_t i = 0; i < widgetCount; ++i)
+		{
+			if (i % WIDGETS_PER_STACK == 0)
+			{
+				if (i) source += "}\n";
+				source += "stack column" + std::to_string(i / WIDGETS_PER_STACK) + "\n{\n";
+				source += "\toffset " + std::to_string((i / WIDGETS_PER_STACK) * 170) + " 0\n\tsize 160 30\n\tspacing 4\n";
+			}
+
+			const std::string name = "w" + std::to_string(i);
+			switch (i % 4)
+			{
+			case 0:
+				source += "\tbutton " + name + "\n\t{\n\t\tstyle cell\n\t\ttext \"Button " + std::to_string(i) + "\"\n\t}\n";
+				break;
+			case 1:
+				source += "\tcheckbox " + name + "\n\t{\n\t\ttext \"Check " + std::to_string(i) + "\"\n\t\tchecked true\n\t}\n";
+				break;
+			case 2:
+				source += "\ttextfield " + name + "\n\t{\n\t\tcharSize 14\n\t\tmaxLength 64\n\t}\n";
+				break;
+			default:
+				source += "\tprogressbar " + name + "\n\t{\n\t\tstyle cell\n\t\tpercentage true\n\t\tvalue 42\n\t}\n";
+				break;
+			}
+		}
+
+		if (widgetCount) source += "}\n";
+		return source;
+	}
+
+	template<class Function>
+	double averageMilliseconds(std::size_t runs, Function&& function)
+	{
+		const auto start = BenchClock::now();
+		for (std::size_t run = 0; run < runs; ++run) function();
+
+		return toMilliseconds(BenchClock::now() - start) / static_cast<double>(runs);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	const std::size_t widgetCount = argc > 1 ? std::stoul(argv[1]) : DEFAULT_WIDGETS;
+	const std::size_t runs = argc > 2 ? std::stoul(argv[2]) : DEFAULT_RUNS;
+
+	const std::string source = generateLayout(widgetCount);
+	const std::string cachePath = (std::filesystem::temp_directory_path() / "LayoutFileBenchmark.layoutc").string();
+
+	try
+	{
+		if (!LayoutDocument::parse(source, "generated").save(cachePath))
+		{
+			std::cerr << "Failed to write " << cachePath << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		std::size_t nodes = 0;
+		const double parseTime = averageMilliseconds(runs, [&]()
+			{
+				nodes += LayoutDocument::parse(source, "generated").getNodes().size();
+			});
+
+		const double mapTime = averageMilliseconds(runs, [&]()
+			{
+				nodes += LayoutDocument::loadBinary(cachePath).getNodes().size();
+			});
+
+		WidgetContainer container;
+		LayoutBindings bindings;
+
+		// The first build also loads and rasterizes the fonts; keep that out of the average
+		{
+			LayoutInstance warmUp(LayoutDocument::loadBinary(cachePath), container, bindings);
+		}
+
+		const double buildTime = averageMilliseconds(runs, [&]()
+			{
+				LayoutInstance instance(LayoutDocument::loadBinary(cachePath), container, bindings);
+				instance.setWindowSize({ 1920, 1080 });
+				instance.apply();
+			});
+
+		// What a hot reload of an unchanged file costs: every widget is kept, only placement is redone
+		LayoutInstance instance(LayoutDocument::loadBinary(cachePath), container, bindings);
+		instance.setWindowSize({ 1920, 1080 });
+
+		std::size_t rebuilt = 0;
+		const double reloadTime = averageMilliseconds(runs, [&]()
+			{
+				rebuilt += instance.reload(LayoutDocument::loadBinary(cachePath));
+				instance.apply();
+			});
+
+		std::cout << "Widgets: " << widgetCount << ", source " << source.size() / 1024 << " KiB, runs: " << runs << '\n'
+			<< std::fixed << std::setprecision(3)
+			<< "parse text   " << std::setw(9) << parseTime << " ms\n"
+			<< "map compiled " << std::setw(9) << mapTime << " ms\n"
+			<< "map + build  " << std::setw(9) << buildTime << " ms\n"
+			<< "reload       " << std::setw(9) << reloadTime << " ms (" << rebuilt << " widgets rebuilt)\n"
+			<< "(nodes seen: " << nodes << ")\n";
+	}
+	catch (const std::exception& exception)
+	{
+		std::cerr << "BENCHMARK ERROR: " << exception.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::filesystem::remove(cachePath);
+	return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,594 @@
+#include <new>
+#include <chrono>
+#include <atomic>
+#include <random>
+#include <vector>
+#include <memory>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <algorithm>
+
+#include <SFML/Graphics/RenderTexture.hpp>
+
+#include <GraphicsManager.h>
+
+//--------------------------------------------------------------
+//	Headless widget benchmark. Builds N widgets of every type,
+//	replays a deterministic synthetic event stream through the
+//	WidgetContainer and renders offscreen into a render texture.
+//	The immediate run declares the same widgets through
+//	ImmediateUi every frame. The skinned runs draw the widgets
+//	with nine-slice skins, once from a texture per skin and once
+//	from a packed atlas.
+//
+//	Every allocation is counted. Once the warm-up frames are over
+//	a frame must not allocate; the benchmark fails if one does.
+//	The serial run repeats the retained one with the JobSystem
+//	down to the calling thread, and a still frame recorded both
+//	ways has to come out pixel for pixel the same.
+//
+//	Usage: WidgetBenchmark [widgetsPerType] [frames]
+//	Without a display, run it under a virtual one (xvfb-run) or
+//	with a software GL driver (LIBGL_ALWAYS_SOFTWARE=1).
+//--------------------------------------------------------------
+
+namespace
+{
+	std::atomic<std::size_t> allocationCount{ 0 };
+}
+
+void* operator new(std::size_t size)
+{
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+
+	if (void* memory = std::malloc(size ? size : 1))
+	{
+		return memory;
+	}
+
+	throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+	std::free(memory);
+}
+
+namespace
+{
+	using BenchClock = std::chrono::steady_clock;
+
+	constexpr std::size_t DEFAULT_WIDGETS_PER_TYPE = 250;
+	constexpr std::size_t DEFAULT_FRAMES = 300;
+	// Not measured: widgets create their tweens, glyph layouts and buffers here
+	constexpr std::size_t WARM_UP_FRAMES = 60;
+	constexpr std::size_t EVENTS_PER_FRAME = 8;
+	// A click frame sends the release on top of the press
+	constexpr std::size_t MAX_EVENTS_PER_FRAME = EVENTS_PER_FRAME + 1;
+	constexpr unsigned int CANVAS_WIDTH = 1920;
+	constexpr unsigned int CANVAS_HEIGHT = 1080;
+	constexpr float CELL_WIDTH = 180.f;
+	constexpr float CELL_HEIGHT = 40.f;
+	constexpr unsigned int SKIN_SIZE = 24;
+	constexpr int SKIN_BORDER = 6;
+	constexpr unsigned int TEXT_FIELD_LENGTH = 64;
+
+	enum class RenderMode { Direct, Batched, Retained };
+
+	struct FrameStatistics
+	{
+		std::vector<double> frameTimes;
+		std::vector<double> eventLatencies;
+		std::size_t drawCalls = 0;
+		std::size_t vertices = 0;
+		std::size_t allocations = 0;
+		std::size_t allocatingFrames = 0;
+		std::size_t coalescedEvents = 0;
+		std::size_t presentedFrames = 0;
+	};
+
+	struct Scene
+	{
+		std::vector<std::unique_ptr<Button>> buttons;
+		std::vector<std::unique_ptr<CheckBox>> checkboxes;
+		std::vector<std::unique_ptr<TextField>> textFields;
+		std::vector<std::unique_ptr<ProgressBar>> progressBars;
+
+		WidgetContainer container;
+	};
+
+	struct SkinSet
+	{
+		const AtlasRegion* button = nullptr;
+		const AtlasRegion* box = nullptr;
+		const AtlasRegion* checkMark = nullptr;
+		const AtlasRegion* barBackground = nullptr;
+		const AtlasRegion* barFill = nullptr;
+	};
+
+	struct SkinImage
+	{
+		std::string name;
+		sf::Image image;
+		NineSlice slice;
+	};
+
+	// White so the widget colours tint it, with a grey frame to show the borders keep their size
+	sf::Image generatePanel(const sf::Color& frame)
+	{
+		sf::Image image;
+		image.create(SKIN_SIZE, SKIN_SIZE, sf::Color::White);
+
+		for (unsigned int y = 0; y < SKIN_SIZE; ++y)
+		{
+			for (unsigned int x = 0; x < SKIN_SIZE; ++x)
+			{
+				const unsigned int edge = std::min({ x, y, SKIN_SIZE - 1 - x, SKIN_SIZE - 1 - y });
+				if (edge < SKIN_BORDER / 2) image.setPixel(x, y, frame);
+			}
+		}
+
+		return image;
+	}
+
+	sf::Image generateCheckMark()
+	{
+		sf::Image image;
+		image.create(SKIN_SIZE, SKIN_SIZE, sf::Color::Transparent);
+
+		for (unsigned int i = 0; i < SKIN_SIZE; ++i)
+		{
+			image.setPixel(i, i, sf::Color::White);
+			image.setPixel(SKIN_SIZE - 1 - i, i, sf::Color::White);
+		}
+
+		return image;
+	}
+
+	std::vector<SkinImage> generateSkins()
+	{
+		const NineSlice slice{ SKIN_BORDER, SKIN_BORDER, SKIN_BORDER, SKIN_BORDER };
+
+		std::vector<SkinImage> skins;
+		skins.push_back({ "button", generatePanel(sf::Color(90, 90, 90)), slice });
+		skins.push_back({ "box", generatePanel(sf::Color(40, 40, 40)), slice });
+		skins.push_back({ "checkMark", generateCheckMark(), {} });
+		skins.push_back({ "barBackground", generatePanel(sf::Color(20, 20, 20)), slice });
+		skins.push_back({ "barFill", generatePanel(sf::Color(200, 200, 200)), slice });
+
+		return skins;
+	}
+
+	template<class Find>
+	SkinSet makeSkinSet(Find&& find)
+	{
+		return { find("button"), find("box"), find("checkMark"), find("barBackground"), find("barFill") };
+	}
+
+	double toMicroseconds(BenchClock::duration duration)
+	{
+		return std::chrono::duration<double, std::micro>(duration).count();
+	}
+
+	sf::Vector2f cellPosition(std::size_t index)
+	{
+		const std::size_t columns = static_cast<std::size_t>(CANVAS_WIDTH / CELL_WIDTH);
+		const std::size_t rows = static_cast<std::size_t>(CANVAS_HEIGHT / CELL_HEIGHT);
+
+		const std::size_t cell = index % (columns * rows);
+		return
+		{
+			static_cast<float>(cell % columns) * CELL_WIDTH,
+			static_cast<float>(cell / columns) * CELL_HEIGHT
+		};
+	}
+
+	void buildScene(Scene& scene, std::size_t widgetsPerType, const SkinSet* skins = nullptr)
+	{
+		DefaultButtonFactory buttonFactory;
+		DefaultCheckBoxFactory checkBoxFactory;
+
+		std::size_t cell = 0;
+
+		for (std::size_t i = 0; i < widgetsPerType; ++i)
+		{
+			auto button = buttonFactory.createButton("Button " + std::to_string(i), cellPosition(cell++), { 160.f, 32.f });
+			scene.container.add(*button);
+			scene.buttons.push_back(std::move(button));
+
+			auto checkbox = checkBoxFactory.createCheckBox("Check " + std::to_string(i), cellPosition(cell++));
+			scene.container.add(*checkbox);
+			scene.checkboxes.push_back(std::move(checkbox));
+
+			auto textField = std::make_unique<TextField>();
+			textField->setSize({ 160.f, 32.f });
+			textField->setMaxLength(TEXT_FIELD_LENGTH);
+			textField->setPosition(cellPosition(cell++));
+			scene.container.add(*textField);
+			scene.textFields.push_back(std::move(textField));
+
+			auto progressBar = std::make_unique<ProgressBar>(sf::Vector2f(160.f, 32.f), sf::Color(50, 50, 50), sf::Color::Green);
+			progressBar->setPosition(cellPosition(cell++));
+			progressBar->showPercentage(true, 14);
+			scene.container.add(*progressBar);
+			scene.progressBars.push_back(std::move(progressBar));
+
+			if (skins)
+			{
+				scene.buttons.back()->setSkin(skins->button);
+				scene.checkboxes.back()->setSkin(skins->box, skins->checkMark);
+				scene.progressBars.back()->setSkin(skins->barBackground, skins->barFill);
+			}
+		}
+	}
+
+	// Deterministic stream: cursor sweeps, periodic clicks and typing
+	void generateEvents(std::mt19937& random, std::size_t frame, std::vector<sf::Event>& events)
+	{
+		std::uniform_int_distribution<int> xDistribution(0, static_cast<int>(CANVAS_WIDTH) - 1);
+		std::uniform_int_distribution<int> yDistribution(0, static_cast<int>(CANVAS_HEIGHT) - 1);
+
+		events.clear();
+
+		for (std::size_t i = 0; i < EVENTS_PER_FRAME; ++i)
+		{
+			sf::Event event{};
+			const int x = xDistribution(random);
+			const int y = yDistribution(random);
+
+			if (frame % 10 == 0 && i == 0)
+			{
+				event.type = sf::Event::MouseButtonPressed;
+				event.mouseButton = { sf::Mouse::Left, x, y };
+				events.push_back(event);
+
+				event.type = sf::Event::MouseButtonReleased;
+				events.push_back(event);
+			}
+			else if (i % 4 == 3)
+			{
+				event.type = sf::Event::TextEntered;
+				event.text.unicode = static_cast<sf::Uint32>('a' + (frame + i) % 26);
+				events.push_back(event);
+			}
+			else
+			{
+				event.type = sf::Event::MouseMoved;
+				event.mouseMove = { x, y };
+				events.push_back(event);
+			}
+		}
+	}
+
+	void record(FrameStatistics& statistics, BenchClock::time_point frameStart, std::size_t allocationsBefore,
+		const BatchRenderer& renderer, bool isPresented)
+	{
+		const std::size_t allocations = allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+
+		statistics.frameTimes.push_back(toMicroseconds(BenchClock::now() - frameStart));
+		statistics.allocations += allocations;
+		if (allocations > 0) ++statistics.allocatingFrames;
+		statistics.drawCalls += renderer.getStatistics().drawCalls;
+		statistics.vertices += renderer.getStatistics().vertices;
+		if (isPresented) ++statistics.presentedFrames;
+	}
+
+	FrameStatistics runMode(RenderMode mode, std::size_t widgetsPerType, std::size_t frames, sf::RenderTexture& texture,
+		const SkinSet* skins = nullptr)
+	{
+		Scene scene;
+		buildScene(scene, widgetsPerType, skins);
+
+		BatchRenderer renderer;
+		RetainedCanvas canvas;
+		canvas.create(texture.getSize());
+
+		std::mt19937 random(1337);
+		std::vector<sf::Event> events;
+		events.reserve(MAX_EVENTS_PER_FRAME);
+		InputQueue input;
+
+		FrameStatistics statistics;
+		statistics.frameTimes.reserve(frames);
+		statistics.eventLatencies.reserve(frames * MAX_EVENTS_PER_FRAME);
+
+		for (std::size_t frame = 0; frame < WARM_UP_FRAMES + frames; ++frame)
+		{
+			const bool isMeasured = frame >= WARM_UP_FRAMES;
+			generateEvents(random, frame, events);
+
+			const std::size_t allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+			const auto frameStart = BenchClock::now();
+
+			for (const auto& event : events)
+			{
+				input.push(event);
+			}
+
+			for (const auto& event : input)
+			{
+				const auto eventStart = BenchClock::now();
+				scene.container.dispatch(texture, event);
+				if (isMeasured) statistics.eventLatencies.push_back(toMicroseconds(BenchClock::now() - eventStart));
+			}
+
+			statistics.coalescedEvents += input.getCoalescedCount();
+			input.clear();
+
+			for (std::size_t i = 0; i < scene.progressBars.size(); ++i)
+			{
+				scene.progressBars[i]->setValue(static_cast<float>((frame * 7 + i) % 101));
+			}
+
+			renderer.resetStatistics();
+			bool isPresented = true;
+
+			switch (mode)
+			{
+			case RenderMode::Direct:
+				texture.clear();
+				for (Widget* widget : scene.container.getWidgets())
+				{
+					widget->draw(texture);
+				}
+				texture.display();
+				break;
+			case RenderMode::Batched:
+				texture.clear();
+				renderer.begin(texture);
+				for (Widget* widget : scene.container.getWidgets())
+				{
+					widget->draw(renderer);
+				}
+				renderer.end();
+				texture.display();
+				break;
+			case RenderMode::Retained:
+				isPresented = canvas.update(scene.container.getWidgets(), renderer);
+				if (isPresented)
+				{
+					texture.clear();
+					canvas.present(texture);
+					texture.display();
+				}
+				break;
+			}
+
+			if (isMeasured) record(statistics, frameStart, allocationsBefore, renderer, isPresented);
+		}
+
+		return statistics;
+	}
+
+	// The same widgets declared through ImmediateUi every frame
+	FrameStatistics runImmediate(std::size_t widgetsPerType, std::size_t frames, sf::RenderTexture& texture)
+	{
+		std::vector<std::string> buttonLabels;
+		std::vector<std::string> checkBoxLabels;
+		std::vector<std::string> progressIds;
+		std::vector<bool> checked(widgetsPerType);
+
+		for (std::size_t i = 0; i < widgetsPerType; ++i)
+		{
+			buttonLabels.push_back("Button " + std::to_string(i));
+			checkBoxLabels.push_back("Check " + std::to_string(i));
+			progressIds.push_back("progress" + std::to_string(i));
+		}
+
+		ImmediateUi ui;
+		ui.setSize({ 160.f, 0.f });
+
+		BatchRenderer renderer;
+
+		std::mt19937 random(1337);
+		std::vector<sf::Event> events;
+		events.reserve(MAX_EVENTS_PER_FRAME);
+
+		FrameStatistics statistics;
+		statistics.frameTimes.reserve(frames);
+		statistics.eventLatencies.reserve(frames * MAX_EVENTS_PER_FRAME);
+
+		for (std::size_t frame = 0; frame < WARM_UP_FRAMES + frames; ++frame)
+		{
+			const bool isMeasured = frame >= WARM_UP_FRAMES;
+			generateEvents(random, frame, events);
+
+			const std::size_t allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+			const auto frameStart = BenchClock::now();
+
+			for (const auto& event : events)
+			{
+				const auto eventStart = BenchClock::now();
+				ui.handleEvent(texture, event);
+				if (isMeasured) statistics.eventLatencies.push_back(toMicroseconds(BenchClock::now() - eventStart));
+			}
+
+			ui.begin();
+			for (std::size_t i = 0; i < widgetsPerType; ++i)
+			{
+				ui.button(buttonLabels[i]);
+
+				bool isChecked = checked[i];
+				if (ui.checkbox(checkBoxLabels[i], isChecked)) checked[i] = isChecked;
+
+				ui.progress(progressIds[i], static_cast<float>((frame * 7 + i) % 101));
+			}
+			ui.end();
+
+			renderer.resetStatistics();
+			texture.clear();
+			renderer.begin(texture);
+			ui.draw(renderer);
+			renderer.end();
+			texture.display();
+
+			if (isMeasured) record(statistics, frameStart, allocationsBefore, renderer, true);
+		}
+
+		return statistics;
+	}
+
+	double percentile(std::vector<double> values, double fraction)
+	{
+		if (values.empty()) return 0.0;
+
+		const std::size_t index = std::min(values.size() - 1,
+			static_cast<std::size_t>(fraction * static_cast<double>(values.size())));
+		std::nth_element(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(index), values.end());
+
+		return values[index];
+	}
+
+	double average(const std::vector<double>& values)
+	{
+		if (values.empty()) return 0.0;
+
+		double total = 0.0;
+		for (double value : values) total += value;
+
+		return total / static_cast<double>(values.size());
+	}
+
+	// One full repaint of a fresh scene, for comparing serial and parallel recording; no events, so no timing
+	sf::Image renderStill(std::size_t widgetsPerType)
+	{
+		Scene scene;
+		buildScene(scene, widgetsPerType);
+
+		BatchRenderer renderer;
+		RetainedCanvas canvas;
+		canvas.create({ CANVAS_WIDTH, CANVAS_HEIGHT });
+		canvas.update(scene.container.getWidgets(), renderer);
+
+		return canvas.getTexture().copyToImage();
+	}
+
+	bool isSameImage(const sf::Image& a, const sf::Image& b)
+	{
+		const sf::Vector2u size = a.getSize();
+		if (size != b.getSize()) return false;
+
+		return std::memcmp(a.getPixelsPtr(), b.getPixelsPtr(), static_cast<std::size_t>(size.x) * size.y * 4) == 0;
+	}
+
+	// False when a measured frame allocated
+	bool report(const std::string& name, const FrameStatistics& statistics)
+	{
+		const double frames = static_cast<double>(statistics.frameTimes.size());
+
+		std::cout << std::left << std::setw(10) << name << std::fixed << std::setprecision(1)
+			<< " frame avg " << std::setw(9) << average(statistics.frameTimes)
+			<< " p50 " << std::setw(9) << percentile(statistics.frameTimes, 0.5)
+			<< " p99 " << std::setw(9) << percentile(statistics.frameTimes, 0.99) << " us |"
+			<< " event avg " << std::setw(6) << average(statistics.eventLatencies)
+			<< " p99 " << std::setw(6) << percentile(statistics.eventLatencies, 0.99) << " us |"
+			<< " draws/frame " << std::setw(7) << static_cast<double>(statistics.drawCalls) / frames
+			<< " vertices/frame " << std::setw(9) << static_cast<double>(statistics.vertices) / frames
+			<< " allocs/frame " << std::setw(8) << static_cast<double>(statistics.allocations) / frames
+			<< " coalesced/frame " << std::setw(5) << static_cast<double>(statistics.coalescedEvents) / frames
+			<< " presented " << statistics.presentedFrames
+			<< " allocating frames " << statistics.allocatingFrames << '\n';
+
+		return statistics.allocatingFrames == 0;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	const std::size_t widgetsPerType = argc > 1 ? std::stoul(argv[1]) : DEFAULT_WIDGETS_PER_TYPE;
+	const std::size_t frames = argc > 2 ? std::stoul(argv[2]) : DEFAULT_FRAMES;
+
+	sf::RenderTexture texture;
+	if (!texture.create(CANVAS_WIDTH, CANVAS_HEIGHT))
+	{
+		std::cerr << "Failed to create an offscreen render texture (is a GL context available?)" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::cout << "Widgets per type: " << widgetsPerType << " (" << widgetsPerType * 4 << " total), frames: " << frames
+		<< " after " << WARM_UP_FRAMES << " warm-up frames, events/frame: " << EVENTS_PER_FRAME << '\n';
+	std::cout << "Draw calls are counted for batched submissions only\n";
+	std::cout << "Job system workers: " << JobSystem::getInstance().getWorkerCount() << " besides the calling thread\n";
+	// Colours, font and outline live in the shared ButtonStyle, not in every button
+	std::cout << "sizeof(Button): " << sizeof(Button) << " bytes, sizeof(ButtonStyle): " << sizeof(ButtonStyle) << " bytes\n";
+
+	bool isAllocationFree = true;
+	bool isParallelIdentical = true;
+
+	try
+	{
+		isAllocationFree &= report("direct", runMode(RenderMode::Direct, widgetsPerType, frames, texture));
+		isAllocationFree &= report("batched", runMode(RenderMode::Batched, widgetsPerType, frames, texture));
+
+		JobSystem& jobs = JobSystem::getInstance();
+		const std::size_t workerCount = jobs.getWorkerCount();
+
+		jobs.setWorkerCount(0);
+		const sf::Image serialStill = renderStill(widgetsPerType);
+		isAllocationFree &= report("serial", runMode(RenderMode::Retained, widgetsPerType, frames, texture));
+		jobs.setWorkerCount(workerCount);
+
+		isParallelIdentical = isSameImage(serialStill, renderStill(widgetsPerType));
+		isAllocationFree &= report("retained", runMode(RenderMode::Retained, widgetsPerType, frames, texture));
+		isAllocationFree &= report("immediate", runImmediate(widgetsPerType, frames, texture));
+
+		const std::vector<SkinImage> skinImages = generateSkins();
+
+		// One texture per skin: every skin is its own batch
+		std::vector<TextureAtlas> separate;
+		for (const SkinImage& skin : skinImages)
+		{
+			TextureAtlasBuilder builder;
+			builder.add(skin.name, skin.image, skin.slice);
+			separate.emplace_back(builder.pack());
+		}
+
+		const SkinSet separateSkins = makeSkinSet([&separate](const std::string& name)
+			{
+				const AtlasRegion* region = nullptr;
+				for (const TextureAtlas& atlas : separate)
+				{
+					if (!region) region = atlas.find(name);
+				}
+				return region;
+			});
+		isAllocationFree &= report("skinned", runMode(RenderMode::Batched, widgetsPerType, frames, texture, &separateSkins));
+
+		TextureAtlasBuilder builder;
+		for (const SkinImage& skin : skinImages)
+		{
+			builder.add(skin.name, skin.image, skin.slice);
+		}
+
+		const TextureAtlas atlas(builder.pack());
+		const SkinSet atlasSkins = makeSkinSet([&atlas](const std::string& name) { return &atlas.get(name); });
+		isAllocationFree &= report("atlas", runMode(RenderMode::Batched, widgetsPerType, frames, texture, &atlasSkins));
+	}
+	catch (const std::exception& exception)
+	{
+		std::cerr << "BENCHMARK ERROR: " << exception.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if (!isAllocationFree)
+	{
+		std::cerr << "BENCHMARK FAILED: frames allocated after the warm-up" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if (!isParallelIdentical)
+	{
+		std::cerr << "BENCHMARK FAILED: the parallel frame differs from the serial one" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,64 @@
+#ifndef ANCHOR_LAYOUT_HPP
+#define ANCHOR_LAYOUT_HPP
+
+#include <vector>
+#include <cstddef>
+
+#include <AnchoredElement.h>
+
+namespace AnchorLayoutConstants
+{
+	// Elements per job; smaller layouts are computed on the calling thread
+	constexpr std::size_t PARALLEL_CHUNK = 1024;
+}
+
+//--------------------------------------------------------------
+//	Owns anchored elements and recomputes them only after the
+//	window was resized or something was invalidated. Calling
+//	apply() on an idle frame costs a single flag check.
+//
+//	Positions are computed in parallel through the JobSystem;
+//	the callbacks then run on the calling thread in the order
+//	the elements were added, as they would without it.
+//--------------------------------------------------------------
+
+class AnchorLayout
+{
+public:
+	std::size_t add(AnchorHorizontal horizAnchor,
+		AnchorVertical vertAnchor,
+		const sf::Vector2f& offset,
+		const sf::Vector2f& size,
+		AnchoredElement::UpdateCallback const& callback);
+
+	void setWindowSize(const sf::Vector2u& windowSize);
+	void invalidate();
+	void invalidate(std::size_t index);
+
+	// Returns the number of elements that were recomputed
+	std::size_t apply();
+
+	void setOffset(std::size_t index, const sf::Vector2f& offset);
+	void setSize(std::size_t index, const sf::Vector2f& size);
+
+	std::size_t size() const;
+	void clear();
+
+private:
+	struct Result
+	{
+		sf::Vector2f position;
+		sf::Vector2f size;
+		bool isComputed;
+	};
+
+	std::vector<AnchoredElement> _elements;
+	// Filled in parallel by apply(), one per element
+	std::vector<Result> _results;
+	// Counts setOffset and friends, so apply() notices callbacks that change the layout under it
+	std::size_t _edits = 0;
+	sf::Vector2u _windowSize;
+	bool _isDirty = true;
+};
+
+#endif //ANCHOR_LAYOUT_HPP
\ No newline at end of file
@@ -0,0 +1,83 @@
+#ifndef ANCHOR_LAYOUT_BATCH_HPP
+#define ANCHOR_LAYOUT_BATCH_HPP
+
+#include <vector>
+#include <cstddef>
+
+#include <SFML/System/Vector2.hpp>
+
+#include <AnchoredElement.h>
+#include <Graphics/InterfaceElements/Widget.h>
+
+namespace AnchorLayoutBatchConstants
+{
+	// Widgets per job in apply(); the arithmetic is cheap, so chunks are large
+	constexpr std::size_t PARALLEL_CHUNK = 8192;
+}
+
+//--------------------------------------------------------------
+//	Structure-of-arrays anchor solver for large widget counts.
+//
+//	Every anchor mode is reduced to per-axis coefficients:
+//		position = offset + anchor * window + pull * size
+//		size     = size + stretch * (window - 2 * offset - size)
+//	so the whole layout is one branch-free pass over contiguous
+//	float arrays. Results are written back to widgets afterwards,
+//	skipping the ones whose geometry did not change.
+//--------------------------------------------------------------
+
+class AnchorLayoutBatch
+{
+public:
+	std::size_t add(Widget& widget,
+		AnchorHorizontal horizAnchor,
+		AnchorVertical vertAnchor,
+		const sf::Vector2f& offset,
+		const sf::Vector2f& size);
+
+	void reserve(std::size_t count);
+	void clear();
+
+	void setWindowSize(const sf::Vector2u& windowSize);
+	void invalidate();
+
+	// compute() over JobSystem chunks followed by writeBack() when the layout is dirty
+	std::size_t apply();
+
+	// Pure arithmetic over [first, last), safe to run on disjoint ranges in parallel
+	void compute(std::size_t first, std::size_t last);
+	std::size_t writeBack();
+
+	sf::Vector2f getPosition(std::size_t index) const;
+	sf::Vector2f getSize(std::size_t index) const;
+	std::size_t size() const;
+
+private:
+	struct Axis
+	{
+		std::vector<float> offset;
+		std::vector<float> size;
+		std::vector<float> anchor;
+		std::vector<float> pull;
+		std::vector<float> stretch;
+
+		std::vector<float> outPosition;
+		std::vector<float> outSize;
+		std::vector<float> appliedPosition;
+		std::vector<float> appliedSize;
+
+		void push(float offsetValue, float sizeValue, float anchorValue, float pullValue, float stretchValue);
+		void reserve(std::size_t count);
+		void clear();
+		void compute(float window, std::size_t first, std::size_t last);
+	};
+
+	Axis _x;
+	Axis _y;
+	std::vector<Widget*> _widgets;
+
+	sf::Vector2u _windowSize;
+	bool _isDirty = true;
+};
+
+#endif //ANCHOR_LAYOUT_BATCH_HPP
\ No newline at end of file
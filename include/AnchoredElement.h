@@ -19,7 +19,17 @@ public:
 		const sf::Vector2f& size,
 		UpdateCallback const& callback);
 
-	void update(const sf::Vector2u& windowSize);
+	// Recomputes only when the window size changed or the element was invalidated
+	bool update(const sf::Vector2u& windowSize);
+	void invalidate();
+
+	// update() in two steps, so the arithmetic can run on any thread and the callback on the UI thread
+	bool needsUpdate(const sf::Vector2u& windowSize) const;
+	void compute(const sf::Vector2u& windowSize, sf::Vector2f& position, sf::Vector2f& size) const;
+	void commit(const sf::Vector2u& windowSize, const sf::Vector2f& position, const sf::Vector2f& size);
+
+	void setOffset(const sf::Vector2f& offset);
+	void setSize(const sf::Vector2f& size);
 
 private:
 	AnchorHorizontal _horizAnchor;
@@ -28,6 +38,8 @@ private:
 	sf::Vector2f _size;
 	UpdateCallback _callback;
 
+	sf::Vector2u _lastWindowSize;
+	bool _isDirty = true;
 };
 
 #endif //ANCHORED_ELEMENT_HPP
\ No newline at end of file
@@ -0,0 +1,124 @@
+#ifndef ANIMATION_SCHEDULER_HPP
+#define ANIMATION_SCHEDULER_HPP
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <variant>
+#include <functional>
+#include <unordered_map>
+
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/System/Clock.hpp>
+#include <SFML/System/Vector2.hpp>
+
+enum class Easing { Linear, InQuad, OutQuad, InOutQuad, OutCubic, InOutCubic };
+
+float ease(Easing easing, float t);
+
+namespace AnimationSchedulerConstants
+{
+	// Tweens per job when their values are computed; fewer run on the calling thread
+	constexpr std::size_t PARALLEL_CHUNK = 2048;
+}
+
+//--------------------------------------------------------------
+//	Advances every running tween in one pass per frame. A tween
+//	is keyed by its owner and a channel: starting another one on
+//	the same key replaces it, so widgets simply retarget on each
+//	state change. Owners must cancel their tweens before they
+//	are destroyed. Main thread only: the values are computed
+//	through the JobSystem, but the setters run on the calling
+//	thread, in the order the tweens were started.
+//--------------------------------------------------------------
+
+class AnimationScheduler
+{
+public:
+	using Channel = std::uint32_t;
+
+	static AnimationScheduler& getInstance();
+
+	void tween(const void* owner, Channel channel, float from, float to,
+		float duration, Easing easing, std::function<void(float)> apply, float delay = 0.f);
+	void tween(const void* owner, Channel channel, const sf::Vector2f& from, const sf::Vector2f& to,
+		float duration, Easing easing, std::function<void(const sf::Vector2f&)> apply, float delay = 0.f);
+	void tween(const void* owner, Channel channel, const sf::Color& from, const sf::Color& to,
+		float duration, Easing easing, std::function<void(const sf::Color&)> apply, float delay = 0.f);
+
+	void cancel(const void* owner);
+	void cancel(const void* owner, Channel channel);
+	// Jumps the owner's tweens to their end values
+	void complete(const void* owner);
+	bool isAnimating(const void* owner) const;
+
+	// Advances by the time since the previous tick; returns false once nothing is running
+	bool tick();
+	bool tick(float deltaTime);
+
+	bool isIdle() const;
+	std::size_t getActiveCount() const;
+
+private:
+	AnimationScheduler() = default;
+	AnimationScheduler(const AnimationScheduler&) = delete;
+	AnimationScheduler& operator=(const AnimationScheduler&) = delete;
+
+	// Kept as the caller passed it: wrapping it in another std::function would allocate for every tween
+	using Apply = std::variant<std::function<void(float)>,
+		std::function<void(const sf::Vector2f&)>,
+		std::function<void(const sf::Color&)>>;
+
+	struct Tween
+	{
+		const void* owner;
+		Channel channel;
+		std::size_t components;
+		float from[4];
+		float to[4];
+		float elapsed;
+		float duration;
+		float delay;
+		Easing easing;
+		Apply apply;
+		bool isAlive;
+
+		// This tick's value, set by advance()
+		float value[4] = {};
+		bool isDue = false;
+		bool isFinishing = false;
+	};
+
+	// Where the live tween of one owner and channel is stored
+	struct Slot
+	{
+		Channel channel;
+		std::size_t index;
+		bool isPending;
+	};
+
+	// Moves the tween on by deltaTime and computes its value; touches nothing but the tween
+	static void advance(Tween& tween, float deltaTime);
+	static void apply(Tween& tween, const float* value);
+	void start(Tween&& tween);
+
+	Tween& at(const Slot& slot);
+	// Position of the channel's slot, or slots.size() when the owner has none on it
+	static std::size_t find(const std::vector<Slot>& slots, Channel channel);
+	// Marks the tween dead and drops it from the index; it leaves the list on the next compaction
+	void kill(std::vector<Slot>& slots, std::size_t position);
+	void kill(const Tween& tween);
+	Slot& slotOf(const Tween& tween);
+	void adoptPending();
+	void removeFinished();
+
+	std::vector<Tween> _tweens;
+	std::vector<Tween> _pending;
+	// Live tweens by owner; an owner's entry stays when it empties so retargeting never allocates
+	std::unordered_map<const void*, std::vector<Slot>> _slots;
+	std::size_t _aliveCount = 0;
+	bool _isIterating = false;
+	sf::Clock _clock;
+};
+
+#endif //ANIMATION_SCHEDULER_HPP
\ No newline at end of file
@@ -62,5 +62,14 @@ public:
     }
 };
 
+// Malformed layout description or compiled layout file
+class LayoutException : public BaseException
+{
+public:
+    explicit LayoutException(const std::string& reason)
+        : BaseException("[Layout Error] " + reason)
+    {
+    }
+};
 
 #endif //EXCEPTIONS_HPP
\ No newline at end of file
@@ -0,0 +1,59 @@
+#ifndef FONT_CACHE_HPP
+#define FONT_CACHE_HPP
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <SFML/Graphics/Font.hpp>
+
+#include <Exceptions.h>
+
+namespace FontCacheConstants
+{
+	constexpr const char* DEFAULT_FONT_PATH = RESOURCES_DIR "Fonts/defaultFont.otf";
+
+	// Printable ASCII range rasterized up front for every requested size
+	constexpr sf::Uint32 FIRST_PRELOADED_GLYPH = 32;
+	constexpr sf::Uint32 LAST_PRELOADED_GLYPH = 126;
+}
+
+//--------------------------------------------------------------
+//	Process-wide font cache. Every path is parsed once and shared
+//	by all widgets; the font is released with its last owner.
+//	Glyph pages are prepared once per (path, character size).
+//--------------------------------------------------------------
+
+class FontCache
+{
+public:
+	static FontCache& getInstance();
+
+	std::shared_ptr<const sf::Font> acquire(const std::string& path, unsigned int characterSize = 0);
+	std::shared_ptr<const sf::Font> acquireDefault(unsigned int characterSize = 0);
+
+	// Parses a font outside the cache; safe on any thread, throws FontException
+	static std::shared_ptr<sf::Font> load(const std::string& path);
+	// Caches the font without preparing glyph pages, which need the graphics context; safe on any thread
+	std::shared_ptr<const sf::Font> prefetch(const std::string& path);
+	// Later acquires of the path return the new font; widgets holding the old one keep it
+	void replace(const std::string& path, std::shared_ptr<sf::Font> font);
+
+	std::size_t getLoadedCount() const;
+
+private:
+	FontCache() = default;
+	FontCache(const FontCache&) = delete;
+	FontCache& operator=(const FontCache&) = delete;
+
+	static std::string makeSizeKey(const std::string& path, unsigned int characterSize);
+	void forgetPreloadedSizes(const std::string& path);
+
+	mutable std::mutex _mutex;
+	std::unordered_map<std::string, std::weak_ptr<sf::Font>> _fonts;
+	std::unordered_set<std::string> _preloadedSizes;
+};
+
+#endif //FONT_CACHE_HPP
\ No newline at end of file
@@ -5,69 +5,93 @@
 #include <string>
 #include <cassert>
 #include <functional>
+#include <memory>
+#include <cstdint>
 
 #include <Graphics/InterfaceElements/Widget.h>
+#include <Graphics/InterfaceElements/ButtonStyle.h>
+#include <Graphics/Rendering/TextureAtlas.h>
+#include <Graphics/Rendering/CachedText.h>
+#include <AnimationScheduler.h>
 
-#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/Font.hpp>
 #include <SFML/Graphics/Color.hpp>
-#include <SFML/Graphics/RectangleShape.hpp>
-#include <SFML/System/Clock.hpp>
+#include <SFML/Graphics/Vertex.hpp>
 
 namespace ButtonConstants
 {
 	constexpr float HALF_DIVIDER = 2.0f;
 	constexpr float CENTER_ALIGN_FACTOR = 0.5f;
-}
-
-enum class ButtonState { Normal, Hovered, Pressed, Disabled };
 
-struct ButtonConfig
-{
-	sf::Text title;
-
-	sf::Color outlineColor;
-	sf::Color normalColor;
-	sf::Color hoverColor;
-	sf::Color pressedColor;
-	sf::Color disabledColor;
+	constexpr float HOVER_DELAY = 0.1f;
+	constexpr float HOVER_FADE = 0.15f;
+	constexpr float PRESS_FADE = 0.08f;
+	constexpr float DISABLE_FADE = 0.2f;
+	constexpr float NORMAL_FADE = 0.15f;
 
-	std::function<void()> onClickAction;
+	constexpr std::size_t QUAD_VERTICES = 6;
+	// Fill plus the four sides of the outline
+	constexpr std::size_t GEOMETRY_VERTICES = QUAD_VERTICES * 5;
+}
 
-	float outlineThickness;
+enum class ButtonState { Normal, Hovered, Pressed, Disabled };
 
-	sf::Vector2f buttonSize;
-	sf::Vector2f buttonPosition;
-};
+//--------------------------------------------------------------
+//	Colours, font and outline come from a shared ButtonStyle;
+//	a button only stores what differs between buttons: text,
+//	geometry, the current fill and the click action.
+//--------------------------------------------------------------
 
 class Button : public Widget
 {
 public:
-	explicit Button(const ButtonConfig& config);
+	Button(std::shared_ptr<const ButtonStyle> style, const sf::String& text,
+		const sf::Vector2f& position, const sf::Vector2f& size, std::function<void()> onClick = {});
+	~Button() override;
 
 	void setPosition(const sf::Vector2f& pos) override;
 	void setEnabled(bool enabled);
-	void setSize(sf::Vector2f size);
-
-	sf::Color lerpColors(const sf::Color& a, const sf::Color& b, float t);
-	sf::Color lerpOverTime(const sf::Color& from, const sf::Color& to, float speed);
-
-	sf::RectangleShape& getShape();
+	void setSize(const sf::Vector2f& size) override;
+	void setText(const sf::String& text);
+	void setStyle(std::shared_ptr<const ButtonStyle> style);
+	void setOnClick(std::function<void()> onClick);
+	// Drawn instead of the rectangle, tinted with its fill colour; nullptr brings the rectangle back
+	void setSkin(const AtlasRegion* skin);
+
+	const ButtonStyle& getStyle() const;
 	bool isClicked();
 
-	void draw(sf::RenderWindow& window) override;
-	void handleEvent(const sf::RenderWindow& window, const sf::Event& event) override;
+	void draw(sf::RenderTarget& target) override;
+	void draw(BatchRenderer& renderer) override;
+	DrawRecording prepareDraw() override;
+	sf::FloatRect getBounds() const override;
+	void handleEvent(const sf::RenderTarget& target, const sf::Event& event) override;
 	void updateAppearance();
 
 private:
-	sf::RectangleShape _shape;
+	// Catches up with a restyle; cheap when nothing changed
+	void refreshStyle();
+	void applyStyle();
+	void centerTitle();
+	// Fill and outline in local coordinates; returns the vertex count
+	std::size_t buildGeometry(sf::Vertex* vertices) const;
+	sf::FloatRect getOutlineRect() const;
+	sf::Color getStateColor() const;
+
+	std::shared_ptr<const ButtonStyle> _style;
+	std::uint32_t _styleRevision = 0;
+	const AtlasRegion* _skin = nullptr;
+
+	CachedText _title;
+	std::function<void()> _onClick;
+
+	sf::Vector2f _position;
+	sf::Vector2f _size;
+	sf::Color _fillColor;
+	sf::Color _targetColor;
 
-	ButtonConfig _config;
 	ButtonState _state = ButtonState::Normal;
-
 	bool _wasClicked = false;
-
-	sf::Clock _animationClock;
-	sf::Clock _hoverTimer;
 };
 
 #endif //BUTTON_HPP
\ No newline at end of file
@@ -0,0 +1,83 @@
+#ifndef BUTTON_STYLE_HPP
+#define BUTTON_STYLE_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Color.hpp>
+
+namespace ButtonStyleConstants
+{
+	// Used by DefaultButtonFactory; restyling it restyles every button the factory made
+	constexpr const char* DEFAULT_STYLE = "default";
+	constexpr unsigned int DEFAULT_CHARACTER_SIZE = 20;
+	constexpr float DEFAULT_OUTLINE_THICKNESS = 2.f;
+}
+
+//--------------------------------------------------------------
+//	The look of a button, shared by every button that has it.
+//	Buttons keep a pointer to it and only their own state.
+//--------------------------------------------------------------
+
+struct ButtonStyle
+{
+	// Keeps a cached font alive; when empty, borrowedFont is used and its owner keeps it alive
+	std::shared_ptr<const sf::Font> font;
+	const sf::Font* borrowedFont = nullptr;
+	unsigned int characterSize = ButtonStyleConstants::DEFAULT_CHARACTER_SIZE;
+	sf::Color textColor = sf::Color::White;
+
+	sf::Color outlineColor = sf::Color::White;
+	sf::Color normalColor = sf::Color(21, 21, 178);
+	sf::Color hoverColor = sf::Color(20, 66, 241);
+	sf::Color pressedColor = sf::Color::Black;
+	sf::Color disabledColor = sf::Color::Black;
+
+	float outlineThickness = ButtonStyleConstants::DEFAULT_OUTLINE_THICKNESS;
+
+	// Bumped by ButtonTheme::set; buttons compare it when drawn and pick the change up
+	std::uint32_t revision = 0;
+
+	const sf::Font* getFont() const { return font ? font.get() : borrowedFont; }
+	// Everything but the revision
+	bool hasSameLook(const ButtonStyle& other) const;
+};
+
+//--------------------------------------------------------------
+//	Process-wide button styles. Equal looks are stored once, and
+//	named styles can be changed in place: a theme switch costs
+//	one update per style, whatever the number of buttons. The
+//	buttons follow at their next draw, so repaint them after a
+//	switch (RetainedCanvas::invalidateAll). UI thread only.
+//--------------------------------------------------------------
+
+class ButtonTheme
+{
+public:
+	static ButtonTheme& getInstance();
+
+	// The shared copy of style; its revision is ignored
+	std::shared_ptr<const ButtonStyle> intern(const ButtonStyle& style);
+
+	// nullptr for unknown names
+	std::shared_ptr<const ButtonStyle> find(const std::string& name) const;
+	// Adds the named style, or restyles the buttons already using it
+	std::shared_ptr<const ButtonStyle> set(const std::string& name, const ButtonStyle& style);
+
+	std::size_t size() const;
+
+private:
+	ButtonTheme() = default;
+	ButtonTheme(const ButtonTheme&) = delete;
+	ButtonTheme& operator=(const ButtonTheme&) = delete;
+
+	// A handful of looks per program; no buttons left means the entry is dropped on the next intern
+	std::vector<std::shared_ptr<ButtonStyle>> _interned;
+	std::unordered_map<std::string, std::shared_ptr<ButtonStyle>> _named;
+};
+
+#endif //BUTTON_STYLE_HPP
\ No newline at end of file
@@ -11,7 +11,9 @@
 #include <SFML/Graphics/Font.hpp>
 
 #include <Graphics/InterfaceElements/Widget.h>
+#include <Graphics/Rendering/TextureAtlas.h>
 #include <Exceptions.h>
+#include <FontCache.h>
 
 class CheckBox : public Widget
 {
@@ -19,8 +21,10 @@ private:
 	bool _isChecked;
 	sf::RectangleShape _box;
 	sf::RectangleShape _checkMark;
+	const AtlasRegion* _boxSkin = nullptr;
+	const AtlasRegion* _checkMarkSkin = nullptr;
 	sf::Text _label;
-	sf::Font _font;
+	std::shared_ptr<const sf::Font> _font;
 
 	const sf::Color _ACTIVE_BG_COLOR = sf::Color(70, 70, 70);
 	const sf::Color _INACTIVE_BG_COLOR = sf::Color(200, 200, 200);
@@ -29,27 +33,39 @@ private:
 
 	std::chrono::steady_clock::time_point _lastClickTime;
 	const std::chrono::milliseconds _clickDelay{ 200 };
+
+	void updateAppearance();
 public:
 	CheckBox(const sf::Font& font, 
 		const std::string& text, 
 		const sf::Vector2f& pos, 
 		unsigned int characterSize = 16);
 
+	CheckBox(std::shared_ptr<const sf::Font> font,
+		const std::string& text,
+		const sf::Vector2f& pos,
+		unsigned int characterSize = 16);
+
 	CheckBox(CheckBox&& other) noexcept;
 	CheckBox& operator=(CheckBox&& other) noexcept;
 
 	void setPosition(const sf::Vector2f& pos) override;
-	void setSize(const sf::Vector2f& size);
+	void setSize(const sf::Vector2f& size) override;
 	void setChecked(bool checked);
 	void setCallback(const std::function<void(bool)>& func);
+	// Drawn instead of the rectangles, tinted with their fill colours; the check mark only while checked
+	void setSkin(const AtlasRegion* box, const AtlasRegion* checkMark);
 
 	bool getChecked() const;
 	sf::Vector2f getPosition() const;
 	sf::Vector2f getSize() const;
 	sf::RectangleShape& getShape();
 
-	void draw(sf::RenderWindow& window) override;
-	void handleEvent(const sf::RenderWindow& window, const sf::Event& event) override;
+	void draw(sf::RenderTarget& target) override;
+	void draw(BatchRenderer& renderer) override;
+	DrawRecording prepareDraw() override;
+	sf::FloatRect getBounds() const override;
+	void handleEvent(const sf::RenderTarget& target, const sf::Event& event) override;
 };
 
 #endif //CHECKBOX_HPP
\ No newline at end of file
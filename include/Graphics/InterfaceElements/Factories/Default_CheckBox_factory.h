@@ -1,5 +1,10 @@
+#ifndef DEFAULT_CHECKBOX_FACTORY
+#define DEFAULT_CHECKBOX_FACTORY
+
 #include <Graphics/InterfaceElements/Factories/CheckBox_factory.h>
 #include <Graphics/InterfaceElements/CheckBox.h>
+#include <FontCache.h>
+#include <WidgetContainer.h>
 
 class DefaultCheckBoxFactory : public CheckBoxFactory
 {
@@ -15,4 +20,32 @@ public:
 
 		return checkbox;
 	}
-};
\ No newline at end of file
+
+	std::unique_ptr<CheckBox> createCheckBox(const std::string& text,
+		const sf::Vector2f& pos,
+		unsigned int characterSize = 16) const
+	{
+		auto checkbox = std::make_unique<CheckBox>(
+			FontCache::getInstance().acquireDefault(characterSize), text, pos, characterSize);
+
+		checkbox->setSize({ 20.f, 20.f });
+
+		return checkbox;
+	}
+
+	// Allocates from the container's CheckBox pool and registers the checkbox with it
+	WidgetHandle<CheckBox> createCheckBox(WidgetContainer& container,
+		const std::string& text,
+		const sf::Vector2f& pos,
+		unsigned int characterSize = 16) const
+	{
+		WidgetHandle<CheckBox> handle = container.create<CheckBox>(
+			FontCache::getInstance().acquireDefault(characterSize), text, pos, characterSize);
+
+		container.get(handle)->setSize({ 20.f, 20.f });
+
+		return handle;
+	}
+};
+
+#endif //DEFAULT_CHECKBOX_FACTORY
\ No newline at end of file
@@ -5,18 +5,41 @@
 #include <iostream>
 
 #include <Graphics/InterfaceElements/Factories/Button_factory.h>
+#include <FontCache.h>
+#include <WidgetContainer.h>
 
 #include <SFML/Graphics.hpp>
 
 class DefaultButtonFactory : public ButtonFactory
 {
 private:
-	const sf::Font& _font;
+	std::shared_ptr<const ButtonStyle> _style;
 
 public:
+	// The shared "default" style, created with the default font on first use
+	DefaultButtonFactory()
+		:_style(ButtonTheme::getInstance().find(ButtonStyleConstants::DEFAULT_STYLE))
+	{
+		if (!_style)
+		{
+			ButtonStyle style;
+			style.font = FontCache::getInstance().acquireDefault(style.characterSize);
+			_style = ButtonTheme::getInstance().set(ButtonStyleConstants::DEFAULT_STYLE, style);
+		}
+	}
+
+	// The default look with a font the caller keeps alive
 	explicit DefaultButtonFactory(const sf::Font& font)
-		:_font(font)
 	{
+		ButtonStyle style;
+		style.borrowedFont = &font;
+		_style = ButtonTheme::getInstance().intern(style);
+	}
+
+	// Starting point for callers that adjust the look before interning it
+	const std::shared_ptr<const ButtonStyle>& getStyle() const
+	{
+		return _style;
 	}
 
 	std::unique_ptr<Button> createButton(
@@ -26,16 +49,19 @@ public:
 	)
 		const override
 	{
-		ButtonConfig config;
-		config.buttonSize = size;
-		config.buttonPosition = position;
-		config.title = sf::Text(text, _font, 20);
-		config.normalColor = sf::Color(21, 21, 178);
-		config.hoverColor = sf::Color(20, 66, 241);
-		config.outlineThickness = 2;
-		config.outlineColor = sf::Color::White;
-
-		return std::make_unique<Button>(config);
+		return std::make_unique<Button>(_style, text, position, size);
+	}
+
+	// Allocates from the container's Button pool and registers the button with it
+	WidgetHandle<Button> createButton(
+		WidgetContainer& container,
+		const std::string& text,
+		const sf::Vector2f& position,
+		const sf::Vector2f& size = { 200, 50 }
+	)
+		const
+	{
+		return container.create<Button>(_style, text, position, size);
 	}
 
 };
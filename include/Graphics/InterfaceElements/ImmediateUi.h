@@ -0,0 +1,154 @@
+#ifndef IMMEDIATE_UI_HPP
+#define IMMEDIATE_UI_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <variant>
+#include <string_view>
+#include <unordered_map>
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <Graphics/InterfaceElements/Widget.h>
+#include <Graphics/InterfaceElements/Button.h>
+#include <Graphics/InterfaceElements/CheckBox.h>
+#include <Graphics/InterfaceElements/ProgressBar.h>
+#include <Graphics/Rendering/BatchRenderer.h>
+#include <WidgetContainer.h>
+
+namespace ImmediateUiConstants
+{
+	constexpr float DEFAULT_WIDTH = 200.f;
+	constexpr float BUTTON_HEIGHT = 32.f;
+	constexpr float CHECK_BOX_SIZE = 20.f;
+	constexpr float PROGRESS_HEIGHT = 12.f;
+	constexpr float SPACING = 6.f;
+	constexpr unsigned int CHARACTER_SIZE = 16;
+
+	// Widgets left out of this many frames in a row are destroyed, not just hidden
+	constexpr std::uint32_t RETIRE_AFTER_FRAMES = 300;
+	// Separates the shown text from the part that only makes the ID unique: "Reset##stats"
+	constexpr std::string_view ID_SEPARATOR = "##";
+	// Only the part after it makes the ID, so the shown text can change: "Stop trace###trace"
+	constexpr std::string_view FIXED_ID_SEPARATOR = "###";
+}
+
+//--------------------------------------------------------------
+//	Immediate-mode front end for debug and tool panels: declare
+//	the widgets every frame between begin() and end() and read
+//	the result straight back,
+//
+//		ui.begin();
+//		if (ui.button("Generate")) generate();
+//		ui.checkbox("Show stats", showStats);
+//		ui.progress("load", loaded, total);
+//		ui.end();
+//
+//	Behind each label sits a regular Button, CheckBox or
+//	ProgressBar, created the first time the label is declared
+//	and kept in a map keyed by the label's hash, so hover fades
+//	and value animations carry over between frames. Widgets are
+//	stacked downwards from the panel's position.
+//
+//	The panel is itself a widget: add it to a WidgetContainer
+//	and a RetainedCanvas like any other, or call render() to
+//	draw it as one batch. Once every label has been seen, a
+//	frame allocates nothing. A label that changes is a new
+//	widget, unless it carries a fixed ID after "###". Debug
+//	builds assert when two labels hash to the same ID.
+//--------------------------------------------------------------
+
+class ImmediateUi : public Widget
+{
+public:
+	ImmediateUi();
+	~ImmediateUi() override;
+
+	ImmediateUi(const ImmediateUi&) = delete;
+	ImmediateUi& operator=(const ImmediateUi&) = delete;
+
+	void begin();
+	// Hides the widgets that weren't declared since begin()
+	void end();
+
+	// True once per click
+	bool button(std::string_view label);
+	// Toggling writes value and returns true; changing value in code updates the box
+	bool checkbox(std::string_view label, bool& value);
+	void progress(std::string_view id, float value, float maxValue = 100.f);
+
+	// The next widget goes to the right of the previous one instead of below it
+	void sameLine();
+
+	// Whole panel in one batch, for panels drawn outside a RetainedCanvas
+	void render(sf::RenderTarget& target);
+
+	std::size_t getWidgetCount() const;
+
+	void setPosition(const sf::Vector2f& pos) override;
+	// Only the width counts; the height follows the widgets
+	void setSize(const sf::Vector2f& size) override;
+
+	void draw(sf::RenderTarget& target) override;
+	void draw(BatchRenderer& renderer) override;
+	DrawRecording prepareDraw() override;
+	sf::FloatRect getBounds() const override;
+	void handleEvent(const sf::RenderTarget& target, const sf::Event& event) override;
+
+private:
+	using Handle = std::variant<WidgetHandle<Button>, WidgetHandle<CheckBox>, WidgetHandle<ProgressBar>>;
+
+	struct Entry
+	{
+		Handle handle;
+		Widget* widget = nullptr;
+		std::uint32_t lastFrame = 0;
+		// In _widgets, so it gets events; hidden widgets are taken out
+		bool isAttached = false;
+		// Check box state the caller was last told about
+		bool value = false;
+		// Button text, which may change under a fixed ID
+		std::string text;
+#ifndef NDEBUG
+		// What the ID was hashed from, to catch two labels sharing a hash
+		std::string key;
+#endif
+	};
+
+	enum class Kind : std::uint8_t { Button, CheckBox, ProgressBar };
+
+	static std::uint64_t makeId(Kind kind, std::string_view label);
+	static std::string_view getShownText(std::string_view label);
+	static std::string_view getIdText(std::string_view label);
+
+	// Entry of the widget behind the label, placed in the next slot; create(position) makes it the first time
+	template<class Create>
+	Entry& declare(Kind kind, std::string_view label, const sf::Vector2f& slotSize, Create&& create);
+	// Where the next slot of this size goes
+	sf::Vector2f place(const sf::Vector2f& size);
+
+	WidgetContainer _widgets;
+	std::unordered_map<std::uint64_t, Entry> _entries;
+	// This frame's widgets in declaration order
+	std::vector<Widget*> _declared;
+
+	std::shared_ptr<const ButtonStyle> _buttonStyle;
+	BatchRenderer _renderer;
+
+	sf::Vector2f _position;
+	float _width = ImmediateUiConstants::DEFAULT_WIDTH;
+	// Top of the current row, and how far it reaches right and down
+	float _rowTop = 0.f;
+	float _rowRight = 0.f;
+	float _rowHeight = 0.f;
+	bool _isSameLine = false;
+
+	sf::FloatRect _bounds;
+	std::uint32_t _frame = 0;
+	bool _isDeclaring = false;
+};
+
+#endif //IMMEDIATE_UI_HPP
\ No newline at end of file
@@ -0,0 +1,63 @@
+#ifndef PROFILER_OVERLAY_HPP
+#define PROFILER_OVERLAY_HPP
+
+#include <memory>
+#include <cstdint>
+#include <functional>
+
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/Font.hpp>
+
+#include <Graphics/InterfaceElements/Widget.h>
+#include <FontCache.h>
+#include <Profiler.h>
+
+namespace ProfilerOverlayConstants
+{
+	constexpr float TARGET_FRAME_MS = 1000.f / 60.f;
+	constexpr std::uint64_t LABEL_REFRESH_FRAMES = 15;
+	constexpr unsigned int CHARACTER_SIZE = 12;
+	constexpr float PADDING = 6.f;
+}
+
+// Frame-time graph and the latest counters of the Profiler
+class ProfilerOverlay : public Widget
+{
+public:
+	explicit ProfilerOverlay(const sf::Vector2f& size = { 360.f, 150.f });
+
+	void setVisible(bool visible);
+	bool isVisible() const;
+
+	// Pulls the newest frames from the profiler, call once per frame
+	void update();
+
+	void setPosition(const sf::Vector2f& pos) override;
+	void setSize(const sf::Vector2f& size) override;
+
+	void draw(sf::RenderTarget& target) override;
+	void draw(BatchRenderer& renderer) override;
+	DrawRecording prepareDraw() override;
+	void handleEvent(const sf::RenderTarget& target, const sf::Event& event) override;
+	bool acceptsInput() const override;
+	sf::FloatRect getBounds() const override;
+
+private:
+	void forEachBar(const std::function<void(const sf::FloatRect&, const sf::Color&)>& callback) const;
+	void rebuildLabel();
+
+	std::shared_ptr<const sf::Font> _font;
+
+	sf::RectangleShape _background;
+	sf::RectangleShape _targetLine;
+	sf::VertexArray _bars;
+	sf::Text _label;
+
+	bool _isVisible;
+	std::uint64_t _lastFrameIndex;
+	std::uint64_t _lastLabelFrame;
+};
+
+#endif //PROFILER_OVERLAY_HPP
\ No newline at end of file
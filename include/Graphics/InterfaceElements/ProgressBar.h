@@ -2,27 +2,74 @@
 #define PROGRESS_BAR_HPP
 
 #include <iostream>
+#include <atomic>
+#include <memory>
 #include <functional>
 #include <chrono>
 #include <cmath>
 
-#include <SFML/Graphics/RectangleShape.hpp>
-#include <SFML/Graphics/Text.hpp>
 #include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
 
 #include <Graphics/InterfaceElements/Widget.h>
+#include <Graphics/Rendering/CachedText.h>
+#include <Graphics/Rendering/TextureAtlas.h>
+#include <AnimationScheduler.h>
 #include <Exceptions.h>
+#include <FontCache.h>
+
+namespace ProgressBarConstants
+{
+	// Length of a value change at full smoothness
+	constexpr float MAX_SMOOTH_SECONDS = 1.f;
+
+	constexpr std::size_t QUAD_VERTICES = 6;
+	constexpr std::size_t BORDER_QUADS = 4;
+	constexpr float DEFAULT_SEGMENT_GAP = 2.f;
+}
+
+//--------------------------------------------------------------
+//	The bar's geometry lives in one vertex array in local
+//	coordinates: the background quad, the fill quads (one, one
+//	per segment, or the fill plus its stripes), then the border
+//	ring, which is drawn inside the bar's size. A value change
+//	rewrites the fill quads in place; moving the bar only
+//	changes the transform. Everything but the skins and the
+//	label goes out in one draw call.
+//--------------------------------------------------------------
 
 class ProgressBar : public Widget
 {
 private:
-	sf::VertexArray _gradientVertices;
-
-	sf::RectangleShape _background;
-	sf::RectangleShape _fill;
-	sf::RectangleShape _border;
-	sf::Text _text;
-	sf::Font _font;
+	sf::VertexArray _vertices;
+	std::size_t _fillQuadCount = 1;
+	// Only for static bars, created on demand
+	std::unique_ptr<sf::VertexBuffer> _staticBuffer;
+	bool _isBufferStale = true;
+
+	sf::Vector2f _position;
+	sf::Vector2f _size;
+	// Filled part in local coordinates, where a fill skin is drawn
+	sf::FloatRect _fillRect;
+
+	sf::Color _backgroundColor;
+	sf::Color _fillColor;
+	sf::Color _gradientStart;
+	sf::Color _gradientEnd;
+	sf::Color _borderColor = sf::Color::White;
+	float _borderThickness = 0.f;
+
+	unsigned int _segmentCount = 0;
+	float _segmentGap = 0.f;
+	float _stripeWidth = 0.f;
+	sf::Color _stripeColor;
+
+	const AtlasRegion* _backgroundSkin = nullptr;
+	const AtlasRegion* _fillSkin = nullptr;
+	CachedText _text;
+	std::shared_ptr<const sf::Font> _font;
+	int _displayedPercent = -1;
 
 	float _maxValue = 100.f;
 	float _currentValue = 0.f;
@@ -30,20 +77,34 @@ private:
 	float _smoothness = 0.f;
 
 	bool _isVertical = false;
-	bool _showBorder = false;
-	bool _showText = true;
+	bool _showText = false;
 	bool _useGradient = false;
+	bool _isStatic = false;
 	bool _isDragging = false;
 	bool _isEnabled = true;
 
-	std::vector<sf::Vertex> _gradientFill;
-
 	std::function<void()> _onComplete;
 
 	std::chrono::steady_clock::time_point _lastClickTime;
 	std::chrono::milliseconds _clickDelay{ 200 };
 
+	std::atomic<float> _postedValue{ 0.f };
+	std::atomic<bool> _hasPostedValue{ false };
+
+	void rebuildVertices();
 	void updateFill();
+	void setQuad(std::size_t quad, const sf::FloatRect& rect, const sf::Color& top, const sf::Color& bottom);
+	bool refreshStaticBuffer();
+	void animateValue();
+	void applyPostedValue();
+	void setPercentageVisible(bool show, unsigned int charSize);
+
+	sf::FloatRect getInnerRect() const;
+	// Part of the inner area between from and to along the bar, which fills from the bottom when vertical
+	sf::FloatRect getFillSpan(float from, float to) const;
+	sf::Color getFillColorAt(float y) const;
+	sf::Transform getTransform() const;
+	std::size_t getDrawnVertexCount() const;
 
 public:
 	ProgressBar(const sf::Vector2f& size,
@@ -52,31 +113,47 @@ public:
 
 	ProgressBar(ProgressBar&& other);
 	ProgressBar& operator=(ProgressBar&& other);
+	~ProgressBar() override;
 
 	std::function<void(float)> _onValueChanged;
 
 	void setEnabled(bool enabled) { _isEnabled = enabled; }
 	bool isEnabled() const { return _isEnabled; }
 	void setValue(float value);
+
+	// Safe from any thread; only the latest value posted before the next drain is applied
+	bool postValue(float value);
 	void setMaxValue(float maxValue);
 	void setOrientation(bool isVertical);
 	void setPosition(const sf::Vector2f& pos) override;
+	void setSize(const sf::Vector2f& size) override;
 	void enableBorder(bool enable, const sf::Color& color, float thickness = 1.f);
 	void setSmoothness(float smoothness);
 	void setFillGradient(const sf::Color& start, const sf::Color& end);
-	sf::Color lerpColors(const sf::Color& a, const sf::Color& b, float t);
+	// Splits the fill into count blocks; 0 brings back the solid fill. Replaces stripes
+	void setSegments(unsigned int count, float gap = ProgressBarConstants::DEFAULT_SEGMENT_GAP);
+	// Bands of color across every other width pixels of the fill; 0 turns them off. Replaces segments
+	void setStripes(float width, const sf::Color& color);
+	// Direct drawing from a static GPU buffer, uploaded again only after a change; for bars that rarely change
+	void setStatic(bool isStatic);
+	// Drawn instead of the background and fill quads, tinted with their colours; a fill skin takes over from the gradient
+	void setSkin(const AtlasRegion* background, const AtlasRegion* fill);
+	sf::Color lerpColors(const sf::Color& a, const sf::Color& b, float t) const;
 
 	float getPercentage() const;
 
 	void showPercentage(bool show, const sf::Font& font,
 		unsigned int charSize = 16);
+	void showPercentage(bool show, unsigned int charSize = 16);
 	void updateProgressFromMouse(const sf::Vector2f& mousePos);
 
-	void draw(sf::RenderWindow& window) override;
-	void handleEvent(const sf::RenderWindow& window, const sf::Event& event) override;
+	void draw(sf::RenderTarget& target) override;
+	void draw(BatchRenderer& renderer) override;
+	DrawRecording prepareDraw() override;
+	sf::FloatRect getBounds() const override;
+	void handleEvent(const sf::RenderTarget& target, const sf::Event& event) override;
 	void updateTextPosition();
 	void updatePercentageText();
-	void update(float deltaTime);
 };
 
 #endif //PROGRESS_BAR_HPP
\ No newline at end of file
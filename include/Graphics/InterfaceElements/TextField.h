@@ -5,14 +5,35 @@
 #include <memory>
 #include <chrono>
 #include <string>
+#include <vector>
+#include <limits>
 #include <functional>
 
 #include <SFML/Graphics/Font.hpp>
-#include <SFML/Graphics/Text.hpp>
 #include <SFML/Graphics/RectangleShape.hpp>
 
 #include <Graphics/InterfaceElements/Widget.h>
+#include <Graphics/Rendering/TextLayout.h>
+#include <TextDocument.h>
 #include <Exceptions.h>
+#include <FontCache.h>
+
+namespace TextFieldConstants
+{
+	constexpr float PADDING = 10.f;
+	constexpr float CARET_WIDTH = 2.f;
+	constexpr unsigned int WHEEL_LINES = 3;
+	constexpr unsigned int UNLIMITED_LENGTH = std::numeric_limits<unsigned int>::max();
+}
+
+//--------------------------------------------------------------
+//	Editable text backed by a TextDocument gap buffer. Only the
+//	lines inside the box are laid out and drawn, each line's
+//	glyphs and column positions are cached until that line is
+//	edited, and text that leaves the box horizontally is
+//	clipped per glyph. Caret, selection and clipping look up the
+//	cache, so a draw costs the same on a line of any length.
+//--------------------------------------------------------------
 
 class TextField : public Widget
 {
@@ -24,27 +45,99 @@ public:
 
 	void setCharacterSize(unsigned int characterSize);
 	void setSize(const float& width, const float& height);
-	void setSize(const sf::Vector2f& size);
+	void setSize(const sf::Vector2f& size) override;
+	// A finite limit also preallocates the text and glyph storage, so typing never allocates
 	void setMaxLength(unsigned int length);
+	void setMultiline(bool multiline);
+	bool isMultiline() const;
 	void setText(const std::string& text);
+	void append(const std::string& text);
 	void setPosition(const sf::Vector2f& pos) override;
 
-	void handleEvent(const sf::RenderWindow& window, const sf::Event& event) override;
+	std::size_t getLineCount() const;
+	std::size_t getCursor() const;
+	void setCursor(std::size_t position, bool extendSelection = false);
+	void selectAll();
+	std::string getSelectedText() const;
+
+	void handleEvent(const sf::RenderTarget& target, const sf::Event& event) override;
 	void handleTextInput(sf::Uint32 unicode);
-	void draw(sf::RenderWindow& window) override;
+	void draw(sf::RenderTarget& target) override;
+	void draw(BatchRenderer& renderer) override;
+	DrawRecording prepareDraw() override;
+	sf::FloatRect getBounds() const override;
 
 private:
+	struct LineLayout
+	{
+		std::uint64_t id = 0;
+		std::uint64_t lastUse = 0;
+		TextLayout layout;
+		// x of every character boundary on the line, one more than its length
+		std::vector<float> columns;
+	};
+
+	void setActive(bool active);
+	void handleKey(const sf::Event::KeyEvent& key);
+
+	void insertText(const sf::Uint32* text, std::size_t count);
+	bool eraseSelection();
+	void onTextChanged();
+
+	bool hasSelection() const;
+	std::size_t selectionStart() const;
+	std::size_t selectionEnd() const;
+
+	float lineHeight() const;
+	std::size_t visibleLineCount() const;
+	float columnX(std::size_t position);
+	// Boundary on the line closest to x
+	std::size_t columnAt(std::size_t line, float x);
+	std::size_t positionAt(const sf::Vector2f& point);
+	void moveVertically(long lines, bool extendSelection);
+	void scrollLines(long lines);
+	void ensureCursorVisible();
+
+	// Creates the per-line layout slots before the first line is looked up
+	void prepareLineLayouts();
+	const LineLayout& lineLayout(std::size_t line);
+
+	template<class RectFunction, class GlyphFunction>
+	void emitContent(RectFunction&& emitRect, GlyphFunction&& emitGlyphs);
+
 	sf::Clock _keyRepeatClock;
-	sf::Font _font;
+	std::shared_ptr<const sf::Font> _font;
 
-	sf::Text _text;
 	sf::RectangleShape _background;
+	sf::RectangleShape _highlight;
 
 	sf::Color _activeColor;
 	sf::Color _inactiveColor;
+	sf::Color _selectionColor;
+	sf::Color _textColor;
 
 	bool _isActive;
-	std::string _inputString;
+	bool _isMultiline;
+	bool _isSelecting;
+
+	TextDocument _document;
+	std::size_t _cursor;
+	std::size_t _anchor;
+	float _preferredX;
+
+	std::size_t _firstLine;
+	float _scrollX;
+
+	std::vector<LineLayout> _lineLayouts;
+	std::uint64_t _drawStamp;
+
+	mutable std::basic_string<sf::Uint32> _scratch;
+	std::basic_string<sf::Uint32> _pending;
+	std::vector<sf::Vertex> _coloredGlyphs;
+
+	mutable std::string _inputString;
+	mutable bool _isInputStringStale;
+
 	unsigned int _characterSize;
 	unsigned int _maxLength;
 
@@ -0,0 +1,120 @@
+#ifndef VIRTUAL_LIST_HPP
+#define VIRTUAL_LIST_HPP
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <functional>
+
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/View.hpp>
+
+#include <Graphics/InterfaceElements/Widget.h>
+#include <AnimationScheduler.h>
+
+namespace VirtualListConstants
+{
+	constexpr std::size_t NO_ITEM = static_cast<std::size_t>(-1);
+	constexpr float WHEEL_ROWS = 3.f;
+	constexpr float SCROLL_DURATION = 0.18f;
+	constexpr float SCROLLBAR_WIDTH = 6.f;
+}
+
+//--------------------------------------------------------------
+//	Scrollable list or grid over any number of items. Only the
+//	cells inside the viewport exist as widgets: they come from
+//	the row factory once and are rebound to new item indices
+//	while scrolling, so memory and frame time depend on the
+//	viewport, not on the item count.
+//
+//	Rows are owned by the list and receive events through it;
+//	don't add them to a WidgetContainer.
+//--------------------------------------------------------------
+
+class VirtualList : public Widget
+{
+public:
+	using RowFactory = std::function<std::unique_ptr<Widget>()>;
+	using RowBinder = std::function<void(Widget& row, std::size_t index)>;
+
+	VirtualList(RowFactory factory, RowBinder binder);
+	~VirtualList() override;
+
+	VirtualList(const VirtualList&) = delete;
+	VirtualList& operator=(const VirtualList&) = delete;
+
+	void setItemCount(std::size_t count);
+	std::size_t getItemCount() const;
+
+	void setRowHeight(float height);
+	void setColumns(std::size_t columns);
+	void setSpacing(float spacing);
+	void setBackgroundColor(const sf::Color& color);
+
+	// Rebinds the visible rows after the underlying data changed
+	void refresh();
+
+	void scrollTo(std::size_t index);
+	void setScrollOffset(float offset, bool smooth = true);
+	float getScrollOffset() const;
+
+	// Picks up rows that changed on their own, call once per frame
+	void update();
+
+	void forEachRow(const std::function<void(Widget& row, std::size_t index)>& callback);
+
+	void setPosition(const sf::Vector2f& pos) override;
+	void setSize(const sf::Vector2f& size) override;
+
+	void draw(sf::RenderTarget& target) override;
+	void draw(BatchRenderer& renderer) override;
+	void handleEvent(const sf::RenderTarget& target, const sf::Event& event) override;
+	sf::FloatRect getBounds() const override;
+
+private:
+	struct Row
+	{
+		std::unique_ptr<Widget> widget;
+		std::size_t index = VirtualListConstants::NO_ITEM;
+	};
+
+	float rowStride() const;
+	std::size_t rowCount() const;
+	float maxOffset() const;
+	sf::Vector2f cellSize() const;
+	void clampScroll();
+
+	void ensurePool();
+	void layoutRows(bool rebindAll = false);
+	Widget* rowFor(std::size_t index) const;
+	std::size_t itemAt(const sf::Vector2f& point) const;
+	void deliver(std::size_t index, const sf::RenderTarget& target, const sf::Event& event);
+
+	bool makeClipView(const sf::RenderTarget& target, sf::View& clip) const;
+	sf::FloatRect scrollbarThumb() const;
+
+	RowFactory _factory;
+	RowBinder _binder;
+
+	std::vector<Row> _rows;
+	std::vector<Row*> _window;
+	std::vector<Row*> _freeRows;
+
+	sf::RectangleShape _background;
+	sf::RectangleShape _scrollbar;
+
+	std::size_t _itemCount;
+	std::size_t _columns;
+	float _rowHeight;
+	float _spacing;
+
+	float _offset;
+	float _targetOffset;
+	std::size_t _firstItem;
+
+	std::size_t _hoveredItem;
+	std::size_t _capturedItem;
+	std::size_t _focusedItem;
+};
+
+#endif //VIRTUAL_LIST_HPP
\ No newline at end of file
@@ -1,17 +1,125 @@
 #ifndef WIDGET_HPP
 #define WIDGET_HPP
 
+#include <algorithm>
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Window/Event.hpp>
 
+#include <Graphics/Rendering/BatchRenderer.h>
+#include <UpdateQueue.h>
+
+class Widget;
+
+// Where a widget's draw(BatchRenderer&) may run, as Widget::prepareDraw() reports it
+enum class DrawRecording
+{
+	// Draws to the renderer's target itself, between the batches before and after it;
+	// widgets covering others flush the renderer around their geometry and report this
+	Direct,
+	// Only adds geometry, but uses fonts or other shared state doing so: render thread only
+	RenderThread,
+	// Only reads the widget and adds geometry: any thread, next to other widgets
+	AnyThread
+};
+
+// Notified whenever a widget moves or changes its size
+class WidgetObserver
+{
+public:
+	virtual void onBoundsChanged(Widget& widget) = 0;
+
+protected:
+	~WidgetObserver() = default;
+};
+
 class Widget
 {
 public:
-	virtual void draw(sf::RenderWindow& window) = 0;
-	virtual void handleEvent(const sf::RenderWindow& window, const sf::Event& event) = 0;
+	virtual void draw(sf::RenderTarget& target) = 0;
+	virtual void handleEvent(const sf::RenderTarget& target, const sf::Event& event) = 0;
 	virtual void setPosition(const sf::Vector2f& pos) = 0;
+	virtual void setSize(const sf::Vector2f& size) = 0;
+
+	// Area covered by everything the widget draws, in world coordinates
+	virtual sf::FloatRect getBounds() const = 0;
+
+	// Batched path: widgets that don't emit their geometry fall back to direct drawing
+	virtual void draw(BatchRenderer& renderer)
+	{
+		renderer.flush();
+		draw(renderer.getTarget());
+	}
+
+	// Called on the render thread right before draw(BatchRenderer&): brings whatever shared state the
+	// draw needs up to date, so that it can be recorded where the result says
+	virtual DrawRecording prepareDraw() { return DrawRecording::Direct; }
+
+	// False for display-only widgets: a click on them never takes the keyboard focus
+	virtual bool acceptsInput() const { return true; }
+
+	void invalidate() { _isDirty = true; }
+	void clearDirty() { _isDirty = false; }
+	bool isDirty() const { return _isDirty; }
+
+	void setObserver(WidgetObserver* observer) { _observer = observer; }
+
+	// Safe from any thread: runs the update on the UI thread at the next UpdateQueue::drain()
+	bool postUpdate(std::function<void()> update)
+	{
+		return UpdateQueue::getInstance().post(this, std::move(update));
+	}
+
+	virtual ~Widget()
+	{
+		UpdateQueue::getInstance().discard(this);
+	}
+
+protected:
+	void invalidateBounds()
+	{
+		_isDirty = true;
+		if (_observer) _observer->onBoundsChanged(*this);
+	}
+
+	// Mouse events carry their own coordinates, no need to query the OS cursor
+	static bool getEventPosition(const sf::RenderTarget& target, const sf::Event& event, sf::Vector2f& position)
+	{
+		switch (event.type)
+		{
+		case sf::Event::MouseMoved:
+			position = target.mapPixelToCoords({ event.mouseMove.x, event.mouseMove.y });
+			return true;
+		case sf::Event::MouseButtonPressed:
+		case sf::Event::MouseButtonReleased:
+			position = target.mapPixelToCoords({ event.mouseButton.x, event.mouseButton.y });
+			return true;
+		case sf::Event::MouseWheelScrolled:
+			position = target.mapPixelToCoords({ event.mouseWheelScroll.x, event.mouseWheelScroll.y });
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	static sf::FloatRect uniteBounds(const sf::FloatRect& a, const sf::FloatRect& b)
+	{
+		if (a.width <= 0.f && a.height <= 0.f) return b;
+		if (b.width <= 0.f && b.height <= 0.f) return a;
+
+		const float left = std::min(a.left, b.left);
+		const float top = std::min(a.top, b.top);
+		const float right = std::max(a.left + a.width, b.left + b.width);
+		const float bottom = std::max(a.top + a.height, b.top + b.height);
+
+		return { left, top, right - left, bottom - top };
+	}
 
-	virtual ~Widget() = default;
+private:
+	bool _isDirty = true;
+	WidgetObserver* _observer = nullptr;
 };
 
 #endif //WIDGET_HPP
\ No newline at end of file
@@ -0,0 +1,81 @@
+#ifndef WIDGET_GROUP_HPP
+#define WIDGET_GROUP_HPP
+
+#include <vector>
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+#include <Graphics/InterfaceElements/Widget.h>
+#include <WidgetContainer.h>
+
+//--------------------------------------------------------------
+//	A widget made of other widgets, groups included, placed
+//	relative to the group. Moving the group moves the subtree:
+//	world positions are only recomputed when a parent moves.
+//	The bounds are the union of the children's, cached until a
+//	child reports a change. Subtrees outside the view are culled
+//	from drawing and from update().
+//
+//	Children are not owned. Add them to the group, not to a
+//	WidgetContainer; the group routes their events itself.
+//--------------------------------------------------------------
+
+class WidgetGroup : public Widget, private WidgetObserver
+{
+public:
+	WidgetGroup();
+	~WidgetGroup() override;
+
+	WidgetGroup(const WidgetGroup&) = delete;
+	WidgetGroup& operator=(const WidgetGroup&) = delete;
+
+	void add(Widget& child, const sf::Vector2f& localPosition = {});
+	void remove(Widget& child);
+	void clear();
+
+	void setLocalPosition(Widget& child, const sf::Vector2f& localPosition);
+	sf::Vector2f getLocalPosition(const Widget& child) const;
+	const std::vector<Widget*>& getChildren() const;
+
+	// Picks up children that changed on their own, call once per frame; skips what lies outside visibleArea
+	void update(const sf::FloatRect& visibleArea);
+
+	// World area the target's current view shows
+	static sf::FloatRect getVisibleArea(const sf::RenderTarget& target);
+
+	void setPosition(const sf::Vector2f& pos) override;
+	const sf::Vector2f& getPosition() const;
+	// A group is as large as its children, so this does nothing
+	void setSize(const sf::Vector2f& size) override;
+
+	void draw(sf::RenderTarget& target) override;
+	void draw(BatchRenderer& renderer) override;
+	sf::FloatRect getBounds() const override;
+	void handleEvent(const sf::RenderTarget& target, const sf::Event& event) override;
+
+private:
+	struct Child
+	{
+		Widget* widget;
+		sf::Vector2f localPosition;
+		// Set for nested groups, so update() can descend without a cast per frame
+		WidgetGroup* group;
+	};
+
+	void onBoundsChanged(Widget& widget) override;
+	void place(Child& child);
+	Child* find(const Widget& widget);
+	const Child* find(const Widget& widget) const;
+
+	WidgetContainer _children;
+	std::vector<Child> _entries;
+
+	sf::Vector2f _position;
+	mutable sf::FloatRect _bounds;
+	mutable bool _areBoundsStale = true;
+	// Set while the group moves its own children, so it hears about it once, not once per child
+	bool _isPlacing = false;
+};
+
+#endif //WIDGET_GROUP_HPP
\ No newline at end of file
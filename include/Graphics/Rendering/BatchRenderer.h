@@ -0,0 +1,95 @@
+#ifndef BATCH_RENDERER_HPP
+#define BATCH_RENDERER_HPP
+
+#include <vector>
+#include <cstddef>
+
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+#include <Graphics/Rendering/TextLayout.h>
+
+struct AtlasRegion;
+
+//--------------------------------------------------------------
+//	Collects widget geometry into shared vertex arrays and
+//	submits it with one draw call per texture.
+//
+//	Untextured geometry (shapes, gradients) keeps its submission
+//	order and is drawn first, then skins grouped by atlas page,
+//	then glyph quads grouped by font page. Within a layer all
+//	text lands on top of all shapes, so a widget drawn over
+//	another (a popup over a labelled button) would show the
+//	lower label through it: such widgets call flush() before and
+//	after their geometry to draw in a layer of their own, and
+//	report DrawRecording::Direct so recordings split around them.
+//--------------------------------------------------------------
+
+class BatchRenderer
+{
+public:
+	struct Statistics
+	{
+		std::size_t drawCalls = 0;
+		std::size_t vertices = 0;
+	};
+
+	BatchRenderer();
+
+	void begin(sf::RenderTarget& target);
+	void end();
+	void flush();
+
+	void addRect(const sf::FloatRect& rect, const sf::Color& color,
+		const sf::Transform& transform = sf::Transform::Identity);
+	void addQuad(const sf::Vertex& topLeft, const sf::Vertex& topRight,
+		const sf::Vertex& bottomRight, const sf::Vertex& bottomLeft,
+		const sf::Texture* texture = nullptr);
+	// Untextured triangle list, e.g. a widget's prebuilt local geometry
+	void addTriangles(const sf::Vertex* vertices, std::size_t count,
+		const sf::Transform& transform = sf::Transform::Identity);
+	void addShape(const sf::RectangleShape& shape);
+	// Nine-slice aware; regions on the same atlas page share one draw call
+	void addRegion(const AtlasRegion& region, const sf::FloatRect& rect, const sf::Color& color,
+		const sf::Transform& transform = sf::Transform::Identity);
+	void addText(const sf::Text& text);
+	void addText(const TextLayout& layout, const sf::Color& color, const sf::Transform& transform);
+	void addGlyphs(const sf::Vertex* vertices, std::size_t count, const sf::Texture* texture,
+		const sf::Color& color, const sf::Transform& transform);
+
+	// Moves what a renderer that was never begun recorded behind this one's geometry, batch by
+	// batch. Widgets recorded into one such renderer per chunk and appended in chunk order give
+	// exactly the batches drawing them here one by one would have
+	void append(BatchRenderer& recorded);
+
+	sf::RenderTarget& getTarget() const;
+	bool isActive() const;
+
+	const Statistics& getStatistics() const;
+	void resetStatistics();
+
+private:
+	struct TextureBatch
+	{
+		const sf::Texture* texture;
+		sf::VertexArray vertices;
+	};
+
+	static sf::VertexArray& batchFor(std::vector<TextureBatch>& batches, const sf::Texture* texture);
+	sf::VertexArray& batchFor(const sf::Texture* texture);
+	static void appendBatches(std::vector<TextureBatch>& batches, std::vector<TextureBatch>& recorded);
+	void submit(std::vector<TextureBatch>& batches);
+
+	sf::RenderTarget* _target;
+	sf::VertexArray _solid;
+	// Kept apart from _textured so a skin never covers text, whichever was seen first
+	std::vector<TextureBatch> _skins;
+	std::vector<TextureBatch> _textured;
+	std::vector<sf::Vertex> _glyphs;
+	Statistics _statistics;
+};
+
+#endif //BATCH_RENDERER_HPP
\ No newline at end of file
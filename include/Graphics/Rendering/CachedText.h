@@ -0,0 +1,65 @@
+#ifndef CACHED_TEXT_HPP
+#define CACHED_TEXT_HPP
+
+#include <memory>
+#include <vector>
+
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/System/String.hpp>
+
+#include <Graphics/Rendering/TextLayout.h>
+#include <Graphics/Rendering/BatchRenderer.h>
+
+//--------------------------------------------------------------
+//	Drop-in for sf::Text on hot paths. Setting the string it
+//	already shows is free, and with a shared font the glyph
+//	layout comes from TextLayoutCache, so repeated labels are
+//	laid out once for the whole program.
+//--------------------------------------------------------------
+
+class CachedText : public sf::Transformable
+{
+public:
+	CachedText();
+
+	// Cached: the layout is shared through TextLayoutCache
+	void setFont(std::shared_ptr<const sf::Font> font);
+	// Uncached: the font must outlive the text, as with sf::Text
+	void setFont(const sf::Font& font);
+
+	void setString(const sf::String& string);
+	void setCharacterSize(unsigned int characterSize);
+	void setBold(bool isBold);
+	void setFillColor(const sf::Color& color);
+	// Room for strings up to this many glyphs, so changing the string never allocates when drawn directly
+	void reserve(std::size_t glyphCount);
+
+	const sf::String& getString() const;
+	unsigned int getCharacterSize() const;
+	const sf::Color& getFillColor() const;
+
+	sf::FloatRect getLocalBounds() const;
+	sf::FloatRect getGlobalBounds() const;
+
+	void draw(sf::RenderTarget& target) const;
+	void draw(BatchRenderer& renderer) const;
+
+private:
+	void refreshLayout();
+
+	std::shared_ptr<const sf::Font> _sharedFont;
+	const sf::Font* _font;
+	std::shared_ptr<const TextLayout> _layout;
+
+	sf::String _string;
+	unsigned int _characterSize;
+	bool _isBold;
+	sf::Color _fillColor;
+
+	mutable std::vector<sf::Vertex> _coloredVertices;
+	mutable bool _isColorDirty;
+};
+
+#endif //CACHED_TEXT_HPP
\ No newline at end of file
@@ -0,0 +1,69 @@
+#ifndef RETAINED_CANVAS_HPP
+#define RETAINED_CANVAS_HPP
+
+#include <vector>
+#include <cstddef>
+#include <unordered_map>
+
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+
+#include <Graphics/InterfaceElements/Widget.h>
+#include <Graphics/Rendering/BatchRenderer.h>
+
+//--------------------------------------------------------------
+//	Keeps the composed UI in a render texture and repaints only
+//	the regions covered by widgets that reported invalidation.
+//
+//	Widgets are recorded on the JobSystem, one renderer per
+//	chunk, and appended to the frame's renderer in order. Those
+//	whose prepareDraw() ties them to the render thread are
+//	recorded there first and spliced in by their chunk; those
+//	drawing to the target themselves split the recording. Only
+//	submission touches the GPU, and the batches come out as if
+//	every widget had been drawn in turn.
+//--------------------------------------------------------------
+
+class RetainedCanvas
+{
+public:
+	explicit RetainedCanvas(const sf::Color& clearColor = sf::Color::Black);
+
+	void create(const sf::Vector2u& size);
+	void invalidateAll();
+	void remove(const Widget& widget);
+
+	// Returns false when nothing changed and the previous frame can be kept
+	bool update(const std::vector<Widget*>& widgets, BatchRenderer& renderer);
+	void present(sf::RenderTarget& target) const;
+
+	const sf::Texture& getTexture() const;
+
+private:
+	void addDirtyRegion(const sf::FloatRect& region);
+	void repaint(const sf::FloatRect& region, const std::vector<Widget*>& widgets, BatchRenderer& renderer);
+	// Every widget, or those overlapping region, in order
+	void drawWidgets(const std::vector<Widget*>& widgets, const sf::FloatRect* region, BatchRenderer& renderer);
+	// _drawn[first, last) through the per-chunk recorders
+	void record(std::size_t first, std::size_t last, BatchRenderer& renderer);
+
+	sf::RenderTexture _texture;
+	sf::Color _clearColor;
+	sf::Vector2u _size;
+
+	bool _fullRedraw;
+
+	std::unordered_map<const Widget*, sf::FloatRect> _drawnBounds;
+	std::vector<sf::FloatRect> _dirtyRegions;
+
+	// This draw's widgets and what their prepareDraw() said; kept between frames so drawing doesn't allocate
+	std::vector<Widget*> _drawn;
+	std::vector<DrawRecording> _recordings;
+	// One recorder per chunk, and one per render-thread widget with the slot it took, by index in _drawn
+	std::vector<BatchRenderer> _recorders;
+	std::vector<BatchRenderer> _pinned;
+	std::vector<std::size_t> _pinnedSlots;
+};
+
+#endif //RETAINED_CANVAS_HPP
\ No newline at end of file
@@ -0,0 +1,127 @@
+#ifndef TEXT_LAYOUT_HPP
+#define TEXT_LAYOUT_HPP
+
+#include <mutex>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstddef>
+#include <unordered_map>
+
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/String.hpp>
+
+namespace TextLayoutConstants
+{
+	constexpr std::size_t MAX_CACHED_LAYOUTS = 512;
+	constexpr float GLYPH_PADDING = 1.f;
+	// Two triangles per glyph quad
+	constexpr std::size_t VERTICES_PER_GLYPH = 6;
+}
+
+//--------------------------------------------------------------
+//	Glyph quads of one string in local text space, laid out
+//	once. Vertices are white triangles with texture coordinates
+//	into the font page; color and transform are applied when
+//	they are submitted.
+//--------------------------------------------------------------
+
+struct TextLayout
+{
+	const sf::Texture* texture = nullptr;
+	std::vector<sf::Vertex> vertices;
+	sf::FloatRect bounds;
+
+	static void appendGlyphs(std::vector<sf::Vertex>& vertices, sf::FloatRect& bounds,
+		const sf::Font& font, std::basic_string_view<sf::Uint32> text,
+		unsigned int characterSize, bool isBold = false, float lineSpacing = 1.f);
+	static void appendGlyphs(std::vector<sf::Vertex>& vertices, sf::FloatRect& bounds,
+		const sf::Font& font, const sf::String& string,
+		unsigned int characterSize, bool isBold = false, float lineSpacing = 1.f);
+
+	// Pen position after a single line of text, as appendGlyphs advances it
+	static float measure(const sf::Font& font, std::basic_string_view<sf::Uint32> text,
+		unsigned int characterSize, bool isBold = false);
+	// Pen position at every character boundary of a single line, text.size() + 1 of them
+	static void measureColumns(std::vector<float>& columns, const sf::Font& font,
+		std::basic_string_view<sf::Uint32> text, unsigned int characterSize, bool isBold = false);
+	// Index of the character boundary closest to x on a single line
+	static std::size_t indexAt(const sf::Font& font, std::basic_string_view<sf::Uint32> text,
+		unsigned int characterSize, float x, bool isBold = false);
+
+	static std::shared_ptr<const TextLayout> create(const sf::Font& font, const sf::String& string,
+		unsigned int characterSize, bool isBold = false);
+};
+
+//--------------------------------------------------------------
+//	Shares layouts of repeated strings (percentages, counters,
+//	labels) between all texts using the same font and size.
+//	Entries keep their font alive; layouts nobody references
+//	are dropped once the cache is full.
+//--------------------------------------------------------------
+
+class TextLayoutCache
+{
+public:
+	static TextLayoutCache& getInstance();
+
+	std::shared_ptr<const TextLayout> acquire(const std::shared_ptr<const sf::Font>& font,
+		const sf::String& string, unsigned int characterSize, bool isBold = false);
+
+	void clear();
+	std::size_t size() const;
+
+private:
+	TextLayoutCache() = default;
+	TextLayoutCache(const TextLayoutCache&) = delete;
+	TextLayoutCache& operator=(const TextLayoutCache&) = delete;
+
+	struct KeyView
+	{
+		const sf::Font* font;
+		unsigned int characterSize;
+		bool isBold;
+		std::basic_string_view<sf::Uint32> text;
+
+		bool operator==(const KeyView& other) const = default;
+	};
+
+	struct Key
+	{
+		const sf::Font* font;
+		unsigned int characterSize;
+		bool isBold;
+		std::basic_string<sf::Uint32> text;
+
+		operator KeyView() const { return { font, characterSize, isBold, text }; }
+	};
+
+	struct KeyHash
+	{
+		using is_transparent = void;
+		std::size_t operator()(const KeyView& key) const;
+	};
+
+	struct KeyEqual
+	{
+		using is_transparent = void;
+		bool operator()(const KeyView& a, const KeyView& b) const { return a == b; }
+	};
+
+	struct Entry
+	{
+		std::shared_ptr<const sf::Font> font;
+		std::shared_ptr<const TextLayout> layout;
+	};
+
+	void evictUnused();
+
+	mutable std::mutex _mutex;
+	std::unordered_map<Key, Entry, KeyHash, KeyEqual> _layouts;
+};
+
+#endif //TEXT_LAYOUT_HPP
\ No newline at end of file
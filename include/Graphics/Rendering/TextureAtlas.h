@@ -0,0 +1,147 @@
+#ifndef TEXTURE_ATLAS_HPP
+#define TEXTURE_ATLAS_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <unordered_map>
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+
+namespace TextureAtlasConstants
+{
+	constexpr unsigned int DEFAULT_PAGE_SIZE = 2048;
+	// Gap around every image, filled with copies of its edge so filtering never reaches a neighbour
+	constexpr unsigned int PADDING = 2;
+	constexpr const char* INDEX_HEADER = "atlas 1";
+	// Two triangles for each of the nine cells
+	constexpr std::size_t REGION_VERTICES = 9 * 6;
+}
+
+// Border widths in source pixels. Corners keep their size, edges stretch along one axis, the centre along both
+struct NineSlice
+{
+	int left = 0;
+	int top = 0;
+	int right = 0;
+	int bottom = 0;
+
+	bool isEmpty() const { return left == 0 && top == 0 && right == 0 && bottom == 0; }
+};
+
+//--------------------------------------------------------------
+//	A piece of a texture used as a widget skin or icon. Widgets
+//	keep a pointer to it; the atlas that owns it has to outlive
+//	them. A region can also describe a whole standalone texture.
+//--------------------------------------------------------------
+
+struct AtlasRegion
+{
+	const sf::Texture* texture = nullptr;
+	sf::IntRect rect;
+	NineSlice slice;
+
+	// Stretches the region over area as triangles, tinted with color
+	void append(sf::VertexArray& vertices, const sf::FloatRect& area, const sf::Color& color,
+		const sf::Transform& transform) const;
+	// Same triangles into a REGION_VERTICES array; returns the vertex count
+	std::size_t build(sf::Vertex* vertices, const sf::FloatRect& area, const sf::Color& color,
+		const sf::Transform& transform) const;
+	// Unbatched path, one draw call and no allocation
+	void draw(sf::RenderTarget& target, const sf::FloatRect& area, const sf::Color& color,
+		const sf::Transform& transform) const;
+};
+
+//--------------------------------------------------------------
+//	Packed atlas pages still in system memory. Packing, saving
+//	and loading don't touch the graphics context, so they can
+//	run on a loader thread or offline; TextureAtlas uploads the
+//	result. The saved form is a text index listing the regions
+//	plus one PNG per page next to it.
+//--------------------------------------------------------------
+
+struct PackedAtlas
+{
+	struct Entry
+	{
+		std::string name;
+		std::size_t page;
+		sf::IntRect rect;
+		NineSlice slice;
+	};
+
+	std::vector<sf::Image> pages;
+	std::vector<Entry> entries;
+
+	bool save(const std::string& indexPath) const;
+	// Throws FileLoadException
+	static PackedAtlas load(const std::string& indexPath);
+};
+
+//--------------------------------------------------------------
+//	Packs images into as few pages as possible with a skyline
+//	bottom-left packer, tallest images first. Pages are trimmed
+//	to the area actually used.
+//--------------------------------------------------------------
+
+class TextureAtlasBuilder
+{
+public:
+	// Names can't be empty or contain whitespace; throws std::invalid_argument
+	void add(const std::string& name, const sf::Image& image, const NineSlice& slice = {});
+	// Throws FileLoadException
+	void addFile(const std::string& name, const std::string& path, const NineSlice& slice = {});
+
+	// Throws std::invalid_argument when an image is larger than a page
+	PackedAtlas pack(unsigned int pageSize = TextureAtlasConstants::DEFAULT_PAGE_SIZE) const;
+
+	std::size_t size() const { return _images.size(); }
+
+private:
+	struct Source
+	{
+		std::string name;
+		sf::Image image;
+		NineSlice slice;
+	};
+
+	std::vector<Source> _images;
+};
+
+//--------------------------------------------------------------
+//	Uploaded atlas pages and the regions on them. Moving the
+//	atlas keeps region pointers valid.
+//--------------------------------------------------------------
+
+class TextureAtlas
+{
+public:
+	TextureAtlas() = default;
+	// Uploads the pages; needs the graphics context. Throws FileLoadException if an upload fails
+	explicit TextureAtlas(const PackedAtlas& packed);
+
+	TextureAtlas(TextureAtlas&&) = default;
+	TextureAtlas& operator=(TextureAtlas&&) = default;
+
+	const AtlasRegion* find(const std::string& name) const;
+	// Throws std::invalid_argument for unknown names
+	const AtlasRegion& get(const std::string& name) const;
+
+	std::size_t getPageCount() const { return _pages.size(); }
+	const sf::Texture& getPage(std::size_t index) const { return *_pages[index]; }
+	std::size_t size() const { return _regions.size(); }
+
+private:
+	std::vector<std::unique_ptr<sf::Texture>> _pages;
+	// Node-based, so regions stay where they are when the map grows or moves
+	std::unordered_map<std::string, AtlasRegion> _regions;
+};
+
+#endif //TEXTURE_ATLAS_HPP
\ No newline at end of file
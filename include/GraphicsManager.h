@@ -2,12 +2,37 @@
 #define GRAPHICS_MANAGER_HPP
 
 #include <Graphics/InterfaceElements/Button.h>
+#include <Graphics/InterfaceElements/ButtonStyle.h>
 #include <Graphics/InterfaceElements/TextField.h>
 #include <Graphics/InterfaceElements/CheckBox.h>
 #include <Graphics/InterfaceElements/Factories/Default_button_factory.h>
 #include <Graphics/InterfaceElements/Factories/Default_CheckBox_factory.h>
 #include <Exceptions.h>
+#include <FontCache.h>
 #include <AnchoredElement.h>
+#include <AnchorLayout.h>
+#include <AnchorLayoutBatch.h>
+#include <WidgetContainer.h>
+#include <WidgetPool.h>
+#include <TextDocument.h>
 #include <Graphics/InterfaceElements/ProgressBar.h>
+#include <Graphics/InterfaceElements/ProfilerOverlay.h>
+#include <Graphics/InterfaceElements/VirtualList.h>
+#include <Graphics/InterfaceElements/WidgetGroup.h>
+#include <Graphics/InterfaceElements/ImmediateUi.h>
+#include <Profiler.h>
+#include <AnimationScheduler.h>
+#include <JobSystem.h>
+#include <UpdateQueue.h>
+#include <InputQueue.h>
+#include <LayoutDocument.h>
+#include <LayoutInstance.h>
+#include <ResourceWatcher.h>
+#include <ResourceLoader.h>
+#include <Graphics/Rendering/BatchRenderer.h>
+#include <Graphics/Rendering/RetainedCanvas.h>
+#include <Graphics/Rendering/TextLayout.h>
+#include <Graphics/Rendering/CachedText.h>
+#include <Graphics/Rendering/TextureAtlas.h>
 
 #endif //GRAPHICS_MANAGER_HPP
\ No newline at end of file
@@ -0,0 +1,44 @@
+#ifndef INPUT_QUEUE_HPP
+#define INPUT_QUEUE_HPP
+
+#include <vector>
+#include <cstddef>
+
+#include <SFML/Window/Event.hpp>
+#include <SFML/Window/Window.hpp>
+
+//--------------------------------------------------------------
+//	Collects one frame of window events in order. A MouseMoved
+//	directly after another only updates the cursor position,
+//	wheel steps at the same spot add up, and only the last
+//	Resized of the frame is kept. Clicks, keys and text input
+//	are never merged or dropped.
+//--------------------------------------------------------------
+
+class InputQueue
+{
+public:
+	using const_iterator = std::vector<sf::Event>::const_iterator;
+
+	// Drains the window's event queue into this one
+	std::size_t poll(sf::Window& window);
+	void push(const sf::Event& event);
+	void clear();
+
+	const_iterator begin() const { return _events.begin(); }
+	const_iterator end() const { return _events.end(); }
+
+	std::size_t size() const { return _events.size(); }
+	bool empty() const { return _events.empty(); }
+
+	// Events merged away since the last clear()
+	std::size_t getCoalescedCount() const { return _coalesced; }
+
+private:
+	bool coalesce(const sf::Event& event);
+
+	std::vector<sf::Event> _events;
+	std::size_t _coalesced = 0;
+};
+
+#endif //INPUT_QUEUE_HPP
\ No newline at end of file
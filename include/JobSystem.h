@@ -0,0 +1,122 @@
+#ifndef JOB_SYSTEM_HPP
+#define JOB_SYSTEM_HPP
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <condition_variable>
+
+namespace JobSystemConstants
+{
+	constexpr std::size_t CACHE_LINE = 64;
+}
+
+//--------------------------------------------------------------
+//	Work-stealing pool for the per-frame loops: layout, tweens
+//	and widget geometry. parallelFor() cuts [0, count) into
+//	chunks of a fixed size and hands every thread, the caller
+//	included, an even run of them. A thread works through its
+//	own run from the front and, once it is empty, steals from
+//	the back of the others.
+//
+//	Chunk boundaries depend only on count and chunk size, never
+//	on the number of threads or who ran what, so anything
+//	written per index or per chunk comes out the same as on one
+//	thread. A range of a single chunk, a pool without workers
+//	and calls made from inside a job run on the calling thread.
+//
+//	One parallelFor() at a time, from the UI thread. The caller
+//	blocks until every chunk is done; the first exception a
+//	chunk threw is rethrown there. Running a loop allocates
+//	nothing.
+//--------------------------------------------------------------
+
+class JobSystem
+{
+public:
+	static JobSystem& getInstance();
+	// One fewer than the hardware threads, since the caller runs chunks too
+	static std::size_t getDefaultWorkerCount();
+
+	// 0 runs everything on the calling thread; waits for the current workers to stop
+	void setWorkerCount(std::size_t count);
+	std::size_t getWorkerCount() const;
+
+	static std::size_t getChunkCount(std::size_t count, std::size_t chunkSize)
+	{
+		return chunkSize == 0 ? 0 : (count + chunkSize - 1) / chunkSize;
+	}
+
+	// body(first, last) for every chunk; a chunk's index is first / chunkSize
+	template<class Body>
+	void parallelFor(std::size_t count, std::size_t chunkSize, Body&& body)
+	{
+		struct Context
+		{
+			Body& body;
+			std::size_t count;
+			std::size_t chunkSize;
+		};
+
+		Context context{ body, count, chunkSize };
+
+		run(getChunkCount(count, chunkSize), [](void* data, std::size_t chunk)
+			{
+				Context& context = *static_cast<Context*>(data);
+				const std::size_t first = chunk * context.chunkSize;
+				context.body(first, std::min(first + context.chunkSize, context.count));
+			}, &context);
+	}
+
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+private:
+	using ChunkFunction = void(*)(void* context, std::size_t chunk);
+
+	// Next and end chunk of one thread's run, packed so the owner and thieves race on one word
+	struct alignas(JobSystemConstants::CACHE_LINE) Run
+	{
+		std::atomic<std::uint64_t> range{ 0 };
+	};
+
+	explicit JobSystem(std::size_t workerCount);
+
+	void run(std::size_t chunkCount, ChunkFunction function, void* context);
+	void work(std::stop_token stopToken, std::size_t index, std::uint64_t seenGeneration);
+	// Own run first, then the others'; returns once nothing is left to take
+	void runChunks(std::size_t index);
+	void runChunk(std::size_t chunk);
+
+	static bool takeFront(Run& run, std::size_t& chunk);
+	static bool takeBack(Run& run, std::size_t& chunk);
+
+	void startWorkers(std::size_t count);
+	void stopWorkers();
+
+	// One per worker, the last one is the caller's
+	std::unique_ptr<Run[]> _runs;
+	std::size_t _runCount = 0;
+
+	std::mutex _mutex;
+	std::condition_variable_any _hasWork;
+	std::condition_variable _isDone;
+	std::uint64_t _generation = 0;
+	std::size_t _busyWorkers = 0;
+
+	ChunkFunction _function = nullptr;
+	void* _context = nullptr;
+	std::exception_ptr _exception;
+
+	std::vector<std::jthread> _threads;
+};
+
+#endif //JOB_SYSTEM_HPP
\ No newline at end of file
@@ -0,0 +1,174 @@
+#ifndef LAYOUT_DOCUMENT_HPP
+#define LAYOUT_DOCUMENT_HPP
+
+#include <span>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <string_view>
+#include <type_traits>
+
+#include <MappedFile.h>
+
+enum class LayoutNodeType : std::uint8_t
+{
+	Stack,
+	Button,
+	CheckBox,
+	TextField,
+	ProgressBar
+};
+
+enum class LayoutProperty : std::uint8_t
+{
+	Text,
+	Font,
+	CharacterSize,
+	Anchor,
+	Offset,
+	Size,
+	Spacing,
+	Direction,
+	Fill,
+	Hover,
+	Pressed,
+	Disabled,
+	Outline,
+	OutlineThickness,
+	Background,
+	Value,
+	MaxValue,
+	Smoothness,
+	Vertical,
+	Percentage,
+	Multiline,
+	MaxLength,
+	Checked,
+	Enabled,
+	OnClick,
+	OnToggle,
+	OnChange
+};
+
+namespace LayoutConstants
+{
+	constexpr char MAGIC[4] = { 'G', 'M', 'L', 'B' };
+	constexpr std::uint32_t VERSION = 1;
+
+	constexpr std::uint32_t NO_PARENT = 0xFFFFFFFF;
+	// Offset of the empty string every string table starts with
+	constexpr std::uint32_t NO_STRING = 0;
+	constexpr std::size_t MAX_NUMBERS = 4;
+}
+
+//--------------------------------------------------------------
+//	Records of a compiled layout. The in-memory form and the
+//	file are the same bytes: header, nodes in document order,
+//	their property values, then a table of zero-terminated
+//	strings. Children follow their parent and refer back to it.
+//	Files are written in the native byte order.
+//--------------------------------------------------------------
+
+struct LayoutFileHeader
+{
+	char magic[4];
+	std::uint32_t version;
+	// Stamp of the text the file was compiled from, used to detect a stale cache
+	std::int64_t sourceTime;
+	std::uint64_t sourceSize;
+	std::uint32_t nodeCount;
+	std::uint32_t valueCount;
+	std::uint32_t stringsSize;
+	std::uint32_t reserved;
+};
+
+struct LayoutNode
+{
+	LayoutNodeType type;
+	std::uint8_t reserved[3];
+	std::uint32_t name;
+	std::uint32_t parent;
+	std::uint32_t firstValue;
+	std::uint32_t valueCount;
+};
+
+struct LayoutValue
+{
+	LayoutProperty property;
+	std::uint8_t numberCount;
+	std::uint8_t reserved[2];
+	std::uint32_t text;
+	float numbers[LayoutConstants::MAX_NUMBERS];
+};
+
+static_assert(std::is_trivially_copyable_v<LayoutFileHeader> && sizeof(LayoutFileHeader) == 40);
+static_assert(std::is_trivially_copyable_v<LayoutNode> && sizeof(LayoutNode) == 20);
+static_assert(std::is_trivially_copyable_v<LayoutValue> && sizeof(LayoutValue) == 24);
+
+//--------------------------------------------------------------
+//	A parsed or memory-mapped layout description.
+//
+//	Text form, one property per line, '#' starts a comment:
+//
+//		style primary
+//		{
+//			fill 21 21 178
+//			hover 20 66 241
+//		}
+//
+//		stack actions
+//		{
+//			anchor center bottom
+//			offset -70 -300
+//			size 240 50
+//			spacing 10
+//
+//			button generate
+//			{
+//				style primary
+//				text "Generate"
+//				onClick generate
+//			}
+//		}
+//
+//	Styles are merged into the widgets that name them while
+//	parsing, so the compiled form only holds plain properties.
+//	load() keeps a binary cache next to the text and maps it
+//	instead of parsing whenever it is up to date.
+//--------------------------------------------------------------
+
+class LayoutDocument
+{
+public:
+	LayoutDocument() = default;
+
+	// All loaders throw LayoutException on malformed input and FileLoadException on I/O errors
+	static LayoutDocument parse(std::string_view source, const std::string& origin = "layout");
+	static LayoutDocument loadText(const std::string& path);
+	static LayoutDocument loadBinary(const std::string& path);
+	static LayoutDocument load(const std::string& sourcePath, const std::string& cachePath);
+
+	bool save(const std::string& path) const;
+
+	std::span<const LayoutNode> getNodes() const;
+	std::span<const LayoutValue> getValues(const LayoutNode& node) const;
+	const char* getString(std::uint32_t offset) const;
+
+	const LayoutNode* find(std::string_view name) const;
+
+	bool isMapped() const { return _file.isOpen(); }
+	bool isEmpty() const { return getNodes().empty(); }
+
+private:
+	void attach(const char* data, std::size_t size, const std::string& origin);
+	const LayoutFileHeader& header() const;
+
+	std::vector<char> _image;
+	MappedFile _file;
+
+	const char* _data = nullptr;
+	std::size_t _size = 0;
+};
+
+#endif //LAYOUT_DOCUMENT_HPP
\ No newline at end of file
@@ -0,0 +1,148 @@
+#ifndef LAYOUT_INSTANCE_HPP
+#define LAYOUT_INSTANCE_HPP
+
+#include <string>
+#include <vector>
+#include <variant>
+#include <functional>
+#include <unordered_map>
+
+#include <Graphics/InterfaceElements/Button.h>
+#include <Graphics/InterfaceElements/CheckBox.h>
+#include <Graphics/InterfaceElements/TextField.h>
+#include <Graphics/InterfaceElements/ProgressBar.h>
+#include <Graphics/InterfaceElements/Factories/Default_button_factory.h>
+#include <LayoutDocument.h>
+#include <AnchorLayout.h>
+#include <WidgetContainer.h>
+
+namespace LayoutInstanceConstants
+{
+	constexpr unsigned int DEFAULT_CHARACTER_SIZE = 16;
+	constexpr float DEFAULT_CHECK_BOX_SIZE = 20.f;
+	constexpr float DEFAULT_BUTTON_WIDTH = 200.f;
+	constexpr float DEFAULT_BUTTON_HEIGHT = 50.f;
+	constexpr float DEFAULT_PROGRESS_BAR_WIDTH = 200.f;
+	constexpr float DEFAULT_PROGRESS_BAR_HEIGHT = 30.f;
+}
+
+//--------------------------------------------------------------
+//	Callbacks a layout refers to by name from onClick, onToggle
+//	and onChange.
+//--------------------------------------------------------------
+
+class LayoutBindings
+{
+public:
+	void bindClick(const std::string& name, std::function<void()> action);
+	void bindToggle(const std::string& name, std::function<void(bool)> action);
+	void bindChange(const std::string& name, std::function<void(float)> action);
+
+	// Throw LayoutException for names nothing was bound to
+	const std::function<void()>& getClick(const std::string& name) const;
+	const std::function<void(bool)>& getToggle(const std::string& name) const;
+	const std::function<void(float)>& getChange(const std::string& name) const;
+
+private:
+	std::unordered_map<std::string, std::function<void()>> _clicks;
+	std::unordered_map<std::string, std::function<void(bool)>> _toggles;
+	std::unordered_map<std::string, std::function<void(float)>> _changes;
+};
+
+//--------------------------------------------------------------
+//	Widgets built from a LayoutDocument. They are allocated from
+//	the container's pools and destroyed with the instance, which
+//	positions them through its own AnchorLayout. Throwing while
+//	building leaves the container as it was; whatever failed is
+//	reported as a LayoutException.
+//
+//	reload() and reloadFont() rebuild in place: a widget whose
+//	node is unchanged apart from its position is kept with its
+//	state, only new or changed nodes get new widgets.
+//--------------------------------------------------------------
+
+class LayoutInstance
+{
+public:
+	LayoutInstance(LayoutDocument document, WidgetContainer& container, const LayoutBindings& bindings);
+	~LayoutInstance();
+
+	LayoutInstance(const LayoutInstance&) = delete;
+	LayoutInstance& operator=(const LayoutInstance&) = delete;
+
+	// Both return the number of widgets created; on throwing the previous widgets stay
+	std::size_t reload(LayoutDocument document);
+	std::size_t reloadFont(const std::string& path);
+
+	// Named widget of the given type, nullptr if there is none
+	template<class T>
+	T* find(const std::string& name) const
+	{
+		auto found = _named.find(name);
+		if (found == _named.end()) return nullptr;
+
+		const Entry& entry = _entries[found->second];
+		return std::holds_alternative<WidgetHandle<T>>(entry.handle) ? static_cast<T*>(entry.widget) : nullptr;
+	}
+
+	// Resolved paths of every font the widgets use
+	std::vector<std::string> getFontPaths() const;
+	// Fonts building the document will ask for, to load them ahead of time
+	static std::vector<std::string> getFontPaths(const LayoutDocument& document);
+
+	void setWindowSize(const sf::Vector2u& windowSize);
+	std::size_t apply();
+
+	std::size_t size() const { return _entries.size(); }
+
+private:
+	struct Placement
+	{
+		AnchorHorizontal horizontal = AnchorHorizontal::LEFT;
+		AnchorVertical vertical = AnchorVertical::TOP;
+		sf::Vector2f offset;
+		sf::Vector2f size;
+		// Slot of a widget inside its stacks, added after anchoring
+		sf::Vector2f shift;
+		bool hasSize = false;
+
+		// Stacks only
+		sf::Vector2f cursor;
+		float spacing = 0.f;
+		bool isHorizontal = false;
+	};
+
+	using Handle = std::variant<WidgetHandle<Button>, WidgetHandle<CheckBox>,
+		WidgetHandle<TextField>, WidgetHandle<ProgressBar>>;
+
+	struct Entry
+	{
+		Handle handle;
+		Widget* widget = nullptr;
+		Placement placement;
+
+		// Node name, or the node's slot under its parent when it has none
+		std::string key;
+		std::string name;
+		// Everything the widget was built from except where it sits
+		std::string signature;
+		std::string font;
+		bool isNew = true;
+	};
+
+	std::size_t rebuild();
+	void create(const LayoutNode& node, const Placement& placement, DefaultButtonFactory& buttonFactory, Entry& entry);
+	void place(const Entry& entry);
+	void destroy(const Entry& entry);
+	void destroyAll();
+
+	LayoutDocument _document;
+	WidgetContainer& _container;
+	const LayoutBindings& _bindings;
+	AnchorLayout _layout;
+
+	std::vector<Entry> _entries;
+	std::unordered_map<std::string, std::size_t> _named;
+};
+
+#endif //LAYOUT_INSTANCE_HPP
\ No newline at end of file
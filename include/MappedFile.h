@@ -0,0 +1,39 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+#include <string>
+#include <cstddef>
+
+//--------------------------------------------------------------
+//	Read-only memory mapping of a whole file. Pages are loaded
+//	by the OS on first touch, so opening a large file costs the
+//	same as opening a small one.
+//--------------------------------------------------------------
+
+class MappedFile
+{
+public:
+	MappedFile() = default;
+
+	// Throws FileLoadException when the file can't be opened or mapped
+	explicit MappedFile(const std::string& path);
+	~MappedFile();
+
+	MappedFile(MappedFile&& other) noexcept;
+	MappedFile& operator=(MappedFile&& other) noexcept;
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	const char* data() const { return _data; }
+	std::size_t size() const { return _size; }
+	bool isOpen() const { return _data != nullptr; }
+
+private:
+	void close();
+
+	const char* _data = nullptr;
+	std::size_t _size = 0;
+};
+
+#endif //MAPPED_FILE_HPP
\ No newline at end of file
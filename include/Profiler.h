@@ -0,0 +1,133 @@
+#ifndef PROFILER_HPP
+#define PROFILER_HPP
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+enum class ProfilerCounter
+{
+	DrawCalls,
+	Vertices,
+	TextLayouts,
+	EventDispatches,
+	AnchorUpdates,
+	FillUpdates,
+	Animations,
+	QueuedUpdates,
+	CulledWidgets,
+	Count
+};
+
+//--------------------------------------------------------------
+//	Frame profiler. Counters and scoped timers cost a single
+//	relaxed load while disabled. Finished frames go to a ring
+//	buffer; during a capture every timed scope is also recorded
+//	and can be written out as a Chrome trace (chrome://tracing).
+//--------------------------------------------------------------
+
+class Profiler
+{
+public:
+	static constexpr std::size_t HISTORY_SIZE = 240;
+	static constexpr std::size_t COUNTER_COUNT = static_cast<std::size_t>(ProfilerCounter::Count);
+
+	using Clock = std::chrono::steady_clock;
+
+	struct Frame
+	{
+		std::uint64_t index = 0;
+		double durationMs = 0.0;
+		std::array<std::uint32_t, COUNTER_COUNT> counters{};
+	};
+
+	static Profiler& getInstance();
+	static const char* getCounterName(ProfilerCounter counter);
+
+	void setEnabled(bool enabled);
+	bool isEnabled() const { return _isEnabled.load(std::memory_order_relaxed); }
+
+	void beginFrame();
+	void endFrame();
+
+	void increment(ProfilerCounter counter, std::uint32_t amount = 1)
+	{
+		if (!isEnabled()) return;
+		_counters[static_cast<std::size_t>(counter)].fetch_add(amount, std::memory_order_relaxed);
+	}
+
+	void recordZone(const char* name, Clock::time_point start, Clock::time_point end);
+
+	// Frames ordered from the oldest to the newest
+	std::size_t getHistorySize() const;
+	const Frame& getHistoryFrame(std::size_t index) const;
+	const Frame& getLastFrame() const;
+
+	void beginCapture();
+	bool endCapture(const std::string& path);
+	bool isCapturing() const { return _isCapturing.load(std::memory_order_relaxed); }
+
+private:
+	struct Zone
+	{
+		const char* name;
+		std::int64_t startUs;
+		std::int64_t durationUs;
+		std::uint32_t threadId;
+	};
+
+	Profiler();
+	Profiler(const Profiler&) = delete;
+	Profiler& operator=(const Profiler&) = delete;
+
+	std::int64_t toTraceTime(Clock::time_point time) const;
+	static std::uint32_t currentThreadId();
+
+	std::atomic<bool> _isEnabled{ false };
+	std::atomic<bool> _isCapturing{ false };
+	std::array<std::atomic<std::uint32_t>, COUNTER_COUNT> _counters{};
+
+	Clock::time_point _epoch;
+	Clock::time_point _frameStart;
+	std::uint64_t _frameIndex = 0;
+
+	std::array<Frame, HISTORY_SIZE> _history{};
+	std::size_t _historyHead = 0;
+	std::size_t _historySize = 0;
+
+	std::mutex _captureMutex;
+	std::vector<Zone> _zones;
+	std::vector<Frame> _capturedFrames;
+	std::vector<std::int64_t> _capturedFrameStarts;
+};
+
+class ScopedTimer
+{
+public:
+	explicit ScopedTimer(const char* name)
+		:_name(name),
+		_isActive(Profiler::getInstance().isEnabled())
+	{
+		if (_isActive) _start = Profiler::Clock::now();
+	}
+
+	~ScopedTimer()
+	{
+		if (_isActive) Profiler::getInstance().recordZone(_name, _start, Profiler::Clock::now());
+	}
+
+	ScopedTimer(const ScopedTimer&) = delete;
+	ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+	const char* _name;
+	bool _isActive;
+	Profiler::Clock::time_point _start;
+};
+
+#endif //PROFILER_HPP
\ No newline at end of file
@@ -0,0 +1,163 @@
+#ifndef RESOURCE_LOADER_HPP
+#define RESOURCE_LOADER_HPP
+
+#include <mutex>
+#include <deque>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Texture.hpp>
+
+#include <UpdateQueue.h>
+
+namespace ResourceLoaderConstants
+{
+	// Loading is mostly waiting on the disk; a couple of threads keep it busy
+	constexpr std::size_t DEFAULT_THREAD_COUNT = 2;
+}
+
+//--------------------------------------------------------------
+//	A resource that may still be loading. Copies share the same
+//	result. get() waits for it and rethrows what the load threw;
+//	tryGet() never waits and gives nullptr until it is ready.
+//--------------------------------------------------------------
+
+template<class T>
+class ResourceHandle
+{
+public:
+	ResourceHandle() = default;
+
+	bool isValid() const { return _future.valid(); }
+	bool isReady() const
+	{
+		return _future.valid() && _future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+	}
+
+	std::shared_ptr<T> get() const { return _future.get(); }
+	std::shared_ptr<T> tryGet() const { return isReady() ? _future.get() : nullptr; }
+
+	const std::string& getPath() const { return _path; }
+
+private:
+	friend class ResourceLoader;
+
+	ResourceHandle(std::shared_future<std::shared_ptr<T>> future, std::string path)
+		:_future(std::move(future)),
+		_path(std::move(path))
+	{
+	}
+
+	std::shared_future<std::shared_ptr<T>> _future;
+	std::string _path;
+};
+
+//--------------------------------------------------------------
+//	Reads and decodes resources on background threads so the
+//	window can open before they are in memory. Anything that
+//	needs the graphics context - uploading a texture - is
+//	finished on the UI thread through the UpdateQueue, so the
+//	handle becomes ready between frames. Jobs run in the order
+//	they were queued; queued jobs that haven't started when the
+//	loader is destroyed are dropped and their handles throw
+//	std::future_error.
+//--------------------------------------------------------------
+
+class ResourceLoader
+{
+public:
+	struct Timing
+	{
+		std::string path;
+		// Queued until a thread picked the job up
+		std::chrono::microseconds wait;
+		// Reading, decoding and, for textures, the upload
+		std::chrono::microseconds load;
+		bool isLoaded;
+	};
+
+	explicit ResourceLoader(std::size_t threadCount = ResourceLoaderConstants::DEFAULT_THREAD_COUNT);
+	~ResourceLoader();
+
+	ResourceLoader(const ResourceLoader&) = delete;
+	ResourceLoader& operator=(const ResourceLoader&) = delete;
+
+	// Goes through FontCache, so widgets acquiring the path later get this font
+	ResourceHandle<const sf::Font> loadFont(const std::string& path);
+	ResourceHandle<const sf::Texture> loadTexture(const std::string& path);
+
+	// decode runs on a loader thread
+	template<class T>
+	ResourceHandle<T> load(const std::string& path, std::function<std::shared_ptr<T>()> decode)
+	{
+		auto promise = std::make_shared<std::promise<std::shared_ptr<T>>>();
+		ResourceHandle<T> handle(promise->get_future().share(), path);
+
+		enqueue(path, [promise, decode = std::move(decode)](const Finish& finish)
+			{
+				std::shared_ptr<T> resource;
+				try
+				{
+					resource = decode();
+				}
+				catch (...)
+				{
+					promise->set_exception(std::current_exception());
+					finish(false);
+					return;
+				}
+
+				promise->set_value(std::move(resource));
+				finish(true);
+			});
+
+		return handle;
+	}
+
+	// Finished and queued jobs since construction, for progress displays
+	std::size_t getFinishedCount() const { return _finished.load(std::memory_order_acquire); }
+	std::size_t getQueuedCount() const { return _queued.load(std::memory_order_acquire); }
+	bool isIdle() const { return getFinishedCount() == getQueuedCount(); }
+	float getProgress() const;
+
+	std::vector<Timing> getTimings() const;
+
+private:
+	using Clock = std::chrono::steady_clock;
+	// Called exactly once per job when its handle is ready
+	using Finish = std::function<void(bool isLoaded)>;
+	using Job = std::function<void(const Finish& finish)>;
+
+	struct Queued
+	{
+		std::string path;
+		Job job;
+		Clock::time_point queuedAt;
+	};
+
+	void enqueue(const std::string& path, Job job);
+	void work(std::stop_token stopToken);
+	void postToUi(UpdateQueue::Command command);
+
+	mutable std::mutex _mutex;
+	std::condition_variable_any _hasJobs;
+	std::deque<Queued> _jobs;
+	std::vector<Timing> _timings;
+
+	std::atomic<std::size_t> _queued{ 0 };
+	std::atomic<std::size_t> _finished{ 0 };
+	std::atomic<bool> _isStopping{ false };
+
+	std::vector<std::jthread> _threads;
+};
+
+#endif //RESOURCE_LOADER_HPP
\ No newline at end of file
@@ -0,0 +1,95 @@
+#ifndef RESOURCE_WATCHER_HPP
+#define RESOURCE_WATCHER_HPP
+
+#include <mutex>
+#include <chrono>
+#include <stop_token>
+#include <condition_variable>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <unordered_map>
+
+#include <UpdateQueue.h>
+
+namespace ResourceWatcherConstants
+{
+	// Editors save in several steps; changes closer together than this reload once
+	constexpr std::chrono::milliseconds SETTLE_TIME{ 50 };
+	// How often file stamps are compared when the platform can't report changes
+	constexpr std::chrono::milliseconds POLL_INTERVAL{ 250 };
+	// Back-off while the update queue is full
+	constexpr std::chrono::milliseconds RETRY_INTERVAL{ 1 };
+}
+
+//--------------------------------------------------------------
+//	Reloads files while the program runs. A background thread
+//	waits for changes (inotify on Linux, comparing modification
+//	times elsewhere) and calls the file's reload there, so the
+//	slow part - parsing, decoding - stays off the UI thread.
+//	The reload returns a command that swaps the result in; it
+//	goes through the UpdateQueue and so runs between frames,
+//	never in the middle of one.
+//--------------------------------------------------------------
+
+class ResourceWatcher
+{
+public:
+	// Runs on the watcher thread; the command it returns runs on the UI thread
+	using Reload = std::function<UpdateQueue::Command()>;
+	// UI thread, for reloads that threw
+	using ErrorHandler = std::function<void(const std::string& path, const std::string& message)>;
+
+	explicit ResourceWatcher(ErrorHandler onError = {});
+	~ResourceWatcher();
+
+	ResourceWatcher(const ResourceWatcher&) = delete;
+	ResourceWatcher& operator=(const ResourceWatcher&) = delete;
+
+	// Watching a path again replaces its reload; safe while running
+	void watch(const std::string& path, Reload reload);
+	void unwatch(const std::string& path);
+
+	void start();
+	void stop();
+
+	bool isRunning() const { return _thread.joinable(); }
+	// False when changes are found by polling
+	bool isNotifying() const { return _notifier >= 0; }
+	std::size_t getWatchedCount() const;
+
+private:
+	struct Entry
+	{
+		Reload reload;
+		std::string fileName;
+		// inotify watch of the containing directory, so files replaced by a rename are seen too
+		int descriptor = -1;
+		std::filesystem::file_time_type time;
+		std::uintmax_t size = 0;
+	};
+
+	void run(std::stop_token stopToken);
+	bool waitForChanges(std::stop_token stopToken, std::vector<std::string>& candidates);
+	void reloadChanged(std::stop_token stopToken, const std::vector<std::string>& candidates);
+	void post(std::stop_token stopToken, UpdateQueue::Command command);
+
+	void readEvents(std::vector<std::string>& candidates);
+	static bool readStamp(const std::string& path, std::filesystem::file_time_type& time, std::uintmax_t& size);
+
+	ErrorHandler _onError;
+
+	mutable std::mutex _mutex;
+	std::unordered_map<std::string, Entry> _entries;
+	std::condition_variable_any _pollWait;
+
+	int _notifier = -1;
+	int _wakeUp = -1;
+
+	std::jthread _thread;
+};
+
+#endif //RESOURCE_WATCHER_HPP
\ No newline at end of file
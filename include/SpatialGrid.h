@@ -0,0 +1,62 @@
+#ifndef SPATIAL_GRID_HPP
+#define SPATIAL_GRID_HPP
+
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/System/Vector2.hpp>
+
+class Widget;
+
+//--------------------------------------------------------------
+//	Uniform grid over widget bounds. A widget is registered in
+//	every cell its bounds overlap, so a point query only looks
+//	at the handful of widgets sharing the cell under the point.
+//--------------------------------------------------------------
+
+class SpatialGrid
+{
+public:
+	explicit SpatialGrid(float cellSize = 64.f);
+
+	void insert(Widget* widget, const sf::FloatRect& bounds);
+	void update(Widget* widget, const sf::FloatRect& bounds);
+	void remove(Widget* widget);
+	void clear();
+
+	// Appends every widget whose bounds contain the point
+	void query(const sf::Vector2f& point, std::vector<Widget*>& result) const;
+
+	std::size_t size() const;
+
+private:
+	struct CellRange
+	{
+		int left;
+		int top;
+		int right;
+		int bottom;
+	};
+
+	struct Entry
+	{
+		CellRange cells;
+		sf::FloatRect bounds;
+	};
+
+	static std::int64_t cellKey(int x, int y);
+	int cellCoordinate(float value) const;
+	CellRange cellsFor(const sf::FloatRect& bounds) const;
+
+	void link(Widget* widget, const CellRange& cells);
+	void unlink(Widget* widget, const CellRange& cells);
+
+	float _cellSize;
+
+	std::unordered_map<std::int64_t, std::vector<Widget*>> _cells;
+	std::unordered_map<Widget*, Entry> _entries;
+};
+
+#endif //SPATIAL_GRID_HPP
\ No newline at end of file
@@ -0,0 +1,64 @@
+#ifndef TEXT_DOCUMENT_HPP
+#define TEXT_DOCUMENT_HPP
+
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include <SFML/Config.hpp>
+
+namespace TextDocumentConstants
+{
+	constexpr std::size_t MIN_GAP = 256;
+}
+
+//--------------------------------------------------------------
+//	Code points in a gap buffer plus an index of line starts.
+//	Edits near the previous one only move the gap, and every
+//	line carries an id that changes whenever the line does, so
+//	views can keep per-line caches and rebuild only what an
+//	edit touched.
+//--------------------------------------------------------------
+
+class TextDocument
+{
+public:
+	TextDocument();
+
+	std::size_t size() const;
+	bool empty() const;
+	sf::Uint32 at(std::size_t position) const;
+
+	std::size_t lineCount() const;
+	std::size_t lineOf(std::size_t position) const;
+	std::size_t lineStart(std::size_t line) const;
+	// End of the line, excluding its newline
+	std::size_t lineEnd(std::size_t line) const;
+	std::uint64_t lineId(std::size_t line) const;
+
+	void copy(std::size_t first, std::size_t count, std::basic_string<sf::Uint32>& out) const;
+
+	void insert(std::size_t position, const sf::Uint32* text, std::size_t count);
+	void erase(std::size_t position, std::size_t count);
+	void assign(const sf::Uint32* text, std::size_t count);
+	void clear();
+	// Room for this many code points in total, so edits up to it never reallocate
+	void reserve(std::size_t capacity);
+
+private:
+	std::size_t gapSize() const;
+	void moveGap(std::size_t position);
+	void reserveGap(std::size_t count);
+
+	std::vector<sf::Uint32> _buffer;
+	std::size_t _gapStart;
+	std::size_t _gapEnd;
+
+	std::vector<std::size_t> _lineStarts;
+	std::vector<std::uint64_t> _lineIds;
+	std::vector<std::size_t> _newLineStarts;
+	std::uint64_t _nextLineId;
+};
+
+#endif //TEXT_DOCUMENT_HPP
\ No newline at end of file
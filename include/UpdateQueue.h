@@ -0,0 +1,78 @@
+#ifndef UPDATE_QUEUE_HPP
+#define UPDATE_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <memory>
+#include <vector>
+
+namespace UpdateQueueConstants
+{
+	// Power of two; posts fail instead of blocking once this many are waiting
+	constexpr std::size_t CAPACITY = 4096;
+	constexpr std::size_t CACHE_LINE = 64;
+}
+
+//--------------------------------------------------------------
+//	Lock-free queue carrying widget updates from worker threads
+//	to the UI thread. Any thread may post; the UI thread drains
+//	once per frame and runs the commands in post order. Updates
+//	still queued for a widget that is destroyed, on whichever
+//	thread, are discarded, so a late command never touches
+//	freed memory.
+//--------------------------------------------------------------
+
+class UpdateQueue
+{
+public:
+	using Command = std::function<void()>;
+
+	static UpdateQueue& getInstance();
+
+	// Thread-safe, returns false when the queue is full
+	bool post(const void* owner, Command command);
+
+	// UI thread only
+	std::size_t drain();
+
+	// Thread-safe, so a widget may be destroyed on any thread. Drops the owner's commands that have not
+	// started yet; one already running on the UI thread is not waited for
+	void discard(const void* owner);
+
+	bool isEmpty() const;
+	std::size_t getPendingCount() const;
+
+	UpdateQueue(const UpdateQueue&) = delete;
+	UpdateQueue& operator=(const UpdateQueue&) = delete;
+
+private:
+	UpdateQueue();
+
+	struct Cell
+	{
+		std::atomic<std::size_t> sequence{ 0 };
+		const void* owner = nullptr;
+		Command command;
+	};
+
+	struct Discarded
+	{
+		const void* owner;
+		std::size_t before;
+	};
+
+	bool isDiscarded(const void* owner, std::size_t position);
+
+	std::unique_ptr<Cell[]> _cells;
+
+	std::mutex _discardedMutex;
+	std::vector<Discarded> _discarded;
+
+	// Producers and the consumer each own a cache line
+	alignas(UpdateQueueConstants::CACHE_LINE) std::atomic<std::size_t> _enqueuePosition{ 0 };
+	alignas(UpdateQueueConstants::CACHE_LINE) std::atomic<std::size_t> _dequeuePosition{ 0 };
+};
+
+#endif //UPDATE_QUEUE_HPP
\ No newline at end of file
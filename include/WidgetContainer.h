@@ -0,0 +1,121 @@
+#ifndef WIDGET_CONTAINER_HPP
+#define WIDGET_CONTAINER_HPP
+
+#include <memory>
+#include <cstdint>
+#include <vector>
+#include <typeindex>
+#include <unordered_map>
+
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Window/Event.hpp>
+
+#include <Graphics/InterfaceElements/Widget.h>
+#include <SpatialGrid.h>
+#include <WidgetPool.h>
+
+//--------------------------------------------------------------
+//	Non-owning set of widgets in draw order. Mouse events are
+//	routed through a spatial grid to the widgets under the
+//	cursor, keyboard and text events go to the focused widget.
+//	Widgets created through create<T>() live in per-type pools
+//	owned by the container and are destroyed by destroy/clear.
+//--------------------------------------------------------------
+
+class WidgetContainer : public WidgetObserver
+{
+public:
+	explicit WidgetContainer(float cellSize = 64.f);
+	~WidgetContainer();
+
+	WidgetContainer(const WidgetContainer&) = delete;
+	WidgetContainer& operator=(const WidgetContainer&) = delete;
+
+	void add(Widget& widget);
+	void remove(Widget& widget);
+	void clear();
+
+	template<class T>
+	WidgetPool<T>& pool()
+	{
+		std::unique_ptr<WidgetPoolBase>& entry = _pools[std::type_index(typeid(T))];
+		if (!entry) entry = std::make_unique<WidgetPool<T>>();
+
+		return static_cast<WidgetPool<T>&>(*entry);
+	}
+
+	template<class T, class... Args>
+	WidgetHandle<T> create(Args&&... args)
+	{
+		WidgetPool<T>& widgets = pool<T>();
+		WidgetHandle<T> handle = widgets.create(std::forward<Args>(args)...);
+
+		add(*widgets.get(handle));
+		return handle;
+	}
+
+	template<class T>
+	void destroy(WidgetHandle<T> handle)
+	{
+		WidgetPool<T>& widgets = pool<T>();
+
+		T* widget = widgets.get(handle);
+		if (!widget) return;
+
+		remove(*widget);
+		widgets.destroy(handle);
+	}
+
+	template<class T>
+	T* get(WidgetHandle<T> handle)
+	{
+		return pool<T>().get(handle);
+	}
+
+	void dispatch(const sf::RenderTarget& target, const sf::Event& event);
+
+	void setFocus(Widget* widget);
+	Widget* getFocus() const;
+
+	// Widgets under the point, topmost last
+	void widgetsAt(const sf::Vector2f& point, std::vector<Widget*>& result);
+
+	const std::vector<Widget*>& getWidgets() const;
+
+	// Also told about every bounds change, e.g. a group caching the union of its children
+	void setBoundsListener(WidgetObserver* listener);
+	void onBoundsChanged(Widget& widget) override;
+
+private:
+	void refreshIndex();
+	void deliver(Widget* widget, const sf::RenderTarget& target, const sf::Event& event);
+	void broadcast(const sf::RenderTarget& target, const sf::Event& event);
+	bool wasDelivered(const Widget* widget) const;
+
+	struct Entry
+	{
+		// Insertion order; never renumbered, so removing a widget leaves the others alone
+		std::uint64_t sequence;
+		// Already queued in _staleWidgets for the next refreshIndex()
+		bool isStale;
+	};
+
+	std::unordered_map<std::type_index, std::unique_ptr<WidgetPoolBase>> _pools;
+
+	SpatialGrid _grid;
+
+	std::vector<Widget*> _widgets;
+	std::unordered_map<const Widget*, Entry> _order;
+	std::vector<Widget*> _staleWidgets;
+	std::uint64_t _nextSequence;
+
+	std::vector<Widget*> _hits;
+	std::vector<Widget*> _hovered;
+	std::vector<Widget*> _delivered;
+
+	Widget* _focus;
+	Widget* _capture;
+	WidgetObserver* _boundsListener;
+};
+
+#endif //WIDGET_CONTAINER_HPP
\ No newline at end of file
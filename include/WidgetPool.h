@@ -0,0 +1,189 @@
+#ifndef WIDGET_POOL_HPP
+#define WIDGET_POOL_HPP
+
+#include <new>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+template<class T>
+struct WidgetHandle
+{
+	static constexpr std::uint32_t INVALID_INDEX = 0xFFFFFFFFu;
+
+	std::uint32_t index = INVALID_INDEX;
+	std::uint32_t generation = 0;
+
+	explicit operator bool() const { return index != INVALID_INDEX; }
+	bool operator==(const WidgetHandle& other) const = default;
+};
+
+class WidgetPoolBase
+{
+public:
+	virtual ~WidgetPoolBase() = default;
+
+	virtual void clear() = 0;
+	virtual std::size_t size() const = 0;
+};
+
+//--------------------------------------------------------------
+//	Typed slot allocator. Widgets live in fixed-size chunks that
+//	never move, so pointers stay valid and iteration walks
+//	contiguous memory. Handles carry a generation and stop
+//	resolving once their slot is destroyed or reused.
+//--------------------------------------------------------------
+
+template<class T>
+class WidgetPool : public WidgetPoolBase
+{
+public:
+	static constexpr std::size_t CHUNK_SIZE = 64;
+
+	using Handle = WidgetHandle<T>;
+
+	WidgetPool() = default;
+	WidgetPool(const WidgetPool&) = delete;
+	WidgetPool& operator=(const WidgetPool&) = delete;
+
+	~WidgetPool() override
+	{
+		clear();
+	}
+
+	template<class... Args>
+	Handle create(Args&&... args)
+	{
+		const std::uint32_t index = acquireSlot();
+
+		try
+		{
+			::new (static_cast<void*>(slot(index))) T(std::forward<Args>(args)...);
+		}
+		catch (...)
+		{
+			_freeSlots.push_back(index);
+			throw;
+		}
+
+		_alive[index] = true;
+		++_size;
+
+		return { index, _generations[index] };
+	}
+
+	void destroy(Handle handle)
+	{
+		if (!isValid(handle)) return;
+
+		release(handle.index);
+	}
+
+	T* get(Handle handle)
+	{
+		return isValid(handle) ? slot(handle.index) : nullptr;
+	}
+
+	const T* get(Handle handle) const
+	{
+		return isValid(handle) ? slot(handle.index) : nullptr;
+	}
+
+	bool isValid(Handle handle) const
+	{
+		return handle.index < _alive.size() &&
+			_alive[handle.index] &&
+			_generations[handle.index] == handle.generation;
+	}
+
+	template<class Function>
+	void forEach(Function&& function)
+	{
+		for (std::size_t i = 0; i < _alive.size(); ++i)
+		{
+			if (_alive[i]) function(*slot(static_cast<std::uint32_t>(i)));
+		}
+	}
+
+	void reserve(std::size_t count)
+	{
+		while (_chunks.size() * CHUNK_SIZE < count)
+		{
+			_chunks.emplace_back(new Chunk);
+		}
+	}
+
+	// Destroys every widget but keeps the chunks for the next screen
+	void clear() override
+	{
+		for (std::size_t i = 0; i < _alive.size(); ++i)
+		{
+			if (_alive[i]) release(static_cast<std::uint32_t>(i));
+		}
+	}
+
+	std::size_t size() const override
+	{
+		return _size;
+	}
+
+	std::size_t capacity() const
+	{
+		return _chunks.size() * CHUNK_SIZE;
+	}
+
+private:
+	struct Slot
+	{
+		alignas(T) std::byte bytes[sizeof(T)];
+	};
+
+	struct Chunk
+	{
+		Slot slots[CHUNK_SIZE];
+	};
+
+	T* slot(std::uint32_t index) const
+	{
+		Slot& storage = _chunks[index / CHUNK_SIZE]->slots[index % CHUNK_SIZE];
+		return std::launder(reinterpret_cast<T*>(storage.bytes));
+	}
+
+	std::uint32_t acquireSlot()
+	{
+		if (!_freeSlots.empty())
+		{
+			const std::uint32_t index = _freeSlots.back();
+			_freeSlots.pop_back();
+			return index;
+		}
+
+		const std::uint32_t index = static_cast<std::uint32_t>(_alive.size());
+		reserve(static_cast<std::size_t>(index) + 1);
+
+		_alive.push_back(false);
+		_generations.push_back(0);
+
+		return index;
+	}
+
+	void release(std::uint32_t index)
+	{
+		slot(index)->~T();
+
+		_alive[index] = false;
+		++_generations[index];
+		_freeSlots.push_back(index);
+		--_size;
+	}
+
+	std::vector<std::unique_ptr<Chunk>> _chunks;
+	std::vector<bool> _alive;
+	std::vector<std::uint32_t> _generations;
+	std::vector<std::uint32_t> _freeSlots;
+	std::size_t _size = 0;
+};
+
+#endif //WIDGET_POOL_HPP
\ No newline at end of file
@@ -0,0 +1,121 @@
+#include <AnchorLayout.h>
+
+#include <JobSystem.h>
+#include <Profiler.h>
+
+std::size_t AnchorLayout::add(AnchorHorizontal horizAnchor,
+	AnchorVertical vertAnchor,
+	const sf::Vector2f& offset,
+	const sf::Vector2f& size,
+	AnchoredElement::UpdateCallback const& callback)
+{
+	_elements.emplace_back(horizAnchor, vertAnchor, offset, size, callback);
+	_isDirty = true;
+	++_edits;
+
+	return _elements.size() - 1;
+}
+
+void AnchorLayout::setWindowSize(const sf::Vector2u& windowSize)
+{
+	if (windowSize == _windowSize) return;
+
+	_windowSize = windowSize;
+	_isDirty = true;
+}
+
+void AnchorLayout::invalidate()
+{
+	for (auto& element : _elements)
+	{
+		element.invalidate();
+	}
+
+	_isDirty = true;
+	++_edits;
+}
+
+void AnchorLayout::invalidate(std::size_t index)
+{
+	_elements.at(index).invalidate();
+	_isDirty = true;
+	++_edits;
+}
+
+std::size_t AnchorLayout::apply()
+{
+	if (!_isDirty) return 0;
+
+	const ScopedTimer timer("AnchorLayout::apply");
+	_results.resize(_elements.size());
+
+	JobSystem::getInstance().parallelFor(_elements.size(), AnchorLayoutConstants::PARALLEL_CHUNK,
+		[this](std::size_t first, std::size_t last)
+		{
+			for (std::size_t i = first; i < last; ++i)
+			{
+				Result& result = _results[i];
+				result.isComputed = _elements[i].needsUpdate(_windowSize);
+
+				if (result.isComputed)
+				{
+					_elements[i].compute(_windowSize, result.position, result.size);
+				}
+			}
+		});
+
+	// Cleared before the callbacks: one that invalidates the layout gets it run again on the next apply()
+	_isDirty = false;
+
+	// Callbacks move widgets, so they stay on this thread and in order
+	const std::size_t edits = _edits;
+	std::size_t updated = 0;
+
+	for (std::size_t i = 0; i < _elements.size(); ++i)
+	{
+		AnchoredElement& element = _elements[i];
+		if (!element.needsUpdate(_windowSize)) continue;
+
+		// A callback edited the layout, so what was computed up front may be out of date
+		if (_edits != edits || !_results[i].isComputed)
+		{
+			Result recomputed{};
+			element.compute(_windowSize, recomputed.position, recomputed.size);
+			element.commit(_windowSize, recomputed.position, recomputed.size);
+		}
+		else
+		{
+			element.commit(_windowSize, _results[i].position, _results[i].size);
+		}
+
+		++updated;
+	}
+
+	return updated;
+}
+
+void AnchorLayout::setOffset(std::size_t index, const sf::Vector2f& offset)
+{
+	_elements.at(index).setOffset(offset);
+	_isDirty = true;
+	++_edits;
+}
+
+void AnchorLayout::setSize(std::size_t index, const sf::Vector2f& size)
+{
+	_elements.at(index).setSize(size);
+	_isDirty = true;
+	++_edits;
+}
+
+std::size_t AnchorLayout::size() const
+{
+	return _elements.size();
+}
+
+void AnchorLayout::clear()
+{
+	_elements.clear();
+	_isDirty = true;
+	++_edits;
+}
\ No newline at end of file
@@ -0,0 +1,204 @@
+#include <AnchorLayoutBatch.h>
+
+#include <limits>
+#include <algorithm>
+
+#include <JobSystem.h>
+#include <Profiler.h>
+
+namespace
+{
+	struct AxisCoefficients
+	{
+		float anchor;
+		float pull;
+		float stretch;
+	};
+
+	AxisCoefficients coefficientsFor(AnchorHorizontal anchor)
+	{
+		switch (anchor)
+		{
+		case AnchorHorizontal::CENTER: return { 0.5f, 0.f, 0.f };
+		case AnchorHorizontal::RIGHT: return { 1.f, -1.f, 0.f };
+		case AnchorHorizontal::STRETCH: return { 0.f, 0.f, 1.f };
+		default: return { 0.f, 0.f, 0.f };
+		}
+	}
+
+	AxisCoefficients coefficientsFor(AnchorVertical anchor)
+	{
+		switch (anchor)
+		{
+		case AnchorVertical::CENTER: return { 0.5f, 0.f, 0.f };
+		case AnchorVertical::BOTTOM: return { 1.f, -1.f, 0.f };
+		case AnchorVertical::STRETCH: return { 0.f, 0.f, 1.f };
+		default: return { 0.f, 0.f, 0.f };
+		}
+	}
+}
+
+void AnchorLayoutBatch::Axis::push(float offsetValue, float sizeValue, float anchorValue, float pullValue, float stretchValue)
+{
+	offset.push_back(offsetValue);
+	size.push_back(sizeValue);
+	anchor.push_back(anchorValue);
+	pull.push_back(pullValue);
+	stretch.push_back(stretchValue);
+
+	outPosition.push_back(0.f);
+	outSize.push_back(0.f);
+	appliedPosition.push_back(std::numeric_limits<float>::quiet_NaN());
+	appliedSize.push_back(std::numeric_limits<float>::quiet_NaN());
+}
+
+void AnchorLayoutBatch::Axis::reserve(std::size_t count)
+{
+	for (auto* values : { &offset, &size, &anchor, &pull, &stretch,
+		&outPosition, &outSize, &appliedPosition, &appliedSize })
+	{
+		values->reserve(count);
+	}
+}
+
+void AnchorLayoutBatch::Axis::clear()
+{
+	for (auto* values : { &offset, &size, &anchor, &pull, &stretch,
+		&outPosition, &outSize, &appliedPosition, &appliedSize })
+	{
+		values->clear();
+	}
+}
+
+void AnchorLayoutBatch::Axis::compute(float window, std::size_t first, std::size_t last)
+{
+	const float* offsets = offset.data();
+	const float* sizes = size.data();
+	const float* anchors = anchor.data();
+	const float* pulls = pull.data();
+	const float* stretches = stretch.data();
+
+	float* positions = outPosition.data();
+	float* resultSizes = outSize.data();
+
+	for (std::size_t i = first; i < last; ++i)
+	{
+		positions[i] = offsets[i] + anchors[i] * window + pulls[i] * sizes[i];
+		resultSizes[i] = sizes[i] + stretches[i] * (window - 2.f * offsets[i] - sizes[i]);
+	}
+}
+
+std::size_t AnchorLayoutBatch::add(Widget& widget,
+	AnchorHorizontal horizAnchor,
+	AnchorVertical vertAnchor,
+	const sf::Vector2f& offset,
+	const sf::Vector2f& size)
+{
+	const AxisCoefficients horizontal = coefficientsFor(horizAnchor);
+	const AxisCoefficients vertical = coefficientsFor(vertAnchor);
+
+	_x.push(offset.x, size.x, horizontal.anchor, horizontal.pull, horizontal.stretch);
+	_y.push(offset.y, size.y, vertical.anchor, vertical.pull, vertical.stretch);
+	_widgets.push_back(&widget);
+
+	_isDirty = true;
+	return _widgets.size() - 1;
+}
+
+void AnchorLayoutBatch::reserve(std::size_t count)
+{
+	_x.reserve(count);
+	_y.reserve(count);
+	_widgets.reserve(count);
+}
+
+void AnchorLayoutBatch::clear()
+{
+	_x.clear();
+	_y.clear();
+	_widgets.clear();
+	_isDirty = true;
+}
+
+void AnchorLayoutBatch::setWindowSize(const sf::Vector2u& windowSize)
+{
+	if (windowSize == _windowSize) return;
+
+	_windowSize = windowSize;
+	_isDirty = true;
+}
+
+void AnchorLayoutBatch::invalidate()
+{
+	_isDirty = true;
+}
+
+std::size_t AnchorLayoutBatch::apply()
+{
+	if (!_isDirty) return 0;
+
+	const ScopedTimer timer("AnchorLayoutBatch::apply");
+
+	JobSystem::getInstance().parallelFor(_widgets.size(), AnchorLayoutBatchConstants::PARALLEL_CHUNK,
+		[this](std::size_t first, std::size_t last)
+		{
+			compute(first, last);
+		});
+	_isDirty = false;
+
+	const std::size_t updated = writeBack();
+	Profiler::getInstance().increment(ProfilerCounter::AnchorUpdates, static_cast<std::uint32_t>(updated));
+
+	return updated;
+}
+
+void AnchorLayoutBatch::compute(std::size_t first, std::size_t last)
+{
+	last = std::min(last, _widgets.size());
+	if (first >= last) return;
+
+	_x.compute(static_cast<float>(_windowSize.x), first, last);
+	_y.compute(static_cast<float>(_windowSize.y), first, last);
+}
+
+std::size_t AnchorLayoutBatch::writeBack()
+{
+	std::size_t updated = 0;
+
+	for (std::size_t i = 0; i < _widgets.size(); ++i)
+	{
+		const bool moved = _x.outPosition[i] != _x.appliedPosition[i] ||
+			_y.outPosition[i] != _y.appliedPosition[i];
+		const bool resized = _x.outSize[i] != _x.appliedSize[i] ||
+			_y.outSize[i] != _y.appliedSize[i];
+
+		if (!moved && !resized) continue;
+
+		_widgets[i]->setPosition({ _x.outPosition[i], _y.outPosition[i] });
+		_widgets[i]->setSize({ _x.outSize[i], _y.outSize[i] });
+
+		_x.appliedPosition[i] = _x.outPosition[i];
+		_y.appliedPosition[i] = _y.outPosition[i];
+		_x.appliedSize[i] = _x.outSize[i];
+		_y.appliedSize[i] = _y.outSize[i];
+
+		++updated;
+	}
+
+	return updated;
+}
+
+sf::Vector2f AnchorLayoutBatch::getPosition(std::size_t index) const
+{
+	return { _x.outPosition.at(index), _y.outPosition.at(index) };
+}
+
+sf::Vector2f AnchorLayoutBatch::getSize(std::size_t index) const
+{
+	return { _x.outSize.at(index), _y.outSize.at(index) };
+}
+
+std::size_t AnchorLayoutBatch::size() const
+{
+	return _widgets.size();
+}
\ No newline at end of file
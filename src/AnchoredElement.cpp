@@ -1,5 +1,7 @@
 #include "AnchoredElement.h"
 
+#include "Profiler.h"
+
 AnchoredElement::AnchoredElement(AnchorHorizontal horizAnchor,
     AnchorVertical vertAnchor,
     const sf::Vector2f& offset,
@@ -12,11 +14,30 @@ AnchoredElement::AnchoredElement(AnchorHorizontal horizAnchor,
     _callback(callback) {
 }
 
-void AnchoredElement::update(const sf::Vector2u& windowSize)
+bool AnchoredElement::update(const sf::Vector2u& windowSize)
 {
+    if (!needsUpdate(windowSize))
+    {
+        return false;
+    }
+
+    const ScopedTimer timer("AnchoredElement::update");
+
     sf::Vector2f newPosition;
     sf::Vector2f newSize;
+    compute(windowSize, newPosition, newSize);
+    commit(windowSize, newPosition, newSize);
+
+    return true;
+}
+
+bool AnchoredElement::needsUpdate(const sf::Vector2u& windowSize) const
+{
+    return _isDirty || windowSize != _lastWindowSize;
+}
 
+void AnchoredElement::compute(const sf::Vector2u& windowSize, sf::Vector2f& newPosition, sf::Vector2f& newSize) const
+{
     switch (_horizAnchor) 
     {
     case AnchorHorizontal::LEFT:
@@ -56,6 +77,31 @@ void AnchoredElement::update(const sf::Vector2u& windowSize)
         newSize.y = windowSize.y - _offset.y * 2;
         break;
     }
+}
 
-    _callback(newPosition, newSize);
+void AnchoredElement::commit(const sf::Vector2u& windowSize, const sf::Vector2f& position, const sf::Vector2f& size)
+{
+    Profiler::getInstance().increment(ProfilerCounter::AnchorUpdates);
+
+    _lastWindowSize = windowSize;
+    _isDirty = false;
+
+    _callback(position, size);
+}
+
+void AnchoredElement::invalidate()
+{
+    _isDirty = true;
 }
+
+void AnchoredElement::setOffset(const sf::Vector2f& offset)
+{
+    _offset = offset;
+    _isDirty = true;
+}
+
+void AnchoredElement::setSize(const sf::Vector2f& size)
+{
+    _size = size;
+    _isDirty = true;
+}
\ No newline at end of file
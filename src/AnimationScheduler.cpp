@@ -0,0 +1,294 @@
+#include <AnimationScheduler.h>
+
+#include <algorithm>
+#include <cmath>
+
+#include <JobSystem.h>
+#include <Profiler.h>
+
+float ease(Easing easing, float t)
+{
+	t = std::clamp(t, 0.f, 1.f);
+
+	switch (easing)
+	{
+	case Easing::InQuad:
+		return t * t;
+	case Easing::OutQuad:
+		return t * (2.f - t);
+	case Easing::InOutQuad:
+		return t < 0.5f ? 2.f * t * t : 1.f - 2.f * (1.f - t) * (1.f - t);
+	case Easing::OutCubic:
+	{
+		const float inverse = 1.f - t;
+		return 1.f - inverse * inverse * inverse;
+	}
+	case Easing::InOutCubic:
+	{
+		const float inverse = 1.f - t;
+		return t < 0.5f ? 4.f * t * t * t : 1.f - 4.f * inverse * inverse * inverse;
+	}
+	default:
+		return t;
+	}
+}
+
+AnimationScheduler& AnimationScheduler::getInstance()
+{
+	static AnimationScheduler instance;
+	return instance;
+}
+
+void AnimationScheduler::tween(const void* owner, Channel channel, float from, float to,
+	float duration, Easing easing, std::function<void(float)> apply, float delay)
+{
+	start({ owner, channel, 1, { from }, { to }, 0.f, duration, delay, easing, std::move(apply), true });
+}
+
+void AnimationScheduler::tween(const void* owner, Channel channel, const sf::Vector2f& from, const sf::Vector2f& to,
+	float duration, Easing easing, std::function<void(const sf::Vector2f&)> apply, float delay)
+{
+	start({ owner, channel, 2, { from.x, from.y }, { to.x, to.y }, 0.f, duration, delay, easing, std::move(apply), true });
+}
+
+void AnimationScheduler::tween(const void* owner, Channel channel, const sf::Color& from, const sf::Color& to,
+	float duration, Easing easing, std::function<void(const sf::Color&)> apply, float delay)
+{
+	start({ owner, channel, 4,
+		{ static_cast<float>(from.r), static_cast<float>(from.g), static_cast<float>(from.b), static_cast<float>(from.a) },
+		{ static_cast<float>(to.r), static_cast<float>(to.g), static_cast<float>(to.b), static_cast<float>(to.a) },
+		0.f, duration, delay, easing, std::move(apply), true });
+}
+
+void AnimationScheduler::cancel(const void* owner)
+{
+	auto found = _slots.find(owner);
+	if (found == _slots.end()) return;
+
+	std::vector<Slot>& slots = found->second;
+
+	while (!slots.empty())
+	{
+		kill(slots, slots.size() - 1);
+	}
+}
+
+void AnimationScheduler::cancel(const void* owner, Channel channel)
+{
+	auto found = _slots.find(owner);
+	if (found == _slots.end()) return;
+
+	std::vector<Slot>& slots = found->second;
+	const std::size_t position = find(slots, channel);
+
+	if (position < slots.size()) kill(slots, position);
+}
+
+void AnimationScheduler::complete(const void* owner)
+{
+	auto found = _slots.find(owner);
+	if (found == _slots.end() || found->second.empty()) return;
+
+	const bool wasIterating = _isIterating;
+	_isIterating = true;
+
+	for (std::size_t i = 0; i < _tweens.size(); ++i)
+	{
+		Tween& tween = _tweens[i];
+		if (!tween.isAlive || tween.owner != owner) continue;
+
+		kill(tween);
+		apply(tween, tween.to);
+	}
+
+	_isIterating = wasIterating;
+	if (!_isIterating) adoptPending();
+}
+
+bool AnimationScheduler::isAnimating(const void* owner) const
+{
+	auto found = _slots.find(owner);
+	return found != _slots.end() && !found->second.empty();
+}
+
+bool AnimationScheduler::tick()
+{
+	return tick(_clock.restart().asSeconds());
+}
+
+bool AnimationScheduler::tick(float deltaTime)
+{
+	if (_aliveCount == 0)
+	{
+		removeFinished();
+		return false;
+	}
+
+	const ScopedTimer timer("AnimationScheduler::tick");
+	Profiler::getInstance().increment(ProfilerCounter::Animations, static_cast<std::uint32_t>(_tweens.size()));
+
+	_isIterating = true;
+
+	JobSystem::getInstance().parallelFor(_tweens.size(), AnimationSchedulerConstants::PARALLEL_CHUNK,
+		[this, deltaTime](std::size_t first, std::size_t last)
+		{
+			for (std::size_t i = first; i < last; ++i)
+			{
+				advance(_tweens[i], deltaTime);
+			}
+		});
+
+	// Callbacks may start or cancel tweens; new ones wait in _pending until the pass is over
+	for (std::size_t i = 0; i < _tweens.size(); ++i)
+	{
+		Tween& tween = _tweens[i];
+		if (!tween.isAlive || !tween.isDue) continue;
+
+		if (tween.isFinishing) kill(tween);
+
+		apply(tween, tween.value);
+	}
+
+	_isIterating = false;
+	removeFinished();
+
+	return !_tweens.empty();
+}
+
+bool AnimationScheduler::isIdle() const
+{
+	return _aliveCount == 0;
+}
+
+std::size_t AnimationScheduler::getActiveCount() const
+{
+	return _aliveCount;
+}
+
+void AnimationScheduler::advance(Tween& tween, float deltaTime)
+{
+	tween.isDue = false;
+	if (!tween.isAlive) return;
+
+	tween.elapsed += deltaTime;
+
+	const float time = tween.elapsed - tween.delay;
+	if (time < 0.f) return;
+
+	const float progress = tween.duration > 0.f ? std::min(time / tween.duration, 1.f) : 1.f;
+	const float factor = ease(tween.easing, progress);
+
+	for (std::size_t c = 0; c < tween.components; ++c)
+	{
+		tween.value[c] = tween.from[c] + (tween.to[c] - tween.from[c]) * factor;
+	}
+
+	tween.isFinishing = progress >= 1.f;
+	tween.isDue = true;
+}
+
+void AnimationScheduler::apply(Tween& tween, const float* value)
+{
+	auto channelOf = [](float component)
+		{
+			return static_cast<sf::Uint8>(std::clamp(std::lround(component), 0L, 255L));
+		};
+
+	switch (tween.apply.index())
+	{
+	case 0:
+		std::get<0>(tween.apply)(value[0]);
+		break;
+	case 1:
+		std::get<1>(tween.apply)({ value[0], value[1] });
+		break;
+	default:
+		std::get<2>(tween.apply)(sf::Color(channelOf(value[0]), channelOf(value[1]), channelOf(value[2]), channelOf(value[3])));
+		break;
+	}
+}
+
+void AnimationScheduler::start(Tween&& tween)
+{
+	// Time spent idle must not count towards the first frame of a new tween
+	if (_aliveCount == 0 && !_isIterating) _clock.restart();
+
+	// Callbacks run while the list is walked, so what they start waits in _pending
+	std::vector<Tween>& tweens = _isIterating ? _pending : _tweens;
+	const Slot slot{ tween.channel, tweens.size(), _isIterating };
+
+	std::vector<Slot>& slots = _slots[tween.owner];
+	const std::size_t position = find(slots, tween.channel);
+
+	if (position < slots.size())
+	{
+		at(slots[position]).isAlive = false;
+		slots[position] = slot;
+	}
+	else
+	{
+		slots.push_back(slot);
+		++_aliveCount;
+	}
+
+	tweens.push_back(std::move(tween));
+}
+
+AnimationScheduler::Tween& AnimationScheduler::at(const Slot& slot)
+{
+	return slot.isPending ? _pending[slot.index] : _tweens[slot.index];
+}
+
+std::size_t AnimationScheduler::find(const std::vector<Slot>& slots, Channel channel)
+{
+	std::size_t position = 0;
+	while (position < slots.size() && slots[position].channel != channel) ++position;
+
+	return position;
+}
+
+void AnimationScheduler::kill(std::vector<Slot>& slots, std::size_t position)
+{
+	at(slots[position]).isAlive = false;
+
+	slots[position] = slots.back();
+	slots.pop_back();
+	--_aliveCount;
+}
+
+void AnimationScheduler::kill(const Tween& tween)
+{
+	std::vector<Slot>& slots = _slots.at(tween.owner);
+	kill(slots, find(slots, tween.channel));
+}
+
+AnimationScheduler::Slot& AnimationScheduler::slotOf(const Tween& tween)
+{
+	std::vector<Slot>& slots = _slots.at(tween.owner);
+	return slots[find(slots, tween.channel)];
+}
+
+void AnimationScheduler::adoptPending()
+{
+	for (Tween& tween : _pending)
+	{
+		if (!tween.isAlive) continue;
+
+		slotOf(tween) = { tween.channel, _tweens.size(), false };
+		_tweens.push_back(std::move(tween));
+	}
+	_pending.clear();
+}
+
+void AnimationScheduler::removeFinished()
+{
+	std::erase_if(_tweens, [](const Tween& tween) { return !tween.isAlive; });
+
+	// Survivors moved down, so their slots are pointed at the new positions
+	for (std::size_t i = 0; i < _tweens.size(); ++i)
+	{
+		slotOf(_tweens[i]).index = i;
+	}
+
+	adoptPending();
+}
\ No newline at end of file
@@ -0,0 +1,267 @@
+#include <Graphics/Rendering/BatchRenderer.h>
+#include <Graphics/Rendering/TextureAtlas.h>
+
+#include <algorithm>
+
+#include <SFML/Graphics/Font.hpp>
+
+#include <Exceptions.h>
+#include <Profiler.h>
+
+namespace
+{
+	void appendQuad(sf::VertexArray& vertices,
+		const sf::Vertex& topLeft, const sf::Vertex& topRight,
+		const sf::Vertex& bottomRight, const sf::Vertex& bottomLeft)
+	{
+		vertices.append(topLeft);
+		vertices.append(topRight);
+		vertices.append(bottomLeft);
+		vertices.append(bottomLeft);
+		vertices.append(topRight);
+		vertices.append(bottomRight);
+	}
+
+	void appendRect(sf::VertexArray& vertices, float left, float top, float right, float bottom,
+		const sf::Color& color, const sf::Transform& transform)
+	{
+		appendQuad(vertices,
+			sf::Vertex(transform.transformPoint(left, top), color),
+			sf::Vertex(transform.transformPoint(right, top), color),
+			sf::Vertex(transform.transformPoint(right, bottom), color),
+			sf::Vertex(transform.transformPoint(left, bottom), color));
+	}
+
+	void appendVertices(sf::VertexArray& vertices, const sf::VertexArray& source)
+	{
+		const std::size_t count = source.getVertexCount();
+		if (count == 0) return;
+
+		const std::size_t offset = vertices.getVertexCount();
+		vertices.resize(offset + count);
+		std::copy(&source[0], &source[0] + count, &vertices[offset]);
+	}
+}
+
+BatchRenderer::BatchRenderer()
+	:_target(nullptr),
+	_solid(sf::Triangles)
+{
+}
+
+void BatchRenderer::begin(sf::RenderTarget& target)
+{
+	if (_target && _target != &target)
+	{
+		flush();
+	}
+
+	_target = &target;
+}
+
+void BatchRenderer::end()
+{
+	flush();
+	_target = nullptr;
+}
+
+void BatchRenderer::flush()
+{
+	if (!_target) return;
+
+	const ScopedTimer timer("BatchRenderer::flush");
+	const Statistics before = _statistics;
+
+	if (_solid.getVertexCount() > 0)
+	{
+		_target->draw(_solid);
+		++_statistics.drawCalls;
+		_statistics.vertices += _solid.getVertexCount();
+		_solid.clear();
+	}
+
+	submit(_skins);
+	submit(_textured);
+
+	Profiler& profiler = Profiler::getInstance();
+	profiler.increment(ProfilerCounter::DrawCalls, static_cast<std::uint32_t>(_statistics.drawCalls - before.drawCalls));
+	profiler.increment(ProfilerCounter::Vertices, static_cast<std::uint32_t>(_statistics.vertices - before.vertices));
+}
+
+void BatchRenderer::addRect(const sf::FloatRect& rect, const sf::Color& color, const sf::Transform& transform)
+{
+	appendRect(_solid, rect.left, rect.top, rect.left + rect.width, rect.top + rect.height, color, transform);
+}
+
+void BatchRenderer::addQuad(const sf::Vertex& topLeft, const sf::Vertex& topRight,
+	const sf::Vertex& bottomRight, const sf::Vertex& bottomLeft,
+	const sf::Texture* texture)
+{
+	appendQuad(texture ? batchFor(texture) : _solid, topLeft, topRight, bottomRight, bottomLeft);
+}
+
+void BatchRenderer::addTriangles(const sf::Vertex* vertices, std::size_t count, const sf::Transform& transform)
+{
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		_solid.append(sf::Vertex(transform.transformPoint(vertices[i].position), vertices[i].color));
+	}
+}
+
+void BatchRenderer::addShape(const sf::RectangleShape& shape)
+{
+	const sf::Transform& transform = shape.getTransform();
+	const sf::Vector2f size = shape.getSize();
+
+	if (shape.getFillColor().a > 0)
+	{
+		appendRect(_solid, 0.f, 0.f, size.x, size.y, shape.getFillColor(), transform);
+	}
+
+	const float thickness = shape.getOutlineThickness();
+	if (thickness == 0.f || shape.getOutlineColor().a == 0) return;
+
+	// The outline grows outwards for positive thickness and inwards for negative one
+	const float outer = thickness > 0.f ? thickness : 0.f;
+	const float inner = thickness > 0.f ? 0.f : -thickness;
+
+	const float left = -outer;
+	const float top = -outer;
+	const float right = size.x + outer;
+	const float bottom = size.y + outer;
+
+	const sf::Color& color = shape.getOutlineColor();
+	const float edge = outer + inner;
+
+	appendRect(_solid, left, top, right, top + edge, color, transform);
+	appendRect(_solid, left, bottom - edge, right, bottom, color, transform);
+	appendRect(_solid, left, top + edge, left + edge, bottom - edge, color, transform);
+	appendRect(_solid, right - edge, top + edge, right, bottom - edge, color, transform);
+}
+
+void BatchRenderer::addRegion(const AtlasRegion& region, const sf::FloatRect& rect, const sf::Color& color,
+	const sf::Transform& transform)
+{
+	if (!region.texture) return;
+
+	region.append(batchFor(_skins, region.texture), rect, color, transform);
+}
+
+void BatchRenderer::addText(const sf::Text& text)
+{
+	const sf::Font* font = text.getFont();
+	const sf::String& string = text.getString();
+
+	if (!font || string.isEmpty()) return;
+
+	const unsigned int characterSize = text.getCharacterSize();
+	const bool isBold = (text.getStyle() & sf::Text::Bold) != 0;
+
+	TextLayout layout;
+	layout.texture = &font->getTexture(characterSize);
+
+	// Borrow the scratch buffer so laying out an uncached sf::Text does not allocate
+	layout.vertices.swap(_glyphs);
+	layout.vertices.clear();
+	TextLayout::appendGlyphs(layout.vertices, layout.bounds, *font, string,
+		characterSize, isBold, text.getLineSpacing());
+
+	addText(layout, text.getFillColor(), text.getTransform());
+	layout.vertices.swap(_glyphs);
+}
+
+void BatchRenderer::addText(const TextLayout& layout, const sf::Color& color, const sf::Transform& transform)
+{
+	addGlyphs(layout.vertices.data(), layout.vertices.size(), layout.texture, color, transform);
+}
+
+void BatchRenderer::addGlyphs(const sf::Vertex* vertices, std::size_t count, const sf::Texture* texture,
+	const sf::Color& color, const sf::Transform& transform)
+{
+	if (!texture || count == 0) return;
+
+	sf::VertexArray& batch = batchFor(texture);
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		batch.append(sf::Vertex(transform.transformPoint(vertices[i].position), color, vertices[i].texCoords));
+	}
+}
+
+void BatchRenderer::append(BatchRenderer& recorded)
+{
+	appendVertices(_solid, recorded._solid);
+	recorded._solid.clear();
+
+	appendBatches(_skins, recorded._skins);
+	appendBatches(_textured, recorded._textured);
+}
+
+sf::RenderTarget& BatchRenderer::getTarget() const
+{
+	if (!_target)
+	{
+		throw WindowNotInitializedException("BatchRenderer::getTarget() -> ");
+	}
+
+	return *_target;
+}
+
+bool BatchRenderer::isActive() const
+{
+	return _target != nullptr;
+}
+
+const BatchRenderer::Statistics& BatchRenderer::getStatistics() const
+{
+	return _statistics;
+}
+
+void BatchRenderer::resetStatistics()
+{
+	_statistics = {};
+}
+
+sf::VertexArray& BatchRenderer::batchFor(std::vector<TextureBatch>& batches, const sf::Texture* texture)
+{
+	for (auto& batch : batches)
+	{
+		if (batch.texture == texture)
+		{
+			return batch.vertices;
+		}
+	}
+
+	batches.push_back({ texture, sf::VertexArray(sf::Triangles) });
+	return batches.back().vertices;
+}
+
+sf::VertexArray& BatchRenderer::batchFor(const sf::Texture* texture)
+{
+	return batchFor(_textured, texture);
+}
+
+void BatchRenderer::appendBatches(std::vector<TextureBatch>& batches, std::vector<TextureBatch>& recorded)
+{
+	// Whatever the recorder saw on earlier frames was appended here then, so new textures keep their first-seen order
+	for (TextureBatch& batch : recorded)
+	{
+		if (batch.vertices.getVertexCount() == 0) continue;
+
+		appendVertices(batchFor(batches, batch.texture), batch.vertices);
+		batch.vertices.clear();
+	}
+}
+
+void BatchRenderer::submit(std::vector<TextureBatch>& batches)
+{
+	for (auto& batch : batches)
+	{
+		if (batch.vertices.getVertexCount() == 0) continue;
+
+		_target->draw(batch.vertices, sf::RenderStates(batch.texture));
+		++_statistics.drawCalls;
+		_statistics.vertices += batch.vertices.getVertexCount();
+		batch.vertices.clear();
+	}
+}
\ No newline at end of file
@@ -1,85 +1,98 @@
 #include "Graphics/InterfaceElements/Button.h"
 
-Button::Button(const ButtonConfig& config)
-	:_config(config)
+#include <cmath>
+#include <algorithm>
+
+namespace
 {
-	_shape.setSize(_config.buttonSize);
-	_shape.setPosition(_config.buttonPosition);
-	_shape.setFillColor(_config.normalColor);
-	_shape.setOutlineThickness(_config.outlineThickness);
-	_shape.setOutlineColor(_config.outlineColor);
+	void setQuad(sf::Vertex* vertices, const sf::FloatRect& rect, const sf::Color& color)
+	{
+		const float right = rect.left + rect.width;
+		const float lower = rect.top + rect.height;
+
+		vertices[0] = sf::Vertex({ rect.left, rect.top }, color);
+		vertices[1] = sf::Vertex({ right, rect.top }, color);
+		vertices[2] = sf::Vertex({ rect.left, lower }, color);
+		vertices[3] = vertices[2];
+		vertices[4] = vertices[1];
+		vertices[5] = sf::Vertex({ right, lower }, color);
+	}
+}
 
-	_config.title.setPosition(
-		_config.buttonPosition.x + _config.buttonSize.x / 2 - _config.title.getGlobalBounds().width / 2,
-		_config.buttonPosition.y + _config.buttonSize.y / 2 - _config.title.getGlobalBounds().height / 2
-	);
+Button::Button(std::shared_ptr<const ButtonStyle> style, const sf::String& text,
+	const sf::Vector2f& position, const sf::Vector2f& size, std::function<void()> onClick)
+	:_style(std::move(style)),
+	_onClick(std::move(onClick)),
+	_position(position),
+	_size(size)
+{
+	assert(_style);
 
+	_title.setString(text);
+	applyStyle();
 }
 
-void Button::setPosition(const sf::Vector2f& pos)
+Button::~Button()
 {
-	assert(_shape.getSize().x > 0 && _shape.getSize().y > 0);
-	assert(!_config.title.getString().isEmpty());
-
-	auto shapeCenter = sf::Vector2f(pos) + _shape.getSize() / ButtonConstants::HALF_DIVIDER;
-	auto textSize = _config.title.getLocalBounds();
+	AnimationScheduler::getInstance().cancel(this);
+}
 
-	_config.buttonPosition = pos;
-	_shape.setPosition(_config.buttonPosition);
+void Button::setPosition(const sf::Vector2f& pos)
+{
+	assert(_size.x > 0 && _size.y > 0);
 
-	_config.title.setPosition(
-		shapeCenter.x - textSize.width * ButtonConstants::CENTER_ALIGN_FACTOR,
-		shapeCenter.y - textSize.height * ButtonConstants::CENTER_ALIGN_FACTOR
-	);
+	if (_position == pos) return;
 
+	_position = pos;
+	centerTitle();
+	invalidateBounds();
 }
 
 void Button::setEnabled(bool enabled)
 {
 	_state = enabled ? ButtonState::Normal : ButtonState::Disabled;
+	updateAppearance();
 }
 
-void Button::setSize(sf::Vector2f size)
+void Button::setSize(const sf::Vector2f& size)
 {
 	if (size.x <= 0 || size.y <= 0) return;
 
-	_shape.setSize(size);
-	_config.buttonSize = size;
-
-	sf::FloatRect textBounds = _config.title.getLocalBounds();
-	_config.title.setOrigin(textBounds.left + textBounds.width / 2,
-		textBounds.top + textBounds.height / 2);
-	_config.title.setPosition(
-		_shape.getPosition().x + size.x / 2,
-		_shape.getPosition().y + size.y / 2
-	);
+	const bool resized = _size != size;
+	_size = size;
+	centerTitle();
 
+	if (resized) invalidateBounds();
 	updateAppearance();
 }
 
-sf::Color Button::lerpColors(const sf::Color& a, const sf::Color& b, float t)
+void Button::setText(const sf::String& text)
 {
-	t = std::clamp(t, 0.0f, 1.0f); 
+	if (_title.getString() == text) return;
+
+	_title.setString(text);
+	centerTitle();
+
+	invalidateBounds();
+}
 
-	if (a == b) return a;
+void Button::setStyle(std::shared_ptr<const ButtonStyle> style)
+{
+	assert(style);
+	if (_style == style) return;
 
-	return sf::Color(
-		static_cast<sf::Uint8>(a.r + (b.r - a.r) * t),
-		static_cast<sf::Uint8>(a.g + (b.g - a.g) * t),
-		static_cast<sf::Uint8>(a.b + (b.b - a.b) * t), 
-		static_cast<sf::Uint8>(a.a + (b.a - a.a) * t)
-	);
+	_style = std::move(style);
+	applyStyle();
 }
 
-sf::Color Button::lerpOverTime(const sf::Color& from, const sf::Color& to, float speed)
+void Button::setOnClick(std::function<void()> onClick)
 {
-	float t = std::min(_animationClock.getElapsedTime().asSeconds() * speed, 1.0f);
-	return lerpColors(from, to, t);
+	_onClick = std::move(onClick);
 }
 
-sf::RectangleShape& Button::getShape()
+const ButtonStyle& Button::getStyle() const
 {
-	return _shape;
+	return *_style;
 }
 
 bool Button::isClicked()
@@ -93,22 +106,75 @@ bool Button::isClicked()
 	return false;
 }
 
-void Button::draw(sf::RenderWindow& window)
+void Button::setSkin(const AtlasRegion* skin)
 {
-	window.draw(_shape);
-	window.draw(_config.title);
+	_skin = skin;
 }
 
-void Button::handleEvent(const sf::RenderWindow& window, const sf::Event& event)
+void Button::draw(sf::RenderTarget& target)
+{
+	refreshStyle();
+
+	sf::RenderStates states(sf::Transform().translate(_position));
+
+	if (_skin)
+	{
+		_skin->draw(target, { {}, _size }, _fillColor, states.transform);
+	}
+	else
+	{
+		sf::Vertex vertices[ButtonConstants::GEOMETRY_VERTICES];
+		target.draw(vertices, buildGeometry(vertices), sf::Triangles, states);
+	}
+
+	_title.draw(target);
+}
+
+void Button::draw(BatchRenderer& renderer)
+{
+	refreshStyle();
+
+	const sf::Transform transform = sf::Transform().translate(_position);
+
+	if (_skin)
+	{
+		renderer.addRegion(*_skin, { {}, _size }, _fillColor, transform);
+	}
+	else
+	{
+		sf::Vertex vertices[ButtonConstants::GEOMETRY_VERTICES];
+		renderer.addTriangles(vertices, buildGeometry(vertices), transform);
+	}
+
+	_title.draw(renderer);
+}
+
+DrawRecording Button::prepareDraw()
+{
+	// A restyle sets the title's font, which may lay the text out
+	refreshStyle();
+	return DrawRecording::AnyThread;
+}
+
+sf::FloatRect Button::getBounds() const
+{
+	sf::FloatRect outline = getOutlineRect();
+	outline.left += _position.x;
+	outline.top += _position.y;
+
+	return uniteBounds(outline, _title.getGlobalBounds());
+}
+
+void Button::handleEvent(const sf::RenderTarget& target, const sf::Event& event)
 {
 	if (_state == ButtonState::Disabled)
 		return;
 
-	auto mousePos = sf::Mouse::getPosition(window);
-	bool contains = _shape.getGlobalBounds().contains(
-		static_cast<float>(mousePos.x),
-		static_cast<float>(mousePos.y)
-	);
+	sf::Vector2f mousePos;
+	if (!getEventPosition(target, event, mousePos))
+		return;
+
+	bool contains = sf::FloatRect(_position, _size).contains(mousePos);
 
 	if (event.type == sf::Event::MouseMoved)
 	{
@@ -133,11 +199,10 @@ void Button::handleEvent(const sf::RenderWindow& window, const sf::Event& event)
 				_state == ButtonState::Pressed &&
 				!_wasClicked)
 			{
-				if (_config.onClickAction)
-					_config.onClickAction();
+				if (_onClick)
+					_onClick();
 				_wasClicked = true;
 				_state = ButtonState::Hovered;
-				_animationClock.restart();
 			}
 		}
 		else
@@ -157,28 +222,115 @@ void Button::handleEvent(const sf::RenderWindow& window, const sf::Event& event)
 
 void Button::updateAppearance()
 {
-
-	sf::Color targetColor;
+	sf::Color targetColor = getStateColor();
+	float duration = ButtonConstants::NORMAL_FADE;
+	float delay = 0.f;
 
 	switch (_state)
 	{
 	case ButtonState::Hovered:
-		if (_hoverTimer.getElapsedTime().asMilliseconds() > 100)  
-			targetColor = _config.hoverColor;
+		duration = ButtonConstants::HOVER_FADE;
+		delay = ButtonConstants::HOVER_DELAY;
 		break;
-
 	case ButtonState::Pressed:
-		targetColor = _config.pressedColor;
-		_shape.setFillColor(lerpOverTime(_shape.getFillColor(), targetColor, 0.12f));
+		duration = ButtonConstants::PRESS_FADE;
 		break;
-
 	case ButtonState::Disabled:
-		targetColor = _config.disabledColor;
-		_shape.setFillColor(lerpOverTime(_shape.getFillColor(), targetColor, 0.1f));
+		duration = ButtonConstants::DISABLE_FADE;
+		break;
+	default:
 		break;
+	}
 
-	default: 
-		targetColor = _config.normalColor;
-		_shape.setFillColor(lerpOverTime(_shape.getFillColor(), targetColor, 0.15f));
+	// Events and the scheduler keep calling in; only a new target starts a fade
+	if (targetColor == _targetColor) return;
+	_targetColor = targetColor;
+
+	AnimationScheduler::getInstance().tween(this, 0, _fillColor, targetColor,
+		duration, Easing::OutQuad,
+		[this](const sf::Color& color)
+		{
+			_fillColor = color;
+			invalidate();
+		},
+		delay);
+}
+
+void Button::refreshStyle()
+{
+	if (_styleRevision != _style->revision) applyStyle();
+}
+
+void Button::applyStyle()
+{
+	_styleRevision = _style->revision;
+
+	if (_style->font)
+	{
+		_title.setFont(_style->font);
+	}
+	else if (_style->borrowedFont)
+	{
+		_title.setFont(*_style->borrowedFont);
 	}
+	_title.setCharacterSize(_style->characterSize);
+	_title.setFillColor(_style->textColor);
+	centerTitle();
+
+	// A restyle jumps straight to the new colour instead of fading from the old look
+	AnimationScheduler::getInstance().cancel(this);
+	_targetColor = getStateColor();
+	_fillColor = _targetColor;
+
+	// The outline thickness may have changed with the style
+	invalidateBounds();
+}
+
+void Button::centerTitle()
+{
+	const sf::FloatRect textBounds = _title.getLocalBounds();
+
+	_title.setOrigin(textBounds.left + textBounds.width * ButtonConstants::CENTER_ALIGN_FACTOR,
+		textBounds.top + textBounds.height * ButtonConstants::CENTER_ALIGN_FACTOR);
+	_title.setPosition(_position + _size / ButtonConstants::HALF_DIVIDER);
 }
+
+std::size_t Button::buildGeometry(sf::Vertex* vertices) const
+{
+	const sf::FloatRect outer = getOutlineRect();
+	const float thickness = std::abs(_style->outlineThickness);
+
+	setQuad(vertices, { {}, _size }, _fillColor);
+	if (thickness == 0.f) return ButtonConstants::QUAD_VERTICES;
+
+	// Like sf::Shape: a positive thickness grows outwards, a negative one inwards over the fill
+	const float right = outer.left + outer.width - thickness;
+	const float lower = outer.top + outer.height - thickness;
+	const float sideHeight = outer.height - thickness * 2.f;
+	const sf::Color& color = _style->outlineColor;
+
+	sf::Vertex* side = vertices + ButtonConstants::QUAD_VERTICES;
+	setQuad(side, { outer.left, outer.top, outer.width, thickness }, color);
+	setQuad(side + ButtonConstants::QUAD_VERTICES, { outer.left, lower, outer.width, thickness }, color);
+	setQuad(side + ButtonConstants::QUAD_VERTICES * 2, { outer.left, outer.top + thickness, thickness, sideHeight }, color);
+	setQuad(side + ButtonConstants::QUAD_VERTICES * 3, { right, outer.top + thickness, thickness, sideHeight }, color);
+
+	return ButtonConstants::GEOMETRY_VERTICES;
+}
+
+sf::FloatRect Button::getOutlineRect() const
+{
+	const float grow = std::max(_style->outlineThickness, 0.f);
+	return { -grow, -grow, _size.x + grow * 2.f, _size.y + grow * 2.f };
+}
+
+sf::Color Button::getStateColor() const
+{
+	switch (_state)
+	{
+	case ButtonState::Hovered: return _style->hoverColor;
+	case ButtonState::Pressed: return _style->pressedColor;
+	case ButtonState::Disabled: return _style->disabledColor;
+	default: return _style->normalColor;
+	}
+}
\ No newline at end of file
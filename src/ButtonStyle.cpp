@@ -0,0 +1,70 @@
+#include <Graphics/InterfaceElements/ButtonStyle.h>
+
+#include <algorithm>
+
+bool ButtonStyle::hasSameLook(const ButtonStyle& other) const
+{
+	return font == other.font
+		&& borrowedFont == other.borrowedFont
+		&& characterSize == other.characterSize
+		&& textColor == other.textColor
+		&& outlineColor == other.outlineColor
+		&& normalColor == other.normalColor
+		&& hoverColor == other.hoverColor
+		&& pressedColor == other.pressedColor
+		&& disabledColor == other.disabledColor
+		&& outlineThickness == other.outlineThickness;
+}
+
+ButtonTheme& ButtonTheme::getInstance()
+{
+	static ButtonTheme instance;
+	return instance;
+}
+
+std::shared_ptr<const ButtonStyle> ButtonTheme::intern(const ButtonStyle& style)
+{
+	std::erase_if(_interned, [](const std::shared_ptr<ButtonStyle>& entry) { return entry.use_count() == 1; });
+
+	auto found = std::find_if(_interned.begin(), _interned.end(),
+		[&style](const std::shared_ptr<ButtonStyle>& entry) { return entry->hasSameLook(style); });
+
+	if (found != _interned.end()) return *found;
+
+	auto entry = std::make_shared<ButtonStyle>(style);
+	entry->revision = 0;
+	_interned.push_back(entry);
+
+	return entry;
+}
+
+std::shared_ptr<const ButtonStyle> ButtonTheme::find(const std::string& name) const
+{
+	auto found = _named.find(name);
+	return found != _named.end() ? found->second : nullptr;
+}
+
+std::shared_ptr<const ButtonStyle> ButtonTheme::set(const std::string& name, const ButtonStyle& style)
+{
+	std::shared_ptr<ButtonStyle>& entry = _named[name];
+
+	if (!entry)
+	{
+		entry = std::make_shared<ButtonStyle>(style);
+		entry->revision = 0;
+		return entry;
+	}
+
+	if (entry->hasSameLook(style)) return entry;
+
+	const std::uint32_t revision = entry->revision + 1;
+	*entry = style;
+	entry->revision = revision;
+
+	return entry;
+}
+
+std::size_t ButtonTheme::size() const
+{
+	return _interned.size() + _named.size();
+}
\ No newline at end of file
@@ -0,0 +1,133 @@
+#include <Graphics/Rendering/CachedText.h>
+
+CachedText::CachedText()
+	:_font(nullptr),
+	_characterSize(30),
+	_isBold(false),
+	_fillColor(sf::Color::White),
+	_isColorDirty(true)
+{
+}
+
+void CachedText::setFont(std::shared_ptr<const sf::Font> font)
+{
+	if (_sharedFont == font && _font == font.get()) return;
+
+	_font = font.get();
+	_sharedFont = std::move(font);
+	refreshLayout();
+}
+
+void CachedText::setFont(const sf::Font& font)
+{
+	if (!_sharedFont && _font == &font) return;
+
+	_sharedFont.reset();
+	_font = &font;
+	refreshLayout();
+}
+
+void CachedText::setString(const sf::String& string)
+{
+	if (_string == string) return;
+
+	_string = string;
+	refreshLayout();
+}
+
+void CachedText::setCharacterSize(unsigned int characterSize)
+{
+	if (_characterSize == characterSize) return;
+
+	_characterSize = characterSize;
+	refreshLayout();
+}
+
+void CachedText::setBold(bool isBold)
+{
+	if (_isBold == isBold) return;
+
+	_isBold = isBold;
+	refreshLayout();
+}
+
+void CachedText::setFillColor(const sf::Color& color)
+{
+	if (_fillColor == color) return;
+
+	_fillColor = color;
+	_isColorDirty = true;
+}
+
+void CachedText::reserve(std::size_t glyphCount)
+{
+	_coloredVertices.reserve(glyphCount * TextLayoutConstants::VERTICES_PER_GLYPH);
+}
+
+const sf::String& CachedText::getString() const
+{
+	return _string;
+}
+
+unsigned int CachedText::getCharacterSize() const
+{
+	return _characterSize;
+}
+
+const sf::Color& CachedText::getFillColor() const
+{
+	return _fillColor;
+}
+
+sf::FloatRect CachedText::getLocalBounds() const
+{
+	return _layout ? _layout->bounds : sf::FloatRect();
+}
+
+sf::FloatRect CachedText::getGlobalBounds() const
+{
+	return getTransform().transformRect(getLocalBounds());
+}
+
+void CachedText::draw(sf::RenderTarget& target) const
+{
+	if (!_layout || _layout->vertices.empty()) return;
+
+	if (_isColorDirty)
+	{
+		_coloredVertices = _layout->vertices;
+		for (sf::Vertex& vertex : _coloredVertices)
+		{
+			vertex.color = _fillColor;
+		}
+		_isColorDirty = false;
+	}
+
+	sf::RenderStates states(getTransform());
+	states.texture = _layout->texture;
+
+	target.draw(_coloredVertices.data(), _coloredVertices.size(), sf::Triangles, states);
+}
+
+void CachedText::draw(BatchRenderer& renderer) const
+{
+	if (_layout)
+	{
+		renderer.addText(*_layout, _fillColor, getTransform());
+	}
+}
+
+void CachedText::refreshLayout()
+{
+	_isColorDirty = true;
+
+	if (!_font || _string.isEmpty())
+	{
+		_layout.reset();
+		return;
+	}
+
+	_layout = _sharedFont ?
+		TextLayoutCache::getInstance().acquire(_sharedFont, _string, _characterSize, _isBold) :
+		TextLayout::create(*_font, _string, _characterSize, _isBold);
+}
\ No newline at end of file
@@ -4,13 +4,8 @@ CheckBox::CheckBox(const sf::Font& font,
 	const std::string& text,
 	const sf::Vector2f& pos,
 	unsigned int characterSize)
-	:_isChecked(false), _font(font)
+	:_isChecked(false)
 {
-	if (!_font.loadFromFile(RESOURCES_DIR "Fonts/defaultFont.otf"))
-	{
-		throw FontException("Error loading the font!");
-	}
-
 	_box.setSize({ 100.f, 20.f });
 	_box.setFillColor(sf::Color(200, 200, 200));
 	_box.setOutlineThickness(2.f);
@@ -20,7 +15,7 @@ CheckBox::CheckBox(const sf::Font& font,
 	_checkMark.setFillColor(sf::Color::Blue);
 	_checkMark.setPosition(pos.x + 4.f, pos.y + 4.f);
 
-	_label.setFont(_font);
+	_label.setFont(font);
 	_label.setString(text);
 	_label.setCharacterSize(characterSize);
 	_label.setFillColor(sf::Color::Black);
@@ -28,12 +23,23 @@ CheckBox::CheckBox(const sf::Font& font,
 	setPosition(pos);
 }
 
+CheckBox::CheckBox(std::shared_ptr<const sf::Font> font,
+	const std::string& text,
+	const sf::Vector2f& pos,
+	unsigned int characterSize)
+	:CheckBox(*font, text, pos, characterSize)
+{
+	_font = std::move(font);
+}
+
 CheckBox::CheckBox(CheckBox&& other) noexcept
 	:_isChecked(other._isChecked),
 	_box(std::move(other._box)),
 	_checkMark(std::move(other._checkMark)),
+	_boxSkin(other._boxSkin),
+	_checkMarkSkin(other._checkMarkSkin),
 	_label(std::move(other._label)),
-	_font(other._font),
+	_font(std::move(other._font)),
 	_callback(std::move(other._callback)) {}
 
 CheckBox& CheckBox::operator=(CheckBox&& other) noexcept
@@ -43,8 +49,10 @@ CheckBox& CheckBox::operator=(CheckBox&& other) noexcept
 		_isChecked = other._isChecked;
 		_box = std::move(other._box);
 		_checkMark = std::move(other._checkMark);
+		_boxSkin = other._boxSkin;
+		_checkMarkSkin = other._checkMarkSkin;
 		_label = std::move(other._label);
-		_font = other._font;
+		_font = std::move(other._font);
 		_callback = std::move(other._callback);
 	}
 
@@ -53,20 +61,30 @@ CheckBox& CheckBox::operator=(CheckBox&& other) noexcept
 
 void CheckBox::setPosition(const sf::Vector2f& pos)
 {
+	const bool moved = _box.getPosition() != pos;
+
 	_box.setPosition(pos);
 	_checkMark.setPosition(pos.x + 0.4f, pos.y + 0.4f);
 	_label.setPosition(pos.x + 30.f, pos.y);
+
+	if (moved) invalidateBounds();
 }
 
 void CheckBox::setSize(const sf::Vector2f& size)
 {
+	if (_box.getSize() == size) return;
+
 	_box.setSize(size);
 	_checkMark.setSize(size - sf::Vector2f{ 120, 0.8f });
+	invalidateBounds();
 }
 
 void CheckBox::setChecked(bool checked)
 {
+	if (_isChecked == checked) return;
+
 	_isChecked = checked;
+	updateAppearance();
 }
 
 void CheckBox::setCallback(const std::function<void(bool)>& func)
@@ -94,14 +112,71 @@ sf::RectangleShape& CheckBox::getShape()
 	return _box;
 }
 
-void CheckBox::draw(sf::RenderWindow& window)
+void CheckBox::setSkin(const AtlasRegion* box, const AtlasRegion* checkMark)
 {
-	window.draw(_box);
-	window.draw(_checkMark);
-	window.draw(_label);
+	_boxSkin = box;
+	_checkMarkSkin = checkMark;
 }
 
-void CheckBox::handleEvent(const sf::RenderWindow& window, const sf::Event& event)
+void CheckBox::draw(sf::RenderTarget& target)
+{
+	if (_boxSkin)
+	{
+		_boxSkin->draw(target, { {}, _box.getSize() }, _box.getFillColor(), _box.getTransform());
+	}
+	else
+	{
+		target.draw(_box);
+	}
+
+	if (!_checkMarkSkin)
+	{
+		target.draw(_checkMark);
+	}
+	else if (_isChecked)
+	{
+		_checkMarkSkin->draw(target, { {}, _checkMark.getSize() }, _checkMark.getFillColor(), _checkMark.getTransform());
+	}
+
+	target.draw(_label);
+}
+
+void CheckBox::draw(BatchRenderer& renderer)
+{
+	if (_boxSkin)
+	{
+		renderer.addRegion(*_boxSkin, { {}, _box.getSize() }, _box.getFillColor(), _box.getTransform());
+	}
+	else
+	{
+		renderer.addShape(_box);
+	}
+
+	if (!_checkMarkSkin)
+	{
+		renderer.addShape(_checkMark);
+	}
+	else if (_isChecked)
+	{
+		renderer.addRegion(*_checkMarkSkin, { {}, _checkMark.getSize() }, _checkMark.getFillColor(), _checkMark.getTransform());
+	}
+
+	renderer.addText(_label);
+}
+
+DrawRecording CheckBox::prepareDraw()
+{
+	// The label is an sf::Text, laid out from the font on every draw
+	return DrawRecording::RenderThread;
+}
+
+sf::FloatRect CheckBox::getBounds() const
+{
+	return uniteBounds(uniteBounds(_box.getGlobalBounds(), _checkMark.getGlobalBounds()),
+		_label.getGlobalBounds());
+}
+
+void CheckBox::handleEvent(const sf::RenderTarget& target, const sf::Event& event)
 {
 
 	auto now = std::chrono::steady_clock::now();
@@ -112,25 +187,13 @@ void CheckBox::handleEvent(const sf::RenderWindow& window, const sf::Event& even
 	{
 		_lastClickTime = now;
 
-		auto mousePosition = window.mapPixelToCoords({event.mouseButton.x, event.mouseButton.y});
+		auto mousePosition = target.mapPixelToCoords({event.mouseButton.x, event.mouseButton.y});
 		auto contains = _box.getGlobalBounds().contains(mousePosition);
 
 		if (contains)
 		{
 			_isChecked = !_isChecked;
-
-			if (_isChecked) 
-			{
-				_box.setFillColor(_ACTIVE_BG_COLOR);    
-				_checkMark.setFillColor(sf::Color::Green);
-				_label.setFillColor(sf::Color::White);
-			}
-			else 
-			{
-				_box.setFillColor(_INACTIVE_BG_COLOR); 
-				_checkMark.setFillColor(sf::Color::Blue); 
-				_label.setFillColor(sf::Color::Black);      
-			}
+			updateAppearance();
 
 			if (_callback)
 			{
@@ -139,3 +202,21 @@ void CheckBox::handleEvent(const sf::RenderWindow& window, const sf::Event& even
 		}
 	}
 }
+
+void CheckBox::updateAppearance()
+{
+	if (_isChecked)
+	{
+		_box.setFillColor(_ACTIVE_BG_COLOR);
+		_checkMark.setFillColor(sf::Color::Green);
+		_label.setFillColor(sf::Color::White);
+	}
+	else
+	{
+		_box.setFillColor(_INACTIVE_BG_COLOR);
+		_checkMark.setFillColor(sf::Color::Blue);
+		_label.setFillColor(sf::Color::Black);
+	}
+
+	invalidate();
+}
\ No newline at end of file
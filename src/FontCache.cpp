@@ -0,0 +1,115 @@
+#include <FontCache.h>
+
+FontCache& FontCache::getInstance()
+{
+	static FontCache instance;
+	return instance;
+}
+
+std::shared_ptr<const sf::Font> FontCache::acquire(const std::string& path, unsigned int characterSize)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	std::shared_ptr<sf::Font> font = _fonts[path].lock();
+
+	if (!font)
+	{
+		try
+		{
+			font = load(path);
+		}
+		catch (...)
+		{
+			_fonts.erase(path);
+			throw;
+		}
+
+		_fonts[path] = font;
+		forgetPreloadedSizes(path);
+	}
+
+	if (characterSize > 0 && _preloadedSizes.insert(makeSizeKey(path, characterSize)).second)
+	{
+		for (sf::Uint32 glyph = FontCacheConstants::FIRST_PRELOADED_GLYPH;
+			glyph <= FontCacheConstants::LAST_PRELOADED_GLYPH; ++glyph)
+		{
+			font->getGlyph(glyph, characterSize, false);
+		}
+	}
+
+	return font;
+}
+
+std::shared_ptr<sf::Font> FontCache::load(const std::string& path)
+{
+	auto font = std::make_shared<sf::Font>();
+	if (!font->loadFromFile(path)) throw FontException(path);
+
+	return font;
+}
+
+std::shared_ptr<const sf::Font> FontCache::prefetch(const std::string& path)
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		auto found = _fonts.find(path);
+		if (found != _fonts.end())
+		{
+			if (std::shared_ptr<sf::Font> font = found->second.lock()) return font;
+		}
+	}
+
+	// Parsed without the lock so other fonts can be acquired meanwhile
+	std::shared_ptr<sf::Font> font = load(path);
+
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	std::weak_ptr<sf::Font>& entry = _fonts[path];
+	if (std::shared_ptr<sf::Font> loaded = entry.lock()) return loaded;
+
+	entry = font;
+	forgetPreloadedSizes(path);
+
+	return font;
+}
+
+void FontCache::replace(const std::string& path, std::shared_ptr<sf::Font> font)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	_fonts[path] = font;
+	forgetPreloadedSizes(path);
+}
+
+std::shared_ptr<const sf::Font> FontCache::acquireDefault(unsigned int characterSize)
+{
+	return acquire(FontCacheConstants::DEFAULT_FONT_PATH, characterSize);
+}
+
+std::size_t FontCache::getLoadedCount() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	std::size_t count = 0;
+	for (const auto& [path, font] : _fonts)
+	{
+		if (!font.expired()) ++count;
+	}
+
+	return count;
+}
+
+std::string FontCache::makeSizeKey(const std::string& path, unsigned int characterSize)
+{
+	return path + '#' + std::to_string(characterSize);
+}
+
+void FontCache::forgetPreloadedSizes(const std::string& path)
+{
+	// A new font starts with empty glyph pages
+	for (auto it = _preloadedSizes.begin(); it != _preloadedSizes.end();)
+	{
+		it = it->rfind(path + '#', 0) == 0 ? _preloadedSizes.erase(it) : std::next(it);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,317 @@
+#include <Graphics/InterfaceElements/ImmediateUi.h>
+
+#include <cassert>
+#include <algorithm>
+
+#include <Graphics/InterfaceElements/Factories/Default_button_factory.h>
+#include <FontCache.h>
+
+ImmediateUi::ImmediateUi()
+	:_buttonStyle(DefaultButtonFactory().getStyle())
+{
+}
+
+ImmediateUi::~ImmediateUi() = default;
+
+void ImmediateUi::begin()
+{
+	assert(!_isDeclaring && "ImmediateUi::begin() called twice without end()");
+
+	++_frame;
+	_declared.clear();
+
+	_rowTop = _position.y;
+	_rowRight = _position.x;
+	_rowHeight = 0.f;
+	_isSameLine = false;
+	_isDeclaring = true;
+}
+
+void ImmediateUi::end()
+{
+	assert(_isDeclaring && "ImmediateUi::end() called without begin()");
+	_isDeclaring = false;
+
+	sf::FloatRect bounds(_position, {});
+	bool hasChanged = false;
+
+	for (Widget* widget : _declared)
+	{
+		bounds = uniteBounds(bounds, widget->getBounds());
+
+		if (widget->isDirty())
+		{
+			widget->clearDirty();
+			hasChanged = true;
+		}
+	}
+
+	for (auto it = _entries.begin(); it != _entries.end();)
+	{
+		Entry& entry = it->second;
+
+		if (entry.lastFrame == _frame)
+		{
+			++it;
+			continue;
+		}
+
+		if (entry.isAttached)
+		{
+			_widgets.remove(*entry.widget);
+			entry.isAttached = false;
+			hasChanged = true;
+		}
+
+		if (_frame - entry.lastFrame >= ImmediateUiConstants::RETIRE_AFTER_FRAMES)
+		{
+			std::visit([this](auto handle) { _widgets.destroy(handle); }, entry.handle);
+			it = _entries.erase(it);
+			continue;
+		}
+
+		++it;
+	}
+
+	if (bounds != _bounds)
+	{
+		_bounds = bounds;
+		invalidateBounds();
+	}
+	else if (hasChanged)
+	{
+		invalidate();
+	}
+}
+
+bool ImmediateUi::button(std::string_view label)
+{
+	const sf::Vector2f size(_width, ImmediateUiConstants::BUTTON_HEIGHT);
+
+	Entry& entry = declare(Kind::Button, label, size, [&](const sf::Vector2f& position)
+		{
+			const std::string_view text = getShownText(label);
+			return _widgets.create<Button>(_buttonStyle, sf::String::fromUtf8(text.begin(), text.end()), position, size);
+		});
+
+	Button& button = static_cast<Button&>(*entry.widget);
+	button.setSize(size);
+
+	const std::string_view text = getShownText(label);
+	if (entry.text != text)
+	{
+		entry.text = text;
+		button.setText(sf::String::fromUtf8(text.begin(), text.end()));
+	}
+
+	return button.isClicked();
+}
+
+bool ImmediateUi::checkbox(std::string_view label, bool& value)
+{
+	const float boxSize = ImmediateUiConstants::CHECK_BOX_SIZE;
+
+	Entry& entry = declare(Kind::CheckBox, label, { _width, boxSize }, [&](const sf::Vector2f& position)
+		{
+			return _widgets.create<CheckBox>(FontCache::getInstance().acquireDefault(ImmediateUiConstants::CHARACTER_SIZE),
+				std::string(getShownText(label)), position, ImmediateUiConstants::CHARACTER_SIZE);
+		});
+
+	CheckBox& checkBox = static_cast<CheckBox&>(*entry.widget);
+	checkBox.setSize({ boxSize, boxSize });
+
+	// Clicked since the last frame
+	if (checkBox.getChecked() != entry.value)
+	{
+		entry.value = checkBox.getChecked();
+		value = entry.value;
+		return true;
+	}
+
+	if (value != entry.value)
+	{
+		entry.value = value;
+		checkBox.setChecked(value);
+	}
+
+	return false;
+}
+
+void ImmediateUi::progress(std::string_view id, float value, float maxValue)
+{
+	const sf::Vector2f size(_width, ImmediateUiConstants::PROGRESS_HEIGHT);
+
+	Entry& entry = declare(Kind::ProgressBar, id, size, [&](const sf::Vector2f&)
+		{
+			return _widgets.create<ProgressBar>(size, sf::Color(50, 50, 50), sf::Color::Green);
+		});
+
+	ProgressBar& progressBar = static_cast<ProgressBar&>(*entry.widget);
+	progressBar.setSize(size);
+	progressBar.setMaxValue(maxValue);
+	progressBar.setValue(value);
+}
+
+void ImmediateUi::sameLine()
+{
+	_isSameLine = true;
+}
+
+void ImmediateUi::render(sf::RenderTarget& target)
+{
+	_renderer.begin(target);
+	draw(_renderer);
+	_renderer.end();
+}
+
+std::size_t ImmediateUi::getWidgetCount() const
+{
+	return _entries.size();
+}
+
+void ImmediateUi::setPosition(const sf::Vector2f& pos)
+{
+	// Used from the next begin(); end() reports the move
+	_position = pos;
+}
+
+void ImmediateUi::setSize(const sf::Vector2f& size)
+{
+	if (size.x > 0.f) _width = size.x;
+}
+
+void ImmediateUi::draw(sf::RenderTarget& target)
+{
+	for (Widget* widget : _declared)
+	{
+		widget->draw(target);
+	}
+}
+
+void ImmediateUi::draw(BatchRenderer& renderer)
+{
+	for (Widget* widget : _declared)
+	{
+		widget->draw(renderer);
+	}
+}
+
+DrawRecording ImmediateUi::prepareDraw()
+{
+	// As restricted as the most restricted widget drawn
+	DrawRecording recording = DrawRecording::AnyThread;
+
+	for (Widget* widget : _declared)
+	{
+		recording = std::min(recording, widget->prepareDraw());
+	}
+
+	return recording;
+}
+
+sf::FloatRect ImmediateUi::getBounds() const
+{
+	return _bounds;
+}
+
+void ImmediateUi::handleEvent(const sf::RenderTarget& target, const sf::Event& event)
+{
+	_widgets.dispatch(target, event);
+}
+
+std::uint64_t ImmediateUi::makeId(Kind kind, std::string_view label)
+{
+	// FNV-1a; the kind keeps a button and a check box with the same label apart
+	std::uint64_t hash = 14695981039346656037ull ^ static_cast<std::uint64_t>(kind);
+
+	for (char character : getIdText(label))
+	{
+		hash ^= static_cast<unsigned char>(character);
+		hash *= 1099511628211ull;
+	}
+
+	return hash;
+}
+
+std::string_view ImmediateUi::getShownText(std::string_view label)
+{
+	return label.substr(0, label.find(ImmediateUiConstants::ID_SEPARATOR));
+}
+
+std::string_view ImmediateUi::getIdText(std::string_view label)
+{
+	const std::size_t fixedId = label.find(ImmediateUiConstants::FIXED_ID_SEPARATOR);
+	return fixedId == std::string_view::npos ? label : label.substr(fixedId);
+}
+
+template<class Create>
+ImmediateUi::Entry& ImmediateUi::declare(Kind kind, std::string_view label, const sf::Vector2f& slotSize, Create&& create)
+{
+	assert(_isDeclaring && "ImmediateUi widgets are declared between begin() and end()");
+
+	const sf::Vector2f position = place(slotSize);
+
+	auto [found, isNew] = _entries.try_emplace(makeId(kind, label));
+	Entry& entry = found->second;
+
+#ifndef NDEBUG
+	if (isNew) entry.key = getIdText(label);
+	assert(entry.key == getIdText(label) && "ImmediateUi labels hash to the same ID; give one of them a ##suffix");
+#endif
+
+	if (isNew)
+	{
+		try
+		{
+			auto handle = create(position);
+			entry.handle = handle;
+			entry.widget = _widgets.get(handle);
+		}
+		catch (...)
+		{
+			_entries.erase(found);
+			throw;
+		}
+
+		entry.isAttached = true;
+	}
+	else
+	{
+		assert(entry.lastFrame != _frame && "ImmediateUi labels must be unique within a frame");
+
+		if (!entry.isAttached)
+		{
+			_widgets.add(*entry.widget);
+			entry.isAttached = true;
+		}
+	}
+
+	entry.lastFrame = _frame;
+	entry.widget->setPosition(position);
+	_declared.push_back(entry.widget);
+
+	return entry;
+}
+
+sf::Vector2f ImmediateUi::place(const sf::Vector2f& size)
+{
+	sf::Vector2f position;
+
+	if (_isSameLine && _rowHeight > 0.f)
+	{
+		position = { _rowRight + ImmediateUiConstants::SPACING, _rowTop };
+		_rowHeight = std::max(_rowHeight, size.y);
+	}
+	else
+	{
+		if (_rowHeight > 0.f) _rowTop += _rowHeight + ImmediateUiConstants::SPACING;
+
+		position = { _position.x, _rowTop };
+		_rowHeight = size.y;
+	}
+
+	_rowRight = position.x + size.x;
+	_isSameLine = false;
+
+	return position;
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include <InputQueue.h>
+
+#include <algorithm>
+
+std::size_t InputQueue::poll(sf::Window& window)
+{
+	const std::size_t before = _events.size();
+
+	sf::Event event;
+	while (window.pollEvent(event))
+	{
+		push(event);
+	}
+
+	return _events.size() - before;
+}
+
+void InputQueue::push(const sf::Event& event)
+{
+	if (coalesce(event))
+	{
+		++_coalesced;
+		return;
+	}
+
+	_events.push_back(event);
+}
+
+void InputQueue::clear()
+{
+	// Keeps the capacity, a steady event rate stops allocating after the first frames
+	_events.clear();
+	_coalesced = 0;
+}
+
+bool InputQueue::coalesce(const sf::Event& event)
+{
+	switch (event.type)
+	{
+	case sf::Event::MouseMoved:
+		// Anything in between (a click, a key) may depend on the earlier position, so only merge neighbours
+		if (!_events.empty() && _events.back().type == sf::Event::MouseMoved)
+		{
+			_events.back().mouseMove = event.mouseMove;
+			return true;
+		}
+		return false;
+
+	case sf::Event::MouseWheelScrolled:
+		if (!_events.empty() && _events.back().type == sf::Event::MouseWheelScrolled)
+		{
+			sf::Event::MouseWheelScrollEvent& last = _events.back().mouseWheelScroll;
+
+			if (last.wheel == event.mouseWheelScroll.wheel &&
+				last.x == event.mouseWheelScroll.x &&
+				last.y == event.mouseWheelScroll.y)
+			{
+				last.delta += event.mouseWheelScroll.delta;
+				return true;
+			}
+		}
+		return false;
+
+	case sf::Event::Resized:
+	{
+		// Intermediate sizes are never worth a relayout, the newest one wins
+		auto previous = std::find_if(_events.begin(), _events.end(), [](const sf::Event& queued)
+			{
+				return queued.type == sf::Event::Resized;
+			});
+
+		if (previous == _events.end()) return false;
+
+		_events.erase(previous);
+		_events.push_back(event);
+		return true;
+	}
+
+	default:
+		return false;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,229 @@
+#include <JobSystem.h>
+
+#include <limits>
+#include <utility>
+#include <algorithm>
+#include <stdexcept>
+
+#include <Profiler.h>
+
+namespace
+{
+	// Workers, and the caller while it helps out; a loop started here runs inline instead of waiting on itself
+	thread_local bool isInsideJob = false;
+
+	std::uint64_t pack(std::size_t next, std::size_t end)
+	{
+		return static_cast<std::uint64_t>(end) << 32 | static_cast<std::uint64_t>(next);
+	}
+}
+
+JobSystem& JobSystem::getInstance()
+{
+	static JobSystem instance(getDefaultWorkerCount());
+	return instance;
+}
+
+std::size_t JobSystem::getDefaultWorkerCount()
+{
+	return std::max(std::thread::hardware_concurrency(), 1u) - 1;
+}
+
+JobSystem::JobSystem(std::size_t workerCount)
+{
+	startWorkers(workerCount);
+}
+
+JobSystem::~JobSystem()
+{
+	stopWorkers();
+}
+
+void JobSystem::setWorkerCount(std::size_t count)
+{
+	if (count == _threads.size()) return;
+
+	stopWorkers();
+	startWorkers(count);
+}
+
+std::size_t JobSystem::getWorkerCount() const
+{
+	return _threads.size();
+}
+
+void JobSystem::run(std::size_t chunkCount, ChunkFunction function, void* context)
+{
+	if (chunkCount == 0) return;
+
+	if (chunkCount == 1 || _threads.empty() || isInsideJob)
+	{
+		for (std::size_t chunk = 0; chunk < chunkCount; ++chunk)
+		{
+			function(context, chunk);
+		}
+		return;
+	}
+
+	if (chunkCount > std::numeric_limits<std::uint32_t>::max())
+	{
+		throw std::invalid_argument("JobSystem::parallelFor() -> too many chunks");
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		_function = function;
+		_context = context;
+		_exception = nullptr;
+
+		// Even runs, the first ones take one chunk of the remainder each
+		const std::size_t share = chunkCount / _runCount;
+		const std::size_t remainder = chunkCount % _runCount;
+		std::size_t next = 0;
+
+		for (std::size_t i = 0; i < _runCount; ++i)
+		{
+			const std::size_t end = next + share + (i < remainder ? 1 : 0);
+			_runs[i].range.store(pack(next, end), std::memory_order_relaxed);
+			next = end;
+		}
+
+		_busyWorkers = _threads.size();
+		++_generation;
+	}
+
+	_hasWork.notify_all();
+
+	isInsideJob = true;
+	runChunks(_runCount - 1);
+	isInsideJob = false;
+
+	std::exception_ptr exception;
+	{
+		// Every worker checks in, so none is still reading this loop when the next one starts
+		std::unique_lock<std::mutex> lock(_mutex);
+		_isDone.wait(lock, [this]() { return _busyWorkers == 0; });
+		exception = std::exchange(_exception, nullptr);
+	}
+
+	if (exception) std::rethrow_exception(exception);
+}
+
+void JobSystem::work(std::stop_token stopToken, std::size_t index, std::uint64_t seenGeneration)
+{
+	isInsideJob = true;
+
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			if (!_hasWork.wait(lock, stopToken, [&]() { return _generation != seenGeneration; })) return;
+
+			seenGeneration = _generation;
+		}
+
+		runChunks(index);
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (--_busyWorkers == 0) _isDone.notify_one();
+		}
+	}
+}
+
+void JobSystem::runChunks(std::size_t index)
+{
+	std::size_t chunk;
+
+	while (takeFront(_runs[index], chunk))
+	{
+		runChunk(chunk);
+	}
+
+	// Runs only ever shrink, so one pass over the others leaves nothing behind
+	for (std::size_t offset = 1; offset < _runCount; ++offset)
+	{
+		Run& victim = _runs[(index + offset) % _runCount];
+
+		while (takeBack(victim, chunk))
+		{
+			runChunk(chunk);
+		}
+	}
+}
+
+void JobSystem::runChunk(std::size_t chunk)
+{
+	const ScopedTimer timer("JobSystem::chunk");
+
+	try
+	{
+		_function(_context, chunk);
+	}
+	catch (...)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (!_exception) _exception = std::current_exception();
+	}
+}
+
+bool JobSystem::takeFront(Run& run, std::size_t& chunk)
+{
+	std::uint64_t range = run.range.load(std::memory_order_acquire);
+
+	while (true)
+	{
+		const std::size_t next = static_cast<std::uint32_t>(range);
+		const std::size_t end = static_cast<std::size_t>(range >> 32);
+		if (next >= end) return false;
+
+		if (run.range.compare_exchange_weak(range, pack(next + 1, end), std::memory_order_acq_rel))
+		{
+			chunk = next;
+			return true;
+		}
+	}
+}
+
+bool JobSystem::takeBack(Run& run, std::size_t& chunk)
+{
+	std::uint64_t range = run.range.load(std::memory_order_acquire);
+
+	while (true)
+	{
+		const std::size_t next = static_cast<std::uint32_t>(range);
+		const std::size_t end = static_cast<std::size_t>(range >> 32);
+		if (next >= end) return false;
+
+		if (run.range.compare_exchange_weak(range, pack(next, end - 1), std::memory_order_acq_rel))
+		{
+			chunk = end - 1;
+			return true;
+		}
+	}
+}
+
+void JobSystem::startWorkers(std::size_t count)
+{
+	_runCount = count + 1;
+	_runs = std::make_unique<Run[]>(_runCount);
+
+	// Taken here, not by the thread: one that starts late must still count the next loop as new
+	const std::uint64_t generation = _generation;
+
+	_threads.reserve(count);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		_threads.emplace_back([this, i, generation](std::stop_token stopToken)
+			{
+				work(stopToken, i, generation);
+			});
+	}
+}
+
+void JobSystem::stopWorkers()
+{
+	for (std::jthread& thread : _threads) thread.request_stop();
+	_threads.clear();
+}
\ No newline at end of file
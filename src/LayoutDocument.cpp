@@ -0,0 +1,871 @@
+#include <LayoutDocument.h>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <charconv>
+#include <algorithm>
+#include <filesystem>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <AnchoredElement.h>
+#include <Exceptions.h>
+
+namespace
+{
+	enum class ArgumentKind { String, Numbers, Color, Bool, Anchor, Direction };
+
+	struct PropertyInfo
+	{
+		const char* name;
+		LayoutProperty property;
+		ArgumentKind kind;
+		std::size_t count;
+		std::uint32_t nodes;
+	};
+
+	struct Keyword
+	{
+		const char* name;
+		float value;
+	};
+
+	constexpr std::uint32_t nodeBit(LayoutNodeType type)
+	{
+		return 1u << static_cast<unsigned int>(type);
+	}
+
+	constexpr std::uint32_t STACK = nodeBit(LayoutNodeType::Stack);
+	constexpr std::uint32_t BUTTON = nodeBit(LayoutNodeType::Button);
+	constexpr std::uint32_t CHECK_BOX = nodeBit(LayoutNodeType::CheckBox);
+	constexpr std::uint32_t TEXT_FIELD = nodeBit(LayoutNodeType::TextField);
+	constexpr std::uint32_t PROGRESS_BAR = nodeBit(LayoutNodeType::ProgressBar);
+	constexpr std::uint32_t ANY_NODE = STACK | BUTTON | CHECK_BOX | TEXT_FIELD | PROGRESS_BAR;
+
+	constexpr PropertyInfo PROPERTIES[] =
+	{
+		{ "text", LayoutProperty::Text, ArgumentKind::String, 1, BUTTON | CHECK_BOX | TEXT_FIELD },
+		{ "font", LayoutProperty::Font, ArgumentKind::String, 1, BUTTON | CHECK_BOX },
+		{ "charSize", LayoutProperty::CharacterSize, ArgumentKind::Numbers, 1, BUTTON | CHECK_BOX | TEXT_FIELD | PROGRESS_BAR },
+		{ "anchor", LayoutProperty::Anchor, ArgumentKind::Anchor, 2, ANY_NODE },
+		{ "offset", LayoutProperty::Offset, ArgumentKind::Numbers, 2, ANY_NODE },
+		{ "size", LayoutProperty::Size, ArgumentKind::Numbers, 2, ANY_NODE },
+		{ "spacing", LayoutProperty::Spacing, ArgumentKind::Numbers, 1, STACK },
+		{ "direction", LayoutProperty::Direction, ArgumentKind::Direction, 1, STACK },
+		{ "fill", LayoutProperty::Fill, ArgumentKind::Color, 4, BUTTON | PROGRESS_BAR },
+		{ "hover", LayoutProperty::Hover, ArgumentKind::Color, 4, BUTTON },
+		{ "pressed", LayoutProperty::Pressed, ArgumentKind::Color, 4, BUTTON },
+		{ "disabled", LayoutProperty::Disabled, ArgumentKind::Color, 4, BUTTON },
+		{ "outline", LayoutProperty::Outline, ArgumentKind::Color, 4, BUTTON },
+		{ "outlineThickness", LayoutProperty::OutlineThickness, ArgumentKind::Numbers, 1, BUTTON },
+		{ "background", LayoutProperty::Background, ArgumentKind::Color, 4, PROGRESS_BAR },
+		{ "value", LayoutProperty::Value, ArgumentKind::Numbers, 1, PROGRESS_BAR },
+		{ "maxValue", LayoutProperty::MaxValue, ArgumentKind::Numbers, 1, PROGRESS_BAR },
+		{ "smoothness", LayoutProperty::Smoothness, ArgumentKind::Numbers, 1, PROGRESS_BAR },
+		{ "vertical", LayoutProperty::Vertical, ArgumentKind::Bool, 1, PROGRESS_BAR },
+		{ "percentage", LayoutProperty::Percentage, ArgumentKind::Bool, 1, PROGRESS_BAR },
+		{ "multiline", LayoutProperty::Multiline, ArgumentKind::Bool, 1, TEXT_FIELD },
+		{ "maxLength", LayoutProperty::MaxLength, ArgumentKind::Numbers, 1, TEXT_FIELD },
+		{ "checked", LayoutProperty::Checked, ArgumentKind::Bool, 1, CHECK_BOX },
+		{ "enabled", LayoutProperty::Enabled, ArgumentKind::Bool, 1, BUTTON | PROGRESS_BAR },
+		{ "onClick", LayoutProperty::OnClick, ArgumentKind::String, 1, BUTTON },
+		{ "onToggle", LayoutProperty::OnToggle, ArgumentKind::String, 1, CHECK_BOX },
+		{ "onChange", LayoutProperty::OnChange, ArgumentKind::String, 1, PROGRESS_BAR },
+	};
+
+	constexpr std::pair<const char*, LayoutNodeType> NODE_TYPES[] =
+	{
+		{ "stack", LayoutNodeType::Stack },
+		{ "button", LayoutNodeType::Button },
+		{ "checkbox", LayoutNodeType::CheckBox },
+		{ "textfield", LayoutNodeType::TextField },
+		{ "progressbar", LayoutNodeType::ProgressBar },
+	};
+
+	constexpr Keyword HORIZONTAL_ANCHORS[] =
+	{
+		{ "left", static_cast<float>(AnchorHorizontal::LEFT) },
+		{ "center", static_cast<float>(AnchorHorizontal::CENTER) },
+		{ "right", static_cast<float>(AnchorHorizontal::RIGHT) },
+		{ "stretch", static_cast<float>(AnchorHorizontal::STRETCH) },
+	};
+
+	constexpr Keyword VERTICAL_ANCHORS[] =
+	{
+		{ "top", static_cast<float>(AnchorVertical::TOP) },
+		{ "center", static_cast<float>(AnchorVertical::CENTER) },
+		{ "bottom", static_cast<float>(AnchorVertical::BOTTOM) },
+		{ "stretch", static_cast<float>(AnchorVertical::STRETCH) },
+	};
+
+	constexpr Keyword DIRECTIONS[] =
+	{
+		{ "vertical", 0.f },
+		{ "horizontal", 1.f },
+	};
+
+	constexpr std::size_t HEADER_SIZE = sizeof(LayoutFileHeader);
+
+
+	constexpr bool isInPropertyOrder()
+	{
+		for (std::size_t i = 0; i < std::size(PROPERTIES); ++i)
+		{
+			if (static_cast<std::size_t>(PROPERTIES[i].property) != i) return false;
+		}
+		return true;
+	}
+
+	static_assert(isInPropertyOrder(), "PROPERTIES must list every LayoutProperty in declaration order");
+
+	const PropertyInfo& propertyInfo(LayoutProperty property)
+	{
+		return PROPERTIES[static_cast<std::size_t>(property)];
+	}
+
+	bool isKeyword(float value, std::span<const Keyword> keywords)
+	{
+		return std::any_of(keywords.begin(), keywords.end(), [value](const Keyword& keyword) { return keyword.value == value; });
+	}
+
+	// What is wrong with a value's numbers, nullptr if nothing. The parser checks what it reads,
+	// attach() what a compiled file holds: enums come back from floats and must be in range
+	const char* checkNumbers(const LayoutValue& value)
+	{
+		const PropertyInfo& info = propertyInfo(value.property);
+		const std::size_t expected = info.kind == ArgumentKind::String ? 0 : info.count;
+
+		if (value.numberCount != expected) return "wrong count of numbers for the property";
+
+		for (std::size_t i = 0; i < value.numberCount; ++i)
+		{
+			if (!std::isfinite(value.numbers[i])) return "number is not finite";
+		}
+
+		const float number = value.numbers[0];
+
+		switch (info.kind)
+		{
+		case ArgumentKind::Color:
+			for (std::size_t i = 0; i < value.numberCount; ++i)
+			{
+				if (value.numbers[i] < 0.f || value.numbers[i] > 255.f) return "color channels range from 0 to 255";
+			}
+			break;
+		case ArgumentKind::Bool:
+			if (number != 0.f && number != 1.f) return "flag is neither true nor false";
+			break;
+		case ArgumentKind::Anchor:
+			if (!isKeyword(number, HORIZONTAL_ANCHORS) || !isKeyword(value.numbers[1], VERTICAL_ANCHORS)) return "unknown anchor";
+			break;
+		case ArgumentKind::Direction:
+			if (!isKeyword(number, DIRECTIONS)) return "unknown direction";
+			break;
+		default:
+			break;
+		}
+
+		switch (value.property)
+		{
+		case LayoutProperty::MaxValue:
+			if (number <= std::numeric_limits<float>::epsilon()) return "'maxValue' must be greater than 0";
+			break;
+		case LayoutProperty::Value:
+			if (number < 0.f) return "'value' must not be negative";
+			break;
+		case LayoutProperty::Smoothness:
+			if (number < 0.f || number > 1.f) return "'smoothness' ranges from 0 to 1";
+			break;
+		default:
+			break;
+		}
+
+		return nullptr;
+	}
+
+	struct Token
+	{
+		std::string text;
+		bool isQuoted = false;
+
+		bool is(const char* word) const { return !isQuoted && text == word; }
+	};
+
+	struct Line
+	{
+		std::size_t number = 0;
+		std::vector<Token> tokens;
+	};
+
+	[[noreturn]] void fail(const std::string& origin, std::size_t line, const std::string& message)
+	{
+		throw LayoutException(origin + ":" + std::to_string(line) + ": " + message);
+	}
+
+	bool isDelimiter(char c)
+	{
+		return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '{' || c == '}' || c == '"' || c == '#';
+	}
+
+	// Splits the source into lines of words, quoted strings and braces; comments and blank lines vanish
+	std::vector<Line> tokenize(std::string_view source, const std::string& origin)
+	{
+		std::vector<Line> lines;
+		Line line{ 1, {} };
+
+		auto endLine = [&lines, &line]()
+			{
+				const std::size_t next = line.number + 1;
+				if (!line.tokens.empty()) lines.push_back(std::move(line));
+				line = Line{ next, {} };
+			};
+
+		std::size_t i = 0;
+		while (i < source.size())
+		{
+			const char c = source[i];
+
+			if (c == '\n')
+			{
+				endLine();
+				++i;
+			}
+			else if (c == '#')
+			{
+				while (i < source.size() && source[i] != '\n') ++i;
+			}
+			else if (c == ' ' || c == '\t' || c == '\r')
+			{
+				++i;
+			}
+			else if (c == '{' || c == '}')
+			{
+				line.tokens.push_back({ std::string(1, c), false });
+				++i;
+			}
+			else if (c == '"')
+			{
+				Token token{ {}, true };
+
+				for (++i;; ++i)
+				{
+					if (i >= source.size() || source[i] == '\n') fail(origin, line.number, "unterminated string");
+					if (source[i] == '"') break;
+
+					if (source[i] == '\\' && i + 1 < source.size() && source[i + 1] != '\n')
+					{
+						++i;
+						token.text += source[i] == 'n' ? '\n' : source[i];
+						continue;
+					}
+
+					token.text += source[i];
+				}
+
+				++i;
+				line.tokens.push_back(std::move(token));
+			}
+			else
+			{
+				const std::size_t start = i;
+				while (i < source.size() && !isDelimiter(source[i])) ++i;
+
+				line.tokens.push_back({ std::string(source.substr(start, i - start)), false });
+			}
+		}
+
+		endLine();
+		return lines;
+	}
+
+	class Parser
+	{
+	public:
+		Parser(std::vector<Line> lines, const std::string& origin)
+			:_lines(std::move(lines)),
+			_origin(origin),
+			_strings(1, '\0')
+		{
+		}
+
+		std::vector<char> compile()
+		{
+			while (_position < _lines.size())
+			{
+				const Line& line = _lines[_position];
+
+				if (line.tokens[0].is("style"))
+				{
+					parseStyle();
+				}
+				else if (nodeType(line.tokens[0]))
+				{
+					parseNode(LayoutConstants::NO_PARENT);
+				}
+				else
+				{
+					error(line, "expected a widget or a style, found '" + line.tokens[0].text + "'");
+				}
+			}
+
+			return write();
+		}
+
+	private:
+		struct PendingNode
+		{
+			LayoutNodeType type;
+			std::uint32_t name;
+			std::uint32_t parent;
+			std::vector<LayoutValue> values;
+		};
+
+		[[noreturn]] void error(const Line& line, const std::string& message) const
+		{
+			fail(_origin, line.number, message);
+		}
+
+		static std::optional<LayoutNodeType> nodeType(const Token& token)
+		{
+			for (const auto& [name, type] : NODE_TYPES)
+			{
+				if (token.is(name)) return type;
+			}
+			return std::nullopt;
+		}
+
+		static const char* nodeTypeName(LayoutNodeType type)
+		{
+			return NODE_TYPES[static_cast<std::size_t>(type)].first;
+		}
+
+		std::uint32_t intern(const std::string& text)
+		{
+			if (text.empty()) return LayoutConstants::NO_STRING;
+
+			auto found = _interned.find(text);
+			if (found != _interned.end()) return found->second;
+
+			const auto offset = static_cast<std::uint32_t>(_strings.size());
+			_strings.append(text);
+			_strings.push_back('\0');
+
+			_interned.emplace(text, offset);
+			return offset;
+		}
+
+		// Consumes "keyword [name] {" (the brace may sit on the next line) and returns the name
+		std::string openBlock(bool requireName)
+		{
+			const Line& line = _lines[_position++];
+			std::size_t count = line.tokens.size();
+
+			const bool hasBrace = count > 1 && line.tokens.back().is("{");
+			if (hasBrace) --count;
+
+			if (count > 2) error(line, "unexpected '" + line.tokens[2].text + "'");
+			if (count == 2 && (line.tokens[1].is("{") || line.tokens[1].is("}"))) error(line, "expected a name");
+			if (requireName && count < 2) error(line, "'" + line.tokens[0].text + "' needs a name");
+
+			if (!hasBrace)
+			{
+				if (_position >= _lines.size() ||
+					_lines[_position].tokens.size() != 1 ||
+					!_lines[_position].tokens[0].is("{"))
+				{
+					error(line, "expected '{'");
+				}
+				++_position;
+			}
+
+			return count == 2 ? line.tokens[1].text : std::string();
+		}
+
+		// False once the block's closing brace was consumed
+		bool nextInBlock(const Line& opening)
+		{
+			if (_position >= _lines.size()) error(opening, "missing '}'");
+
+			const Line& line = _lines[_position];
+			if (!line.tokens[0].is("}")) return true;
+
+			if (line.tokens.size() > 1) error(line, "unexpected '" + line.tokens[1].text + "' after '}'");
+
+			++_position;
+			return false;
+		}
+
+		const std::vector<LayoutValue>& findStyle(const Line& line) const
+		{
+			if (line.tokens.size() != 2) error(line, "'style' takes a style name");
+
+			auto found = _styles.find(line.tokens[1].text);
+			if (found == _styles.end()) error(line, "unknown style '" + line.tokens[1].text + "' (styles must be defined before use)");
+
+			return found->second;
+		}
+
+		void parseStyle()
+		{
+			const Line& opening = _lines[_position];
+			const std::string name = openBlock(true);
+
+			if (_styles.contains(name)) error(opening, "style '" + name + "' is defined twice");
+
+			std::vector<LayoutValue> values;
+			while (nextInBlock(opening))
+			{
+				const Line& line = _lines[_position++];
+
+				if (line.tokens[0].is("style"))
+				{
+					const std::vector<LayoutValue>& base = findStyle(line);
+					values.insert(values.end(), base.begin(), base.end());
+					continue;
+				}
+
+				values.push_back(parseValue(line));
+			}
+
+			_styles.emplace(name, std::move(values));
+		}
+
+		void parseNode(std::uint32_t parent)
+		{
+			const Line& opening = _lines[_position];
+			const LayoutNodeType type = *nodeType(opening.tokens[0]);
+			const std::string name = openBlock(false);
+
+			if (!name.empty() && !_names.insert(name).second) error(opening, "widget name '" + name + "' is used twice");
+
+			const auto index = static_cast<std::uint32_t>(_nodes.size());
+			_nodes.push_back({ type, intern(name), parent, {} });
+
+			while (nextInBlock(opening))
+			{
+				const Line& line = _lines[_position];
+
+				if (nodeType(line.tokens[0]))
+				{
+					if (type != LayoutNodeType::Stack) error(line, "only a stack can contain widgets");
+
+					parseNode(index);
+					continue;
+				}
+
+				++_position;
+
+				if (line.tokens[0].is("style"))
+				{
+					// A style is shared between widget types; each widget takes what applies to it
+					for (const LayoutValue& value : findStyle(line))
+					{
+						if (appliesTo(value, type, parent)) _nodes[index].values.push_back(value);
+					}
+					continue;
+				}
+
+				const LayoutValue value = parseValue(line);
+
+				if (value.property == LayoutProperty::Anchor && parent != LayoutConstants::NO_PARENT)
+				{
+					error(line, "widgets inside a stack follow the stack's anchor");
+				}
+				if (!appliesTo(value, type, parent))
+				{
+					error(line, "'" + line.tokens[0].text + "' does not apply to a " + nodeTypeName(type));
+				}
+
+				_nodes[index].values.push_back(value);
+			}
+		}
+
+		static bool appliesTo(const LayoutValue& value, LayoutNodeType type, std::uint32_t parent)
+		{
+			if (value.property == LayoutProperty::Anchor && parent != LayoutConstants::NO_PARENT) return false;
+
+			return (propertyInfo(value.property).nodes & nodeBit(type)) != 0;
+		}
+
+		float number(const Line& line, const Token& token) const
+		{
+			float value = 0.f;
+			const char* first = token.text.data();
+			const char* last = first + token.text.size();
+
+			const auto [end, result] = std::from_chars(first, last, value);
+			if (token.isQuoted || result != std::errc() || end != last || !std::isfinite(value))
+			{
+				error(line, "'" + token.text + "' is not a number");
+			}
+
+			return value;
+		}
+
+		float keyword(const Line& line, const Token& token, std::span<const Keyword> keywords) const
+		{
+			for (const Keyword& keyword : keywords)
+			{
+				if (token.is(keyword.name)) return keyword.value;
+			}
+
+			error(line, "unexpected '" + token.text + "' for '" + line.tokens[0].text + "'");
+		}
+
+		void parseColor(const Line& line, LayoutValue& value) const
+		{
+			const std::size_t count = line.tokens.size() - 1;
+			value.numberCount = 4;
+			value.numbers[3] = 255.f;
+
+			if (count != 3 && count != 4) error(line, "'" + line.tokens[0].text + "' takes r g b [a]");
+
+			for (std::size_t channel = 0; channel < count; ++channel)
+			{
+				const float component = number(line, line.tokens[channel + 1]);
+				if (component < 0.f || component > 255.f) error(line, "color channels range from 0 to 255");
+
+				value.numbers[channel] = component;
+			}
+		}
+
+		LayoutValue parseValue(const Line& line)
+		{
+			const Token& key = line.tokens[0];
+
+			auto info = std::find_if(std::begin(PROPERTIES), std::end(PROPERTIES), [&key](const PropertyInfo& property)
+				{
+					return key.is(property.name);
+				});
+
+			if (info == std::end(PROPERTIES)) error(line, "unknown property '" + key.text + "'");
+
+			LayoutValue value{};
+			value.property = info->property;
+			value.text = LayoutConstants::NO_STRING;
+
+			const std::size_t count = line.tokens.size() - 1;
+			auto expectArguments = [&](std::size_t expected)
+				{
+					if (count != expected)
+					{
+						error(line, "'" + key.text + "' takes " + std::to_string(expected) + (expected == 1 ? " value" : " values"));
+					}
+				};
+
+			switch (info->kind)
+			{
+			case ArgumentKind::String:
+				expectArguments(1);
+				value.text = intern(line.tokens[1].text);
+				break;
+			case ArgumentKind::Numbers:
+				expectArguments(info->count);
+				for (std::size_t i = 0; i < info->count; ++i)
+				{
+					value.numbers[i] = number(line, line.tokens[i + 1]);
+				}
+				value.numberCount = static_cast<std::uint8_t>(info->count);
+				break;
+			case ArgumentKind::Bool:
+				expectArguments(1);
+				if (line.tokens[1].is("true")) value.numbers[0] = 1.f;
+				else if (!line.tokens[1].is("false")) error(line, "'" + key.text + "' is true or false");
+				value.numberCount = 1;
+				break;
+			case ArgumentKind::Color:
+				parseColor(line, value);
+				break;
+			case ArgumentKind::Anchor:
+				expectArguments(2);
+				value.numbers[0] = keyword(line, line.tokens[1], HORIZONTAL_ANCHORS);
+				value.numbers[1] = keyword(line, line.tokens[2], VERTICAL_ANCHORS);
+				value.numberCount = 2;
+				break;
+			case ArgumentKind::Direction:
+				expectArguments(1);
+				value.numbers[0] = keyword(line, line.tokens[1], DIRECTIONS);
+				value.numberCount = 1;
+				break;
+			}
+
+			// Refused here rather than by the widget, which would throw once it is already in the container
+			if (const char* reason = checkNumbers(value)) error(line, reason);
+
+			return value;
+		}
+
+		std::vector<char> write() const
+		{
+			std::size_t valueCount = 0;
+			for (const PendingNode& node : _nodes) valueCount += node.values.size();
+
+			LayoutFileHeader header{};
+			std::memcpy(header.magic, LayoutConstants::MAGIC, sizeof(header.magic));
+			header.version = LayoutConstants::VERSION;
+			header.nodeCount = static_cast<std::uint32_t>(_nodes.size());
+			header.valueCount = static_cast<std::uint32_t>(valueCount);
+			header.stringsSize = static_cast<std::uint32_t>(_strings.size());
+
+			std::vector<char> image(HEADER_SIZE + _nodes.size() * sizeof(LayoutNode) +
+				valueCount * sizeof(LayoutValue) + _strings.size());
+
+			char* out = image.data();
+			std::memcpy(out, &header, HEADER_SIZE);
+			out += HEADER_SIZE;
+
+			std::uint32_t firstValue = 0;
+			for (const PendingNode& pending : _nodes)
+			{
+				LayoutNode node{};
+				node.type = pending.type;
+				node.name = pending.name;
+				node.parent = pending.parent;
+				node.firstValue = firstValue;
+				node.valueCount = static_cast<std::uint32_t>(pending.values.size());
+
+				std::memcpy(out, &node, sizeof(node));
+				out += sizeof(node);
+				firstValue += node.valueCount;
+			}
+
+			for (const PendingNode& pending : _nodes)
+			{
+				const std::size_t bytes = pending.values.size() * sizeof(LayoutValue);
+				if (bytes) std::memcpy(out, pending.values.data(), bytes);
+				out += bytes;
+			}
+
+			std::memcpy(out, _strings.data(), _strings.size());
+			return image;
+		}
+
+		std::vector<Line> _lines;
+		std::size_t _position = 0;
+		const std::string& _origin;
+
+		std::vector<PendingNode> _nodes;
+		std::unordered_set<std::string> _names;
+		std::unordered_map<std::string, std::vector<LayoutValue>> _styles;
+
+		std::string _strings;
+		std::unordered_map<std::string, std::uint32_t> _interned;
+	};
+
+	// Last write time and size of the text a compiled layout came from
+	bool sourceStamp(const std::string& path, std::int64_t& time, std::uint64_t& size)
+	{
+		std::error_code error;
+
+		const auto writeTime = std::filesystem::last_write_time(path, error);
+		if (error) return false;
+
+		const auto fileSize = std::filesystem::file_size(path, error);
+		if (error) return false;
+
+		time = static_cast<std::int64_t>(writeTime.time_since_epoch().count());
+		size = static_cast<std::uint64_t>(fileSize);
+		return true;
+	}
+}
+
+LayoutDocument LayoutDocument::parse(std::string_view source, const std::string& origin)
+{
+	LayoutDocument document;
+	document._image = Parser(tokenize(source, origin), origin).compile();
+	document._data = document._image.data();
+	document._size = document._image.size();
+
+	return document;
+}
+
+LayoutDocument LayoutDocument::loadText(const std::string& path)
+{
+	// Taken before reading: an edit made meanwhile then leaves the cache stale instead of stamping old text as new
+	std::int64_t sourceTime = 0;
+	std::uint64_t sourceSize = 0;
+	sourceStamp(path, sourceTime, sourceSize);
+
+	std::ifstream file(path, std::ios::binary);
+	if (!file) throw FileLoadException(path);
+
+	std::ostringstream contents;
+	contents << file.rdbuf();
+
+	LayoutDocument document = parse(contents.str(), path);
+
+	LayoutFileHeader& header = *reinterpret_cast<LayoutFileHeader*>(document._image.data());
+	header.sourceTime = sourceTime;
+	header.sourceSize = sourceSize;
+
+	return document;
+}
+
+LayoutDocument LayoutDocument::loadBinary(const std::string& path)
+{
+	LayoutDocument document;
+	document._file = MappedFile(path);
+	document.attach(document._file.data(), document._file.size(), path);
+
+	return document;
+}
+
+LayoutDocument LayoutDocument::load(const std::string& sourcePath, const std::string& cachePath)
+{
+	std::int64_t sourceTime = 0;
+	std::uint64_t sourceSize = 0;
+	const bool hasSource = sourceStamp(sourcePath, sourceTime, sourceSize);
+
+	std::error_code error;
+	if (std::filesystem::exists(cachePath, error))
+	{
+		try
+		{
+			LayoutDocument cached = loadBinary(cachePath);
+
+			// Without the text the compiled file is all there is, e.g. in a shipped build
+			if (!hasSource) return cached;
+
+			if (cached.header().sourceTime == sourceTime && cached.header().sourceSize == sourceSize)
+			{
+				return cached;
+			}
+		}
+		catch (const BaseException&)
+		{
+			// Damaged or written by another version; compiled again below
+		}
+	}
+
+	LayoutDocument document = loadText(sourcePath);
+
+	// Best effort: a read-only install still runs from the text
+	document.save(cachePath);
+
+	return document;
+}
+
+bool LayoutDocument::save(const std::string& path) const
+{
+	if (!_data) return false;
+
+	const std::string temporary = path + ".tmp";
+	{
+		std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+		if (!file.write(_data, static_cast<std::streamsize>(_size))) return false;
+	}
+
+	// Replacing the file in one step never truncates a copy another process still has mapped
+	std::error_code error;
+	std::filesystem::rename(temporary, path, error);
+
+	if (error)
+	{
+		std::filesystem::remove(temporary, error);
+		return false;
+	}
+
+	return true;
+}
+
+std::span<const LayoutNode> LayoutDocument::getNodes() const
+{
+	if (!_data) return {};
+
+	return { reinterpret_cast<const LayoutNode*>(_data + HEADER_SIZE), header().nodeCount };
+}
+
+std::span<const LayoutValue> LayoutDocument::getValues(const LayoutNode& node) const
+{
+	const char* values = _data + HEADER_SIZE + header().nodeCount * sizeof(LayoutNode);
+
+	return { reinterpret_cast<const LayoutValue*>(values) + node.firstValue, node.valueCount };
+}
+
+const char* LayoutDocument::getString(std::uint32_t offset) const
+{
+	const LayoutFileHeader& fileHeader = header();
+	const char* strings = _data + HEADER_SIZE +
+		fileHeader.nodeCount * sizeof(LayoutNode) + fileHeader.valueCount * sizeof(LayoutValue);
+
+	return strings + offset;
+}
+
+const LayoutNode* LayoutDocument::find(std::string_view name) const
+{
+	for (const LayoutNode& node : getNodes())
+	{
+		if (node.name != LayoutConstants::NO_STRING && name == getString(node.name)) return &node;
+	}
+	return nullptr;
+}
+
+// Checks every offset and count once so the accessors above never have to
+void LayoutDocument::attach(const char* data, std::size_t size, const std::string& origin)
+{
+	auto invalid = [&origin](const char* reason)
+		{
+			throw LayoutException(origin + ": " + reason);
+		};
+
+	if (!data || size < HEADER_SIZE) invalid("too small to be a compiled layout");
+
+	LayoutFileHeader fileHeader;
+	std::memcpy(&fileHeader, data, HEADER_SIZE);
+
+	if (std::memcmp(fileHeader.magic, LayoutConstants::MAGIC, sizeof(fileHeader.magic)) != 0) invalid("not a compiled layout");
+	if (fileHeader.version != LayoutConstants::VERSION) invalid("compiled for another layout version");
+
+	const std::uint64_t expectedSize = HEADER_SIZE +
+		static_cast<std::uint64_t>(fileHeader.nodeCount) * sizeof(LayoutNode) +
+		static_cast<std::uint64_t>(fileHeader.valueCount) * sizeof(LayoutValue) +
+		fileHeader.stringsSize;
+
+	if (expectedSize != size) invalid("size does not match its header");
+
+	const char* strings = data + size - fileHeader.stringsSize;
+	if (fileHeader.stringsSize == 0 || strings[0] != '\0' || strings[fileHeader.stringsSize - 1] != '\0')
+	{
+		invalid("string table is not terminated");
+	}
+
+	const auto* nodes = reinterpret_cast<const LayoutNode*>(data + HEADER_SIZE);
+	const auto* values = reinterpret_cast<const LayoutValue*>(nodes + fileHeader.nodeCount);
+
+	for (std::uint32_t i = 0; i < fileHeader.nodeCount; ++i)
+	{
+		const LayoutNode& node = nodes[i];
+
+		if (node.type > LayoutNodeType::ProgressBar) invalid("unknown widget type");
+		if (node.name >= fileHeader.stringsSize) invalid("widget name out of range");
+		if (node.parent != LayoutConstants::NO_PARENT &&
+			(node.parent >= i || nodes[node.parent].type != LayoutNodeType::Stack))
+		{
+			invalid("widget parent out of order");
+		}
+		if (static_cast<std::uint64_t>(node.firstValue) + node.valueCount > fileHeader.valueCount) invalid("property range out of bounds");
+	}
+
+	for (std::uint32_t i = 0; i < fileHeader.valueCount; ++i)
+	{
+		const LayoutValue& value = values[i];
+
+		if (value.property > LayoutProperty::OnChange) invalid("unknown property");
+		if (value.numberCount > LayoutConstants::MAX_NUMBERS) invalid("too many numbers in a property");
+		if (value.text >= fileHeader.stringsSize) invalid("string out of range");
+		if (const char* reason = checkNumbers(value)) invalid(reason);
+	}
+
+	_data = data;
+	_size = size;
+}
+
+const LayoutFileHeader& LayoutDocument::header() const
+{
+	return *reinterpret_cast<const LayoutFileHeader*>(_data);
+}
\ No newline at end of file
@@ -0,0 +1,564 @@
+#include <LayoutInstance.h>
+
+#include <optional>
+#include <algorithm>
+#include <string_view>
+#include <filesystem>
+
+#include <Graphics/InterfaceElements/Factories/Default_button_factory.h>
+#include <Exceptions.h>
+#include <FontCache.h>
+
+namespace
+{
+	// Everything a node says about itself; later values win, so a widget overrides its style
+	struct Settings
+	{
+		std::optional<std::string> text;
+		std::string font;
+		std::optional<unsigned int> characterSize;
+
+		std::optional<AnchorHorizontal> horizontalAnchor;
+		AnchorVertical verticalAnchor = AnchorVertical::TOP;
+		sf::Vector2f offset;
+		std::optional<sf::Vector2f> size;
+		float spacing = 0.f;
+		bool isHorizontal = false;
+
+		std::optional<sf::Color> fill;
+		std::optional<sf::Color> hover;
+		std::optional<sf::Color> pressed;
+		std::optional<sf::Color> disabled;
+		std::optional<sf::Color> outline;
+		std::optional<sf::Color> background;
+		std::optional<float> outlineThickness;
+
+		std::optional<float> value;
+		std::optional<float> maxValue;
+		std::optional<float> smoothness;
+		std::optional<bool> isVertical;
+		std::optional<bool> showPercentage;
+		std::optional<bool> isMultiline;
+		std::optional<unsigned int> maxLength;
+		std::optional<bool> isChecked;
+		std::optional<bool> isEnabled;
+
+		std::string onClick;
+		std::string onToggle;
+		std::string onChange;
+	};
+
+	sf::Color toColor(const LayoutValue& value)
+	{
+		return sf::Color(
+			static_cast<sf::Uint8>(value.numbers[0]),
+			static_cast<sf::Uint8>(value.numbers[1]),
+			static_cast<sf::Uint8>(value.numbers[2]),
+			static_cast<sf::Uint8>(value.numbers[3]));
+	}
+
+	unsigned int toCount(float value)
+	{
+		return value > 0.f ? static_cast<unsigned int>(value) : 0u;
+	}
+
+	Settings readSettings(const LayoutDocument& document, const LayoutNode& node)
+	{
+		Settings settings;
+
+		for (const LayoutValue& value : document.getValues(node))
+		{
+			const float number = value.numbers[0];
+			const char* text = document.getString(value.text);
+
+			switch (value.property)
+			{
+			case LayoutProperty::Text: settings.text = text; break;
+			case LayoutProperty::Font: settings.font = text; break;
+			case LayoutProperty::CharacterSize: settings.characterSize = toCount(number); break;
+			case LayoutProperty::Anchor:
+				settings.horizontalAnchor = static_cast<AnchorHorizontal>(value.numbers[0]);
+				settings.verticalAnchor = static_cast<AnchorVertical>(value.numbers[1]);
+				break;
+			case LayoutProperty::Offset: settings.offset = { value.numbers[0], value.numbers[1] }; break;
+			case LayoutProperty::Size: settings.size = sf::Vector2f(value.numbers[0], value.numbers[1]); break;
+			case LayoutProperty::Spacing: settings.spacing = number; break;
+			case LayoutProperty::Direction: settings.isHorizontal = number != 0.f; break;
+			case LayoutProperty::Fill: settings.fill = toColor(value); break;
+			case LayoutProperty::Hover: settings.hover = toColor(value); break;
+			case LayoutProperty::Pressed: settings.pressed = toColor(value); break;
+			case LayoutProperty::Disabled: settings.disabled = toColor(value); break;
+			case LayoutProperty::Outline: settings.outline = toColor(value); break;
+			case LayoutProperty::OutlineThickness: settings.outlineThickness = number; break;
+			case LayoutProperty::Background: settings.background = toColor(value); break;
+			case LayoutProperty::Value: settings.value = number; break;
+			case LayoutProperty::MaxValue: settings.maxValue = number; break;
+			case LayoutProperty::Smoothness: settings.smoothness = number; break;
+			case LayoutProperty::Vertical: settings.isVertical = number != 0.f; break;
+			case LayoutProperty::Percentage: settings.showPercentage = number != 0.f; break;
+			case LayoutProperty::Multiline: settings.isMultiline = number != 0.f; break;
+			case LayoutProperty::MaxLength: settings.maxLength = toCount(number); break;
+			case LayoutProperty::Checked: settings.isChecked = number != 0.f; break;
+			case LayoutProperty::Enabled: settings.isEnabled = number != 0.f; break;
+			case LayoutProperty::OnClick: settings.onClick = text; break;
+			case LayoutProperty::OnToggle: settings.onToggle = text; break;
+			case LayoutProperty::OnChange: settings.onChange = text; break;
+			}
+		}
+
+		return settings;
+	}
+
+	// Relative font paths are looked up in the resources directory
+	std::string resourcePath(const std::string& path)
+	{
+		return std::filesystem::path(path).is_absolute() ? path : RESOURCES_DIR + path;
+	}
+
+	// The path the font cache knows a layout's font by
+	std::string resolveFont(const std::string& path)
+	{
+		return path.empty() ? FontCacheConstants::DEFAULT_FONT_PATH : resourcePath(path);
+	}
+
+	// Properties that only move or resize a widget, which a reload does without rebuilding it
+	bool isPlacementOnly(LayoutProperty property)
+	{
+		switch (property)
+		{
+		case LayoutProperty::Anchor:
+		case LayoutProperty::Offset:
+		case LayoutProperty::Size:
+		case LayoutProperty::Spacing:
+		case LayoutProperty::Direction:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	std::string makeSignature(const LayoutDocument& document, const LayoutNode& node, bool hasSize)
+	{
+		std::string signature{ static_cast<char>(node.type), hasSize ? '1' : '0' };
+
+		for (const LayoutValue& value : document.getValues(node))
+		{
+			if (isPlacementOnly(value.property)) continue;
+
+			signature += static_cast<char>(value.property);
+			signature.append(reinterpret_cast<const char*>(value.numbers), value.numberCount * sizeof(float));
+			signature += document.getString(value.text);
+			signature += '\0';
+		}
+
+		return signature;
+	}
+
+	template<class Function>
+	const Function& findBinding(const std::unordered_map<std::string, Function>& bindings, const std::string& name)
+	{
+		auto found = bindings.find(name);
+		if (found == bindings.end()) throw LayoutException("nothing is bound to callback '" + name + "'");
+
+		return found->second;
+	}
+}
+
+void LayoutBindings::bindClick(const std::string& name, std::function<void()> action)
+{
+	_clicks[name] = std::move(action);
+}
+
+void LayoutBindings::bindToggle(const std::string& name, std::function<void(bool)> action)
+{
+	_toggles[name] = std::move(action);
+}
+
+void LayoutBindings::bindChange(const std::string& name, std::function<void(float)> action)
+{
+	_changes[name] = std::move(action);
+}
+
+const std::function<void()>& LayoutBindings::getClick(const std::string& name) const
+{
+	return findBinding(_clicks, name);
+}
+
+const std::function<void(bool)>& LayoutBindings::getToggle(const std::string& name) const
+{
+	return findBinding(_toggles, name);
+}
+
+const std::function<void(float)>& LayoutBindings::getChange(const std::string& name) const
+{
+	return findBinding(_changes, name);
+}
+
+LayoutInstance::LayoutInstance(LayoutDocument document, WidgetContainer& container, const LayoutBindings& bindings)
+	:_document(std::move(document)),
+	_container(container),
+	_bindings(bindings)
+{
+	rebuild();
+}
+
+LayoutInstance::~LayoutInstance()
+{
+	destroyAll();
+}
+
+std::size_t LayoutInstance::reload(LayoutDocument document)
+{
+	std::swap(_document, document);
+
+	try
+	{
+		return rebuild();
+	}
+	catch (...)
+	{
+		std::swap(_document, document);
+		throw;
+	}
+}
+
+std::size_t LayoutInstance::reloadFont(const std::string& path)
+{
+	bool isUsed = false;
+
+	for (Entry& entry : _entries)
+	{
+		if (entry.font != path) continue;
+
+		// Never matches a node, so the widget is built again with the new font
+		entry.signature.clear();
+		isUsed = true;
+	}
+
+	return isUsed ? rebuild() : 0;
+}
+
+std::vector<std::string> LayoutInstance::getFontPaths() const
+{
+	std::vector<std::string> paths;
+
+	for (const Entry& entry : _entries)
+	{
+		if (!entry.font.empty() && std::find(paths.begin(), paths.end(), entry.font) == paths.end())
+		{
+			paths.push_back(entry.font);
+		}
+	}
+
+	return paths;
+}
+
+std::vector<std::string> LayoutInstance::getFontPaths(const LayoutDocument& document)
+{
+	// Widgets without a font of their own use the default one
+	std::vector<std::string> paths{ FontCacheConstants::DEFAULT_FONT_PATH };
+
+	for (const LayoutNode& node : document.getNodes())
+	{
+		for (const LayoutValue& value : document.getValues(node))
+		{
+			if (value.property != LayoutProperty::Font) continue;
+
+			const std::string path = resolveFont(document.getString(value.text));
+			if (std::find(paths.begin(), paths.end(), path) == paths.end()) paths.push_back(path);
+		}
+	}
+
+	return paths;
+}
+
+void LayoutInstance::setWindowSize(const sf::Vector2u& windowSize)
+{
+	_layout.setWindowSize(windowSize);
+}
+
+std::size_t LayoutInstance::apply()
+{
+	return _layout.apply();
+}
+
+std::size_t LayoutInstance::rebuild()
+{
+	const std::span<const LayoutNode> nodes = _document.getNodes();
+	std::vector<Placement> placements(nodes.size());
+
+	std::vector<std::string> keys(nodes.size());
+	// Unnamed children met so far per parent; the extra last slot counts top-level nodes
+	std::vector<std::size_t> slots(nodes.size() + 1);
+
+	std::unordered_map<std::string_view, std::size_t> previous;
+	for (std::size_t i = 0; i < _entries.size(); ++i)
+	{
+		previous.emplace(_entries[i].key, i);
+	}
+
+	std::vector<bool> isKept(_entries.size());
+	std::vector<Entry> entries;
+	entries.reserve(nodes.size());
+
+	DefaultButtonFactory buttonFactory;
+	std::size_t created = 0;
+
+	try
+	{
+		for (std::size_t i = 0; i < nodes.size(); ++i)
+		{
+			const LayoutNode& node = nodes[i];
+			const Settings settings = readSettings(_document, node);
+			const bool isTopLevel = node.parent == LayoutConstants::NO_PARENT;
+			Placement& placement = placements[i];
+
+			if (isTopLevel)
+			{
+				placement.horizontal = settings.horizontalAnchor.value_or(AnchorHorizontal::LEFT);
+				placement.vertical = settings.horizontalAnchor ? settings.verticalAnchor : AnchorVertical::TOP;
+				placement.offset = settings.offset;
+				placement.size = settings.size.value_or(sf::Vector2f());
+				placement.hasSize = settings.size.has_value();
+			}
+			else
+			{
+				// Inside a stack: anchored like the stack, moved down (or right) past the previous siblings
+				Placement& stack = placements[node.parent];
+
+				placement.horizontal = stack.horizontal;
+				placement.vertical = stack.vertical;
+				placement.offset = stack.offset;
+				placement.size = settings.size.value_or(stack.size);
+				placement.hasSize = settings.size.has_value() || stack.hasSize;
+				placement.shift = stack.shift + stack.cursor + settings.offset;
+
+				if (stack.isHorizontal) stack.cursor.x += placement.size.x + stack.spacing;
+				else stack.cursor.y += placement.size.y + stack.spacing;
+			}
+
+			keys[i] = node.name != LayoutConstants::NO_STRING
+				? std::string(_document.getString(node.name))
+				: (isTopLevel ? std::string() : keys[node.parent]) + '#'
+					+ std::to_string(slots[isTopLevel ? nodes.size() : node.parent]++);
+
+			if (node.type == LayoutNodeType::Stack)
+			{
+				placement.spacing = settings.spacing;
+				placement.isHorizontal = settings.isHorizontal;
+				continue;
+			}
+
+			std::string signature = makeSignature(_document, node, placement.hasSize);
+
+			auto found = previous.find(keys[i]);
+			if (found != previous.end() && !isKept[found->second] && _entries[found->second].signature == signature)
+			{
+				isKept[found->second] = true;
+
+				Entry& entry = entries.emplace_back(_entries[found->second]);
+				entry.placement = placement;
+				entry.isNew = false;
+				continue;
+			}
+
+			// Listed before it is built, so the rollback below also removes a widget whose setup threw
+			Entry& entry = entries.emplace_back();
+			create(node, placement, buttonFactory, entry);
+			entry.key = keys[i];
+			entry.signature = std::move(signature);
+			++created;
+		}
+	}
+	catch (...)
+	{
+		for (const Entry& entry : entries)
+		{
+			if (entry.isNew) destroy(entry);
+		}
+
+		// Anything a widget refused is reported like the layout errors the parser finds
+		try
+		{
+			throw;
+		}
+		catch (const LayoutException&)
+		{
+			throw;
+		}
+		catch (const std::exception& exception)
+		{
+			throw LayoutException(std::string("could not build the layout: ") + exception.what());
+		}
+	}
+
+	for (std::size_t i = 0; i < _entries.size(); ++i)
+	{
+		if (!isKept[i]) destroy(_entries[i]);
+	}
+
+	_entries = std::move(entries);
+	_named.clear();
+	_layout.clear();
+
+	for (std::size_t i = 0; i < _entries.size(); ++i)
+	{
+		Entry& entry = _entries[i];
+		entry.isNew = false;
+
+		if (!entry.name.empty()) _named.emplace(entry.name, i);
+		place(entry);
+	}
+
+	return created;
+}
+
+void LayoutInstance::create(const LayoutNode& node, const Placement& placement,
+	DefaultButtonFactory& buttonFactory, Entry& entry)
+{
+	const Settings settings = readSettings(_document, node);
+
+	// Everything that can throw is looked up before the widget exists
+	entry.placement = placement;
+	if (node.name != LayoutConstants::NO_STRING) entry.name = _document.getString(node.name);
+
+	const unsigned int characterSize = settings.characterSize.value_or(LayoutInstanceConstants::DEFAULT_CHARACTER_SIZE);
+
+	switch (node.type)
+	{
+	case LayoutNodeType::Button:
+	{
+		const sf::Vector2f size = placement.hasSize ? placement.size
+			: sf::Vector2f(LayoutInstanceConstants::DEFAULT_BUTTON_WIDTH, LayoutInstanceConstants::DEFAULT_BUTTON_HEIGHT);
+
+		ButtonStyle style = *buttonFactory.getStyle();
+		entry.font = resolveFont(settings.font);
+
+		if (!settings.font.empty() || settings.characterSize)
+		{
+			style.font = FontCache::getInstance().acquire(entry.font, characterSize);
+			style.borrowedFont = nullptr;
+			style.characterSize = characterSize;
+		}
+		if (settings.fill) style.normalColor = *settings.fill;
+		if (settings.hover) style.hoverColor = *settings.hover;
+		if (settings.pressed) style.pressedColor = *settings.pressed;
+		if (settings.disabled) style.disabledColor = *settings.disabled;
+		if (settings.outline) style.outlineColor = *settings.outline;
+		if (settings.outlineThickness) style.outlineThickness = *settings.outlineThickness;
+
+		// Buttons left at the default look keep following the default style; the rest share one style per look
+		std::shared_ptr<const ButtonStyle> shared = style.hasSameLook(*buttonFactory.getStyle())
+			? buttonFactory.getStyle() : ButtonTheme::getInstance().intern(style);
+
+		const sf::String text = settings.text ? sf::String::fromUtf8(settings.text->begin(), settings.text->end()) : sf::String();
+		std::function<void()> onClick;
+		if (!settings.onClick.empty()) onClick = _bindings.getClick(settings.onClick);
+
+		WidgetHandle<Button> handle = _container.create<Button>(std::move(shared), text, sf::Vector2f(), size, std::move(onClick));
+		Button& button = *_container.get(handle);
+		entry.handle = handle;
+
+		if (settings.isEnabled) button.setEnabled(*settings.isEnabled);
+
+		entry.widget = &button;
+		break;
+	}
+
+	case LayoutNodeType::CheckBox:
+	{
+		entry.font = resolveFont(settings.font);
+
+		std::shared_ptr<const sf::Font> font = FontCache::getInstance().acquire(entry.font, characterSize);
+		std::function<void(bool)> onToggle;
+		if (!settings.onToggle.empty()) onToggle = _bindings.getToggle(settings.onToggle);
+
+		WidgetHandle<CheckBox> handle = _container.create<CheckBox>(
+			std::move(font), settings.text.value_or(""), sf::Vector2f(), characterSize);
+		CheckBox& checkBox = *_container.get(handle);
+		entry.handle = handle;
+
+		checkBox.setSize({ LayoutInstanceConstants::DEFAULT_CHECK_BOX_SIZE, LayoutInstanceConstants::DEFAULT_CHECK_BOX_SIZE });
+		if (settings.isChecked) checkBox.setChecked(*settings.isChecked);
+		if (onToggle) checkBox.setCallback(std::move(onToggle));
+
+		entry.widget = &checkBox;
+		break;
+	}
+
+	case LayoutNodeType::TextField:
+	{
+		WidgetHandle<TextField> handle = _container.create<TextField>();
+		TextField& textField = *_container.get(handle);
+		entry.handle = handle;
+
+		if (settings.characterSize) textField.setCharacterSize(*settings.characterSize);
+		if (settings.isMultiline) textField.setMultiline(*settings.isMultiline);
+		if (settings.maxLength) textField.setMaxLength(*settings.maxLength);
+		if (settings.text) textField.setText(*settings.text);
+
+		entry.font = FontCacheConstants::DEFAULT_FONT_PATH;
+		entry.widget = &textField;
+		break;
+	}
+
+	case LayoutNodeType::ProgressBar:
+	{
+		const sf::Vector2f size = placement.hasSize ? placement.size
+			: sf::Vector2f(LayoutInstanceConstants::DEFAULT_PROGRESS_BAR_WIDTH, LayoutInstanceConstants::DEFAULT_PROGRESS_BAR_HEIGHT);
+
+		std::function<void(float)> onChange;
+		if (!settings.onChange.empty()) onChange = _bindings.getChange(settings.onChange);
+
+		WidgetHandle<ProgressBar> handle = _container.create<ProgressBar>(size,
+			settings.background.value_or(sf::Color(50, 50, 50)),
+			settings.fill.value_or(sf::Color::Green));
+		ProgressBar& progressBar = *_container.get(handle);
+		entry.handle = handle;
+
+		if (settings.isVertical) progressBar.setOrientation(*settings.isVertical);
+		if (settings.maxValue) progressBar.setMaxValue(*settings.maxValue);
+		if (settings.smoothness) progressBar.setSmoothness(*settings.smoothness);
+		if (settings.showPercentage) progressBar.showPercentage(*settings.showPercentage, characterSize);
+		if (settings.value) progressBar.setValue(*settings.value);
+		if (settings.isEnabled) progressBar.setEnabled(*settings.isEnabled);
+
+		// Bound last so building the bar doesn't report its initial value
+		progressBar._onValueChanged = std::move(onChange);
+
+		if (settings.showPercentage.value_or(false)) entry.font = FontCacheConstants::DEFAULT_FONT_PATH;
+		entry.widget = &progressBar;
+		break;
+	}
+
+	case LayoutNodeType::Stack:
+		break;
+	}
+}
+
+void LayoutInstance::place(const Entry& entry)
+{
+	const Placement& placement = entry.placement;
+	Widget* target = entry.widget;
+
+	_layout.add(placement.horizontal, placement.vertical, placement.offset, placement.size,
+		[target, shift = placement.shift, resize = placement.hasSize](const sf::Vector2f& position, const sf::Vector2f& size)
+		{
+			target->setPosition(position + shift);
+			if (resize) target->setSize(size);
+		});
+}
+
+void LayoutInstance::destroy(const Entry& entry)
+{
+	std::visit([this](auto handle) { _container.destroy(handle); }, entry.handle);
+}
+
+void LayoutInstance::destroyAll()
+{
+	for (const Entry& entry : _entries) destroy(entry);
+
+	_entries.clear();
+	_named.clear();
+	_layout.clear();
+}
\ No newline at end of file
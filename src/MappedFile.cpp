@@ -0,0 +1,128 @@
+#include <MappedFile.h>
+
+#include <utility>
+
+#include <Exceptions.h>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#ifdef _WIN32
+
+MappedFile::MappedFile(const std::string& path)
+{
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+	if (file == INVALID_HANDLE_VALUE) throw FileLoadException(path);
+
+	LARGE_INTEGER size{};
+	if (!GetFileSizeEx(file, &size))
+	{
+		CloseHandle(file);
+		throw FileLoadException(path);
+	}
+
+	// Nothing to map; an empty file is still a valid, empty view
+	if (size.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+
+	if (!mapping) throw FileLoadException(path);
+
+	// The view keeps the mapping alive on its own
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+
+	if (!view) throw FileLoadException(path);
+
+	_data = static_cast<const char*>(view);
+	_size = static_cast<std::size_t>(size.QuadPart);
+}
+
+void MappedFile::close()
+{
+	if (_data) UnmapViewOfFile(_data);
+
+	_data = nullptr;
+	_size = 0;
+}
+
+#else
+
+MappedFile::MappedFile(const std::string& path)
+{
+	const int descriptor = ::open(path.c_str(), O_RDONLY);
+	if (descriptor < 0) throw FileLoadException(path);
+
+	struct stat status {};
+	if (::fstat(descriptor, &status) != 0)
+	{
+		::close(descriptor);
+		throw FileLoadException(path);
+	}
+
+	if (status.st_size == 0)
+	{
+		::close(descriptor);
+		return;
+	}
+
+	void* view = ::mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+	::close(descriptor);
+
+	if (view == MAP_FAILED) throw FileLoadException(path);
+
+	_data = static_cast<const char*>(view);
+	_size = static_cast<std::size_t>(status.st_size);
+}
+
+void MappedFile::close()
+{
+	if (_data) ::munmap(const_cast<char*>(_data), _size);
+
+	_data = nullptr;
+	_size = 0;
+}
+
+#endif
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+	:_data(std::exchange(other._data, nullptr)),
+	_size(std::exchange(other._size, 0))
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		close();
+
+		_data = std::exchange(other._data, nullptr);
+		_size = std::exchange(other._size, 0);
+	}
+	return *this;
+}
\ No newline at end of file
@@ -0,0 +1,179 @@
+#include <Profiler.h>
+
+#include <fstream>
+
+namespace ProfilerConstants
+{
+	// Enough for a few seconds of heavily instrumented frames
+	constexpr std::size_t RESERVED_ZONES = 1 << 16;
+}
+
+Profiler& Profiler::getInstance()
+{
+	static Profiler instance;
+	return instance;
+}
+
+const char* Profiler::getCounterName(ProfilerCounter counter)
+{
+	switch (counter)
+	{
+	case ProfilerCounter::DrawCalls: return "draw calls";
+	case ProfilerCounter::Vertices: return "vertices";
+	case ProfilerCounter::TextLayouts: return "text layouts";
+	case ProfilerCounter::EventDispatches: return "event dispatches";
+	case ProfilerCounter::AnchorUpdates: return "anchor updates";
+	case ProfilerCounter::FillUpdates: return "fill updates";
+	case ProfilerCounter::Animations: return "animations";
+	case ProfilerCounter::QueuedUpdates: return "queued updates";
+	case ProfilerCounter::CulledWidgets: return "culled widgets";
+	default: return "unknown";
+	}
+}
+
+Profiler::Profiler()
+	:_epoch(Clock::now()),
+	_frameStart(_epoch)
+{
+}
+
+void Profiler::setEnabled(bool enabled)
+{
+	_isEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+void Profiler::beginFrame()
+{
+	if (!isEnabled()) return;
+
+	_frameStart = Clock::now();
+
+	for (auto& counter : _counters)
+	{
+		counter.store(0, std::memory_order_relaxed);
+	}
+}
+
+void Profiler::endFrame()
+{
+	if (!isEnabled()) return;
+
+	const Clock::time_point frameEnd = Clock::now();
+
+	Frame& frame = _history[_historyHead];
+	frame.index = _frameIndex++;
+	frame.durationMs = std::chrono::duration<double, std::milli>(frameEnd - _frameStart).count();
+
+	for (std::size_t i = 0; i < COUNTER_COUNT; ++i)
+	{
+		frame.counters[i] = _counters[i].load(std::memory_order_relaxed);
+	}
+
+	_historyHead = (_historyHead + 1) % HISTORY_SIZE;
+	_historySize = std::min(_historySize + 1, HISTORY_SIZE);
+
+	if (isCapturing())
+	{
+		std::lock_guard<std::mutex> lock(_captureMutex);
+		_capturedFrames.push_back(frame);
+		_capturedFrameStarts.push_back(toTraceTime(_frameStart));
+		_zones.push_back({ "Frame", toTraceTime(_frameStart), toTraceTime(frameEnd) - toTraceTime(_frameStart), currentThreadId() });
+	}
+}
+
+void Profiler::recordZone(const char* name, Clock::time_point start, Clock::time_point end)
+{
+	if (!isCapturing()) return;
+
+	const std::int64_t startUs = toTraceTime(start);
+	const Zone zone{ name, startUs, toTraceTime(end) - startUs, currentThreadId() };
+
+	std::lock_guard<std::mutex> lock(_captureMutex);
+	_zones.push_back(zone);
+}
+
+std::size_t Profiler::getHistorySize() const
+{
+	return _historySize;
+}
+
+const Profiler::Frame& Profiler::getHistoryFrame(std::size_t index) const
+{
+	const std::size_t oldest = (_historyHead + HISTORY_SIZE - _historySize) % HISTORY_SIZE;
+	return _history[(oldest + index) % HISTORY_SIZE];
+}
+
+const Profiler::Frame& Profiler::getLastFrame() const
+{
+	return _history[(_historyHead + HISTORY_SIZE - 1) % HISTORY_SIZE];
+}
+
+void Profiler::beginCapture()
+{
+	std::lock_guard<std::mutex> lock(_captureMutex);
+
+	_zones.clear();
+	_zones.reserve(ProfilerConstants::RESERVED_ZONES);
+	_capturedFrames.clear();
+	_capturedFrameStarts.clear();
+
+	_isCapturing.store(true, std::memory_order_relaxed);
+}
+
+bool Profiler::endCapture(const std::string& path)
+{
+	_isCapturing.store(false, std::memory_order_relaxed);
+
+	std::lock_guard<std::mutex> lock(_captureMutex);
+
+	std::ofstream file(path);
+	if (!file) return false;
+
+	file << "{\"traceEvents\":[\n";
+
+	bool first = true;
+	auto separator = [&file, &first]()
+		{
+			if (!first) file << ",\n";
+			first = false;
+		};
+
+	for (const auto& zone : _zones)
+	{
+		separator();
+		file << "{\"name\":\"" << zone.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << zone.threadId
+			<< ",\"ts\":" << zone.startUs << ",\"dur\":" << zone.durationUs << '}';
+	}
+
+	for (std::size_t i = 0; i < _capturedFrames.size(); ++i)
+	{
+		separator();
+		file << "{\"name\":\"counters\",\"ph\":\"C\",\"pid\":1,\"ts\":" << _capturedFrameStarts[i] << ",\"args\":{";
+
+		for (std::size_t counter = 0; counter < COUNTER_COUNT; ++counter)
+		{
+			if (counter > 0) file << ',';
+			file << '"' << getCounterName(static_cast<ProfilerCounter>(counter)) << "\":"
+				<< _capturedFrames[i].counters[counter];
+		}
+
+		file << "}}";
+	}
+
+	file << "\n]}\n";
+
+	return static_cast<bool>(file);
+}
+
+std::int64_t Profiler::toTraceTime(Clock::time_point time) const
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(time - _epoch).count();
+}
+
+std::uint32_t Profiler::currentThreadId()
+{
+	static std::atomic<std::uint32_t> nextId{ 1 };
+	thread_local const std::uint32_t id = nextId.fetch_add(1, std::memory_order_relaxed);
+
+	return id;
+}
\ No newline at end of file
@@ -0,0 +1,196 @@
+#include <Graphics/InterfaceElements/ProfilerOverlay.h>
+
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+
+ProfilerOverlay::ProfilerOverlay(const sf::Vector2f& size)
+	:_bars(sf::Triangles),
+	_isVisible(false),
+	_lastFrameIndex(0),
+	_lastLabelFrame(0)
+{
+	_font = FontCache::getInstance().acquireDefault(ProfilerOverlayConstants::CHARACTER_SIZE);
+
+	_background.setFillColor(sf::Color(0, 0, 0, 180));
+	_background.setOutlineThickness(1.f);
+	_background.setOutlineColor(sf::Color(255, 255, 255, 90));
+
+	_targetLine.setFillColor(sf::Color(255, 255, 255, 120));
+
+	_label.setFont(*_font);
+	_label.setCharacterSize(ProfilerOverlayConstants::CHARACTER_SIZE);
+	_label.setFillColor(sf::Color::White);
+
+	setSize(size);
+}
+
+void ProfilerOverlay::setVisible(bool visible)
+{
+	if (_isVisible == visible) return;
+
+	_isVisible = visible;
+	Profiler::getInstance().setEnabled(visible || Profiler::getInstance().isCapturing());
+	invalidateBounds();
+}
+
+bool ProfilerOverlay::isVisible() const
+{
+	return _isVisible;
+}
+
+void ProfilerOverlay::update()
+{
+	if (!_isVisible) return;
+
+	const Profiler& profiler = Profiler::getInstance();
+	if (profiler.getHistorySize() == 0) return;
+
+	const std::uint64_t frameIndex = profiler.getLastFrame().index;
+	if (frameIndex == _lastFrameIndex) return;
+
+	_lastFrameIndex = frameIndex;
+
+	_bars.clear();
+	forEachBar([this](const sf::FloatRect& bar, const sf::Color& color)
+		{
+			const sf::Vector2f topLeft(bar.left, bar.top);
+			const sf::Vector2f topRight(bar.left + bar.width, bar.top);
+			const sf::Vector2f bottomRight(bar.left + bar.width, bar.top + bar.height);
+			const sf::Vector2f bottomLeft(bar.left, bar.top + bar.height);
+
+			_bars.append(sf::Vertex(topLeft, color));
+			_bars.append(sf::Vertex(topRight, color));
+			_bars.append(sf::Vertex(bottomLeft, color));
+			_bars.append(sf::Vertex(bottomLeft, color));
+			_bars.append(sf::Vertex(topRight, color));
+			_bars.append(sf::Vertex(bottomRight, color));
+		});
+
+	if (frameIndex - _lastLabelFrame >= ProfilerOverlayConstants::LABEL_REFRESH_FRAMES)
+	{
+		_lastLabelFrame = frameIndex;
+		rebuildLabel();
+	}
+
+	invalidate();
+}
+
+void ProfilerOverlay::setPosition(const sf::Vector2f& pos)
+{
+	if (_background.getPosition() == pos) return;
+
+	_background.setPosition(pos);
+	_label.setPosition(pos.x + ProfilerOverlayConstants::PADDING, pos.y + ProfilerOverlayConstants::PADDING);
+
+	setSize(_background.getSize());
+}
+
+void ProfilerOverlay::setSize(const sf::Vector2f& size)
+{
+	_background.setSize(size);
+
+	const sf::Vector2f pos = _background.getPosition();
+	const float graphBottom = pos.y + size.y - ProfilerOverlayConstants::PADDING;
+	const float graphHeight = size.y * 0.5f;
+
+	// The line marks the frame budget, the graph top is twice the budget
+	_targetLine.setSize({ size.x - 2.f * ProfilerOverlayConstants::PADDING, 1.f });
+	_targetLine.setPosition(pos.x + ProfilerOverlayConstants::PADDING, graphBottom - graphHeight * 0.5f);
+
+	// Rebuild the bars for the new geometry on the next update
+	_lastFrameIndex = 0;
+	invalidateBounds();
+}
+
+void ProfilerOverlay::draw(sf::RenderTarget& target)
+{
+	if (!_isVisible) return;
+
+	target.draw(_background);
+	target.draw(_bars);
+	target.draw(_targetLine);
+	target.draw(_label);
+}
+
+void ProfilerOverlay::draw(BatchRenderer& renderer)
+{
+	if (!_isVisible) return;
+
+	// Drawn over the scene: a layer of its own keeps the text below it covered
+	renderer.flush();
+	renderer.addShape(_background);
+	forEachBar([&renderer](const sf::FloatRect& bar, const sf::Color& color)
+		{
+			renderer.addRect(bar, color);
+		});
+	renderer.addShape(_targetLine);
+	renderer.addText(_label);
+	renderer.flush();
+}
+
+DrawRecording ProfilerOverlay::prepareDraw()
+{
+	// Flushes the batches around its own geometry
+	return DrawRecording::Direct;
+}
+
+void ProfilerOverlay::handleEvent(const sf::RenderTarget&, const sf::Event&)
+{
+}
+
+bool ProfilerOverlay::acceptsInput() const
+{
+	return false;
+}
+
+sf::FloatRect ProfilerOverlay::getBounds() const
+{
+	return _isVisible ? _background.getGlobalBounds() : sf::FloatRect();
+}
+
+void ProfilerOverlay::forEachBar(const std::function<void(const sf::FloatRect&, const sf::Color&)>& callback) const
+{
+	const Profiler& profiler = Profiler::getInstance();
+
+	const sf::Vector2f pos = _background.getPosition();
+	const sf::Vector2f size = _background.getSize();
+
+	const float graphLeft = pos.x + ProfilerOverlayConstants::PADDING;
+	const float graphWidth = size.x - 2.f * ProfilerOverlayConstants::PADDING;
+	const float graphBottom = pos.y + size.y - ProfilerOverlayConstants::PADDING;
+	const float graphHeight = size.y * 0.5f;
+	const float barWidth = graphWidth / static_cast<float>(Profiler::HISTORY_SIZE);
+
+	const std::size_t count = profiler.getHistorySize();
+	const std::size_t firstSlot = Profiler::HISTORY_SIZE - count;
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const float frameMs = static_cast<float>(profiler.getHistoryFrame(i).durationMs);
+		const float ratio = std::min(frameMs / (2.f * ProfilerOverlayConstants::TARGET_FRAME_MS), 1.f);
+		const float height = std::max(ratio * graphHeight, 1.f);
+
+		sf::Color color = sf::Color(80, 200, 80);
+		if (frameMs > 2.f * ProfilerOverlayConstants::TARGET_FRAME_MS) color = sf::Color(220, 60, 60);
+		else if (frameMs > ProfilerOverlayConstants::TARGET_FRAME_MS) color = sf::Color(230, 200, 60);
+
+		callback({ graphLeft + static_cast<float>(firstSlot + i) * barWidth, graphBottom - height, barWidth, height }, color);
+	}
+}
+
+void ProfilerOverlay::rebuildLabel()
+{
+	const Profiler::Frame& frame = Profiler::getInstance().getLastFrame();
+
+	std::ostringstream stream;
+	stream << std::fixed << std::setprecision(2) << "frame " << frame.durationMs << " ms";
+
+	for (std::size_t i = 0; i < Profiler::COUNTER_COUNT; ++i)
+	{
+		stream << (i % 2 == 0 ? "\n" : "   ")
+			<< Profiler::getCounterName(static_cast<ProfilerCounter>(i)) << ": " << frame.counters[i];
+	}
+
+	_label.setString(stream.str());
+}
\ No newline at end of file
@@ -1,106 +1,248 @@
 #include <Graphics/InterfaceElements/ProgressBar.h>
 
-void ProgressBar::updateFill()
+#include <array>
+#include <cmath>
+#include <string>
+
+#include <Profiler.h>
+
+namespace
 {
-	float percentage = std::clamp(_currentValue / _maxValue, 0.f, 1.f);
-	sf::Vector2f newSize;
+	// The 101 labels a bar can show, built once and shared by every instance
+	const sf::String& percentageLabel(int percentage)
+	{
+		static const std::array<sf::String, 101> labels = []
+			{
+				std::array<sf::String, 101> result;
+				for (std::size_t i = 0; i < result.size(); ++i)
+				{
+					result[i] = std::to_string(i) + "%";
+				}
+				return result;
+			}();
+
+		return labels[static_cast<std::size_t>(std::clamp(percentage, 0, 100))];
+	}
+}
+
+sf::FloatRect ProgressBar::getInnerRect() const
+{
+	const float inset = std::min({ _borderThickness, _size.x / 2.f, _size.y / 2.f });
+	return { inset, inset, _size.x - 2.f * inset, _size.y - 2.f * inset };
+}
+
+sf::FloatRect ProgressBar::getFillSpan(float from, float to) const
+{
+	const sf::FloatRect inner = getInnerRect();
 
 	if (_isVertical)
 	{
-		newSize =
-		{
-			_background.getSize().x,
-			_background.getSize().y * percentage
-		};
-		_fill.setPosition(
-			_background.getPosition().x,
-			_background.getPosition().y + _background.getSize().y - newSize.y
-		);
+		return { inner.left, inner.top + inner.height - to, inner.width, to - from };
+	}
+
+	return { inner.left + from, inner.top, to - from, inner.height };
+}
+
+sf::Color ProgressBar::getFillColorAt(float y) const
+{
+	if (!_useGradient) return _fillColor;
+
+	// The gradient runs from the top edge of the inner area to the bottom one
+	const sf::FloatRect inner = getInnerRect();
+	return lerpColors(_gradientStart, _gradientEnd, inner.height > 0.f ? (y - inner.top) / inner.height : 0.f);
+}
+
+sf::Transform ProgressBar::getTransform() const
+{
+	sf::Transform transform;
+	transform.translate(_position);
+	return transform;
+}
+
+std::size_t ProgressBar::getDrawnVertexCount() const
+{
+	const std::size_t quads = 1 + _fillQuadCount + (_borderThickness > 0.f ? ProgressBarConstants::BORDER_QUADS : 0);
+	return quads * ProgressBarConstants::QUAD_VERTICES;
+}
+
+void ProgressBar::setQuad(std::size_t quad, const sf::FloatRect& rect, const sf::Color& top, const sf::Color& bottom)
+{
+	sf::Vertex* vertices = &_vertices[quad * ProgressBarConstants::QUAD_VERTICES];
+
+	const float right = rect.left + rect.width;
+	const float lower = rect.top + rect.height;
+
+	vertices[0] = sf::Vertex({ rect.left, rect.top }, top);
+	vertices[1] = sf::Vertex({ right, rect.top }, top);
+	vertices[2] = sf::Vertex({ rect.left, lower }, bottom);
+	vertices[3] = vertices[2];
+	vertices[4] = vertices[1];
+	vertices[5] = sf::Vertex({ right, lower }, bottom);
+}
+
+void ProgressBar::rebuildVertices()
+{
+	const sf::FloatRect inner = getInnerRect();
+	const float length = _isVertical ? inner.height : inner.width;
+
+	_fillQuadCount = 1;
+	if (_segmentCount > 0)
+	{
+		_fillQuadCount = _segmentCount;
 	}
-	else {
-		newSize =
+	else if (_stripeWidth > 0.f)
+	{
+		_fillQuadCount += static_cast<std::size_t>(std::ceil(length / (2.f * _stripeWidth)));
+	}
+
+	_vertices.setPrimitiveType(sf::Triangles);
+	_vertices.resize((1 + _fillQuadCount + ProgressBarConstants::BORDER_QUADS) * ProgressBarConstants::QUAD_VERTICES);
+
+	// Skinned parts keep their quads, collapsed, so the layout never depends on the skins
+	setQuad(0, _backgroundSkin ? sf::FloatRect() : inner, _backgroundColor, _backgroundColor);
+
+	const std::size_t border = 1 + _fillQuadCount;
+	const float thickness = inner.left;
+
+	setQuad(border, { 0.f, 0.f, _size.x, thickness }, _borderColor, _borderColor);
+	setQuad(border + 1, { 0.f, _size.y - thickness, _size.x, thickness }, _borderColor, _borderColor);
+	setQuad(border + 2, { 0.f, thickness, thickness, inner.height }, _borderColor, _borderColor);
+	setQuad(border + 3, { _size.x - thickness, thickness, thickness, inner.height }, _borderColor, _borderColor);
+
+	updateFill();
+}
+
+void ProgressBar::updateFill()
+{
+	const ScopedTimer timer("ProgressBar::updateFill");
+	Profiler::getInstance().increment(ProfilerCounter::FillUpdates);
+
+	const sf::FloatRect inner = getInnerRect();
+	const float length = _isVertical ? inner.height : inner.width;
+	const float extent = length * std::clamp(_currentValue / _maxValue, 0.f, 1.f);
+
+	_fillRect = getFillSpan(0.f, extent);
+
+	const float segment = _segmentCount > 0
+		? std::max(0.f, (length - _segmentGap * static_cast<float>(_segmentCount - 1)) / static_cast<float>(_segmentCount))
+		: 0.f;
+
+	for (std::size_t i = 0; i < _fillQuadCount; ++i)
+	{
+		const bool isStripe = _segmentCount == 0 && i > 0;
+		float from = 0.f;
+		float to = extent;
+
+		if (_segmentCount > 0)
 		{
-			_background.getSize().x * percentage,
-			_background.getSize().y
-		};
-		_fill.setPosition(_background.getPosition());
+			from = std::min(static_cast<float>(i) * (segment + _segmentGap), extent);
+			to = std::min(from + segment, extent);
+		}
+		else if (isStripe)
+		{
+			from = std::min(static_cast<float>(2 * i - 1) * _stripeWidth, extent);
+			to = std::min(from + _stripeWidth, extent);
+		}
+
+		const sf::FloatRect rect = _fillSkin ? sf::FloatRect() : getFillSpan(from, to);
+
+		if (isStripe)
+		{
+			setQuad(1 + i, rect, _stripeColor, _stripeColor);
+		}
+		else
+		{
+			setQuad(1 + i, rect, getFillColorAt(rect.top), getFillColorAt(rect.top + rect.height));
+		}
 	}
 
-	_fill.setSize(newSize);
+	_isBufferStale = true;
 
 	if (_showText)
 	{
-		_text.setString(std::to_string(static_cast<int>(percentage * 100)) + "%");
+		updatePercentageText();
 		updateTextPosition();
 	}
-	if (_useGradient)
-	{
-		sf::Vector2f size = _fill.getSize();
-		_gradientVertices[0].position = sf::Vector2f(0, 0);
-		_gradientVertices[1].position = sf::Vector2f(size.x, 0);
-		_gradientVertices[2].position = sf::Vector2f(size.x, size.y);
-		_gradientVertices[3].position = sf::Vector2f(0, size.y);
-	}
+
+	invalidate();
 }
 
-void ProgressBar::update(float deltaTime)
+bool ProgressBar::refreshStaticBuffer()
 {
-	if (_smoothness > 0.f &&
-		std::abs(_currentValue - _targetValue) > 0.01f)
+	if (!_staticBuffer) return false;
+	if (!_isBufferStale) return true;
+
+	if (_staticBuffer->getVertexCount() != _vertices.getVertexCount()
+		&& !_staticBuffer->create(_vertices.getVertexCount()))
 	{
-		_currentValue = std::lerp(_currentValue, _targetValue, _smoothness * deltaTime);
-		updateFill();
+		return false;
 	}
+
+	_isBufferStale = !_staticBuffer->update(&_vertices[0]);
+	return !_isBufferStale;
+}
+
+void ProgressBar::animateValue()
+{
+	AnimationScheduler::getInstance().tween(this, 0, _currentValue, _targetValue,
+		ProgressBarConstants::MAX_SMOOTH_SECONDS * _smoothness, Easing::OutCubic,
+		[this](float value)
+		{
+			_currentValue = value;
+			updateFill();
+		});
 }
 
 ProgressBar::ProgressBar(const sf::Vector2f& size,
 	const sf::Color& bgColor,
 	const sf::Color& fillColor)
-	:_maxValue(100.f),
-	_currentValue(0.f),
-	_targetValue(0.f),
-	_isVertical(false),
-	_smoothness(0.f),
-	_showText(false)
-{
-	_background.setSize(size);
-	_background.setFillColor(bgColor);
-	_background.setOutlineThickness(0.f);
-
-	_fill.setSize({ 0.f, size.y });
-	_fill.setFillColor(fillColor);
-	_fill.setPosition(0.f, 0.f);
-
-	_text.setString("0%");
+	:_size(size),
+	_backgroundColor(bgColor),
+	_fillColor(fillColor)
+{
+	// Sized for the longest label first; later labels reuse the storage instead of allocating
+	_text.setString(percentageLabel(100));
+	_text.reserve(_text.getString().getSize());
+	_text.setString(percentageLabel(0));
 	_text.setCharacterSize(16);
 	_text.setFillColor(sf::Color::White);
 
-	updateTextPosition();
-
-	_border.setSize(size);
-	_border.setFillColor(sf::Color::Transparent);
-	_border.setOutlineThickness(0.f);
-	_border.setOutlineColor(sf::Color::White);
+	rebuildVertices();
 }
 
 ProgressBar::ProgressBar(ProgressBar&& other)
-	:_gradientVertices(std::move(other._gradientVertices)),
-	_background(std::move(other._background)),
-	_fill(std::move(other._fill)),
-	_border(std::move(other._border)),
+	:_vertices(std::move(other._vertices)),
+	_fillQuadCount(other._fillQuadCount),
+	_staticBuffer(std::move(other._staticBuffer)),
+	_isBufferStale(other._isBufferStale),
+	_position(other._position),
+	_size(other._size),
+	_fillRect(other._fillRect),
+	_backgroundColor(other._backgroundColor),
+	_fillColor(other._fillColor),
+	_gradientStart(other._gradientStart),
+	_gradientEnd(other._gradientEnd),
+	_borderColor(other._borderColor),
+	_borderThickness(other._borderThickness),
+	_segmentCount(other._segmentCount),
+	_segmentGap(other._segmentGap),
+	_stripeWidth(other._stripeWidth),
+	_stripeColor(other._stripeColor),
+	_backgroundSkin(other._backgroundSkin),
+	_fillSkin(other._fillSkin),
 	_text(std::move(other._text)),
-	_font(other._font),
+	_font(std::move(other._font)),
+	_displayedPercent(other._displayedPercent),
 	_maxValue(other._maxValue),
 	_currentValue(other._currentValue),
 	_targetValue(other._targetValue),
 	_smoothness(other._smoothness),
 	_isVertical(other._isVertical),
-	_showBorder(other._showBorder),
 	_showText(other._showText),
 	_useGradient(other._useGradient),
+	_isStatic(other._isStatic),
 	_isDragging(other._isDragging),
 	_isEnabled(other._isEnabled),
-	_gradientFill(std::move(other._gradientFill)),
 	_onComplete(std::move(other._onComplete)),
 	_lastClickTime(other._lastClickTime),
 	_clickDelay(other._clickDelay)
@@ -110,36 +252,67 @@ ProgressBar::ProgressBar(ProgressBar&& other)
 	other._targetValue = 0;
 	other._smoothness = 0;
 	other._isVertical = false;
-	other._showBorder = false;
 	other._showText = true;
 	other._useGradient = false;
+	other._isStatic = false;
 	other._isDragging = false;
 	other._isEnabled = true;
 
+	// A running tween points at the source; carry on from the copied value instead
+	AnimationScheduler::getInstance().cancel(&other);
+	if (_currentValue != _targetValue) animateValue();
+
+	// Same for an update queued by another thread
+	UpdateQueue::getInstance().discard(static_cast<Widget*>(&other));
+	if (other._hasPostedValue.exchange(false)) postValue(other._postedValue.load());
+}
+
+ProgressBar::~ProgressBar()
+{
+	AnimationScheduler::getInstance().cancel(this);
 }
 
 ProgressBar& ProgressBar::operator=(ProgressBar&& other)
 {
 	if (this != &other)
 	{
-		_gradientVertices = std::move(other._gradientVertices);
-		_background = std::move(other._background);
-		_fill = std::move(other._fill);
-		_border = std::move(other._border);
+		AnimationScheduler::getInstance().cancel(this);
+		UpdateQueue::getInstance().discard(static_cast<Widget*>(this));
+		_hasPostedValue.store(false);
+
+		_vertices = std::move(other._vertices);
+		_fillQuadCount = other._fillQuadCount;
+		_staticBuffer = std::move(other._staticBuffer);
+		_isBufferStale = other._isBufferStale;
+		_position = other._position;
+		_size = other._size;
+		_fillRect = other._fillRect;
+		_backgroundColor = other._backgroundColor;
+		_fillColor = other._fillColor;
+		_gradientStart = other._gradientStart;
+		_gradientEnd = other._gradientEnd;
+		_borderColor = other._borderColor;
+		_borderThickness = other._borderThickness;
+		_segmentCount = other._segmentCount;
+		_segmentGap = other._segmentGap;
+		_stripeWidth = other._stripeWidth;
+		_stripeColor = other._stripeColor;
+		_backgroundSkin = other._backgroundSkin;
+		_fillSkin = other._fillSkin;
 		_text = std::move(other._text);
-		_font = other._font;
+		_font = std::move(other._font);
+		_displayedPercent = other._displayedPercent;
 
 		_maxValue = other._maxValue;
 		_currentValue = other._currentValue;
 		_targetValue = other._targetValue;
 		_smoothness = other._smoothness;
 		_isVertical = other._isVertical;
-		_showBorder = other._showBorder;
 		_showText = other._showText;
 		_useGradient = other._useGradient;
+		_isStatic = other._isStatic;
 		_isDragging = other._isDragging;
 		_isEnabled = other._isEnabled;
-		_gradientFill = std::move(other._gradientFill);
 		_onComplete = std::move(other._onComplete);
 		_lastClickTime = other._lastClickTime;
 		_clickDelay = other._clickDelay;
@@ -149,11 +322,17 @@ ProgressBar& ProgressBar::operator=(ProgressBar&& other)
 		other._targetValue = 0;
 		other._smoothness = 0;
 		other._isVertical = false;
-		other._showBorder = false;
 		other._showText = true;
 		other._useGradient = false;
+		other._isStatic = false;
 		other._isDragging = false;
 		other._isEnabled = true;
+
+		AnimationScheduler::getInstance().cancel(&other);
+		if (_currentValue != _targetValue) animateValue();
+
+		UpdateQueue::getInstance().discard(static_cast<Widget*>(&other));
+		if (other._hasPostedValue.exchange(false)) postValue(other._postedValue.load());
 	}
 	return *this;
 }
@@ -166,23 +345,56 @@ void ProgressBar::setValue(float value)
 
 	float newValue = std::clamp(value, 0.f, _maxValue);
 
-	if (std::abs(_currentValue - newValue) > std::numeric_limits<float>::epsilon())
+	if (std::abs(_targetValue - newValue) > std::numeric_limits<float>::epsilon())
 	{
-		_currentValue = newValue;
-		updateFill();
+		_targetValue = newValue;
+
+		if (_smoothness > 0.f)
+		{
+			animateValue();
+		}
+		else
+		{
+			_currentValue = newValue;
+			updateFill();
+		}
 
 		if (_onValueChanged)
 		{
-			_onValueChanged(_currentValue);
+			_onValueChanged(_targetValue);
 		}
 
-		if (_currentValue >= _maxValue - std::numeric_limits<float>::epsilon() && _onComplete)
+		if (_targetValue >= _maxValue - std::numeric_limits<float>::epsilon() && _onComplete)
 		{
 			_onComplete();
 		}
 	}
 }
 
+bool ProgressBar::postValue(float value)
+{
+	if (!std::isfinite(value)) {
+		throw std::invalid_argument("Progress value must be finite");
+	}
+
+	_postedValue.store(value);
+
+	// One queued update per bar no matter how often workers post; it reads the latest value when drained
+	if (_hasPostedValue.exchange(true)) return true;
+
+	if (postUpdate([this] { applyPostedValue(); })) return true;
+
+	_hasPostedValue.store(false);
+	return false;
+}
+
+void ProgressBar::applyPostedValue()
+{
+	// Cleared before reading, so a value posted meanwhile queues a fresh update
+	_hasPostedValue.store(false);
+	setValue(_postedValue.load());
+}
+
 void ProgressBar::setMaxValue(float maxValue)
 {
 	if (maxValue <= std::numeric_limits<float>::epsilon()) {
@@ -192,86 +404,49 @@ void ProgressBar::setMaxValue(float maxValue)
 	if (std::abs(_maxValue - maxValue) > std::numeric_limits<float>::epsilon()) {
 		_maxValue = maxValue;
 		_currentValue = std::min(_currentValue, _maxValue);
+		_targetValue = std::min(_targetValue, _maxValue);
 		updateFill();
 	}
 }
 
 void ProgressBar::setOrientation(bool isVertical)
 {
-	if (_isVertical != isVertical)
-	{
-		_isVertical = isVertical;
+	if (_isVertical == isVertical) return;
 
-		float progress = getPercentage() / 100.f;
+	_isVertical = isVertical;
+	_size = { _size.y, _size.x };
 
-		sf::Vector2f newSize = _background.getSize();
-		if (_isVertical)
-		{
-			newSize = { newSize.y, newSize.x };
-		}
-
-		_background.setSize(newSize);
-		updateFill();
-	}
+	rebuildVertices();
+	invalidateBounds();
 }
 
 void ProgressBar::setPosition(const sf::Vector2f& pos)
 {
-	_background.setPosition(pos);
+	if (_position == pos) return;
 
-	if (_isVertical)
-	{
-		_fill.setPosition(
-			pos.x,
-			pos.y + _background.getSize().y - _fill.getSize().y
-		);
-	}
-	else
-	{
-		_fill.setPosition(pos);
-	}
+	// The geometry is local; only the transform and the label follow
+	_position = pos;
+	updateTextPosition();
+
+	invalidateBounds();
+}
 
-	_border.setPosition(pos);
+void ProgressBar::setSize(const sf::Vector2f& size)
+{
+	if (size.x <= 0 || size.y <= 0 || _size == size) return;
 
-	if (_showText)
-	{
-		updateTextPosition();
-	}
+	_size = size;
+
+	rebuildVertices();
+	invalidateBounds();
 }
 
 void ProgressBar::enableBorder(bool enable, const sf::Color& color, float thickness)
 {
-	if (enable)
-	{
-		_border.setOutlineColor(color);
-		_border.setOutlineThickness(thickness);
-
-		_border.setSize(_background.getSize());
-		_border.setPosition(_background.getPosition());
-
-		_background.setSize({
-			_background.getSize().x - 2 * thickness,
-			_background.getSize().y - 2 * thickness
-			});
-		_background.setPosition(
-			_background.getPosition().x + thickness,
-			_background.getPosition().y + thickness
-		);
-	}
-	else
-	{
-		_border.setOutlineThickness(0.f);
-		_background.setSize({
-			_background.getSize().x + 2 * _border.getOutlineThickness(),
-			_background.getSize().y + 2 * _border.getOutlineThickness()
-			});
-		_background.setPosition(
-			_background.getPosition().x - _border.getOutlineThickness(),
-			_background.getPosition().y - _border.getOutlineThickness()
-		);
-	}
+	_borderColor = color;
+	_borderThickness = enable ? std::max(thickness, 0.f) : 0.f;
 
-	updateFill();
+	rebuildVertices();
 }
 
 void ProgressBar::setSmoothness(float smoothness)
@@ -279,6 +454,7 @@ void ProgressBar::setSmoothness(float smoothness)
 	_smoothness = std::clamp(smoothness, 0.0f, 1.0f);
 
 	if (_smoothness <= 0.01f) {
+		AnimationScheduler::getInstance().cancel(this);
 		_currentValue = _targetValue;
 		updateFill();
 	}
@@ -286,36 +462,57 @@ void ProgressBar::setSmoothness(float smoothness)
 
 void ProgressBar::setFillGradient(const sf::Color& start, const sf::Color& end)
 {
-	_gradientVertices.clear();
+	_gradientStart = start;
+	_gradientEnd = end;
+	_useGradient = true;
 
-	_gradientVertices.append(sf::Vertex(
-		sf::Vector2f(0, 0),
-		start
-	));
+	updateFill();
+}
 
-	_gradientVertices.append(sf::Vertex(
-		sf::Vector2f(_background.getSize().x, 0),
-		start
-	));
+void ProgressBar::setSegments(unsigned int count, float gap)
+{
+	_segmentCount = count;
+	_segmentGap = std::max(gap, 0.f);
+	if (count > 0) _stripeWidth = 0.f;
 
-	_gradientVertices.append(sf::Vertex(
-		sf::Vector2f(_background.getSize().x, _background.getSize().y),
-		end
-	));
+	rebuildVertices();
+}
 
-	_gradientVertices.append(sf::Vertex(
-		sf::Vector2f(0, _background.getSize().y),
-		end
-	));
+void ProgressBar::setStripes(float width, const sf::Color& color)
+{
+	_stripeWidth = std::max(width, 0.f);
+	_stripeColor = color;
+	if (_stripeWidth > 0.f) _segmentCount = 0;
 
-	_useGradient = true;
+	rebuildVertices();
+}
 
-	updateFill();
+void ProgressBar::setStatic(bool isStatic)
+{
+	_isStatic = isStatic && sf::VertexBuffer::isAvailable();
+
+	if (_isStatic && !_staticBuffer)
+	{
+		_staticBuffer = std::make_unique<sf::VertexBuffer>(sf::Triangles, sf::VertexBuffer::Static);
+	}
+	else if (!_isStatic)
+	{
+		_staticBuffer.reset();
+	}
+
+	_isBufferStale = true;
 }
 
-sf::Color ProgressBar::lerpColors(const sf::Color& a, const sf::Color& b, float t)
+sf::Color ProgressBar::lerpColors(const sf::Color& a, const sf::Color& b, float t) const
 {
-	return sf::Color();
+	t = std::clamp(t, 0.f, 1.f);
+
+	auto channel = [t](sf::Uint8 from, sf::Uint8 to)
+		{
+			return static_cast<sf::Uint8>(std::lround(from + (to - from) * t));
+		};
+
+	return sf::Color(channel(a.r, b.r), channel(a.g, b.g), channel(a.b, b.b), channel(a.a, b.a));
 }
 
 float ProgressBar::getPercentage() const
@@ -331,32 +528,52 @@ void ProgressBar::updateTextPosition()
 	_text.setOrigin(textBounds.left + textBounds.width / 2.0f,
 		textBounds.top + textBounds.height / 2.0f);
 
-	sf::Vector2f center = {
-		_background.getPosition().x + _background.getSize().x / 2.0f,
-		_background.getPosition().y + _background.getSize().y / 2.0f
-	};
-
-	_text.setPosition(center);
+	const sf::FloatRect inner = getInnerRect();
+	_text.setPosition(_position + sf::Vector2f(inner.left + inner.width / 2.0f, inner.top + inner.height / 2.0f));
 }
 
 void ProgressBar::updatePercentageText()
 {
 	if (!_showText) return;
 
-	int percentage = static_cast<int>(std::round((_currentValue / _maxValue) * 100));
-	_text.setString(std::to_string(percentage) + "%");
+	// Smoothing moves the value every frame, the label only changes with the whole percent
+	const int percentage = static_cast<int>(std::round(std::clamp(_currentValue / _maxValue, 0.f, 1.f) * 100));
+	if (percentage == _displayedPercent) return;
+
+	_displayedPercent = percentage;
+	_text.setString(percentageLabel(percentage));
 }
 
 void ProgressBar::showPercentage(bool show, const sf::Font& font, unsigned int charSize)
+{
+	// The caller's font replaces the shared default, also when the label is hidden for now
+	_font.reset();
+	_text.setFont(font);
+
+	setPercentageVisible(show, charSize);
+}
+
+void ProgressBar::showPercentage(bool show, unsigned int charSize)
+{
+	if (show)
+	{
+		_font = FontCache::getInstance().acquireDefault(charSize);
+		_text.setFont(_font);
+	}
+
+	setPercentageVisible(show, charSize);
+}
+
+void ProgressBar::setPercentageVisible(bool show, unsigned int charSize)
 {
 	_showText = show;
+	_displayedPercent = -1;
 
 	if (_showText)
 	{
-		_text.setFont(font);
 		_text.setCharacterSize(charSize);
 
-		const sf::Color bgColor = _background.getFillColor();
+		const sf::Color bgColor = _backgroundColor;
 		_text.setFillColor(
 			(bgColor.r + bgColor.g + bgColor.b > 384) ?
 			sf::Color::Black : sf::Color::White
@@ -369,11 +586,13 @@ void ProgressBar::showPercentage(bool show, const sf::Font& font, unsigned int c
 	{
 		_text.setString("");
 	}
+
+	invalidate();
 }
 
 void ProgressBar::updateProgressFromMouse(const sf::Vector2f& mousePos)
 {
-	const sf::FloatRect bounds = _background.getGlobalBounds();
+	const sf::FloatRect bounds = getTransform().transformRect(getInnerRect());
 	float progress = 0.f;
 
 	if (_isVertical)
@@ -392,37 +611,90 @@ void ProgressBar::updateProgressFromMouse(const sf::Vector2f& mousePos)
 	if (_onValueChanged) _onValueChanged(_currentValue);
 }
 
-void ProgressBar::draw(sf::RenderWindow& window)
+void ProgressBar::setSkin(const AtlasRegion* background, const AtlasRegion* fill)
+{
+	_backgroundSkin = background;
+	_fillSkin = fill;
+
+	rebuildVertices();
+}
+
+void ProgressBar::draw(sf::RenderTarget& target)
 {
-	window.draw(_background);
-	window.draw(_fill);
+	const sf::RenderStates states(getTransform());
+
+	if (_backgroundSkin)
+	{
+		_backgroundSkin->draw(target, getInnerRect(), _backgroundColor, states.transform);
+	}
 
-	if (_useGradient)
+	if (_isStatic && refreshStaticBuffer())
 	{
-		// window.transform = _fill.getTransform();
-		window.draw(_gradientVertices);
+		target.draw(*_staticBuffer, 0, getDrawnVertexCount(), states);
 	}
 	else
 	{
-		window.draw(_fill);
+		target.draw(&_vertices[0], getDrawnVertexCount(), sf::Triangles, states);
+	}
+
+	if (_fillSkin)
+	{
+		_fillSkin->draw(target, _fillRect, _fillColor, states.transform);
 	}
 
-	if (_border.getOutlineThickness() > 0.f)
+	if (_showText)
+	{
+		_text.draw(target);
+	}
+}
+
+void ProgressBar::draw(BatchRenderer& renderer)
+{
+	const sf::Transform transform = getTransform();
+
+	if (_backgroundSkin)
+	{
+		renderer.addRegion(*_backgroundSkin, getInnerRect(), _backgroundColor, transform);
+	}
+
+	// The batch merges the bar with its neighbours, so the static buffer isn't used here
+	renderer.addTriangles(&_vertices[0], getDrawnVertexCount(), transform);
+
+	if (_fillSkin)
 	{
-		window.draw(_border);
+		renderer.addRegion(*_fillSkin, _fillRect, _fillColor, transform);
 	}
 
 	if (_showText)
 	{
-		window.draw(_text);
+		_text.draw(renderer);
 	}
 }
 
-void ProgressBar::handleEvent(const sf::RenderWindow& window, const sf::Event& event)
+DrawRecording ProgressBar::prepareDraw()
 {
-	const auto mousePos = window.mapPixelToCoords(sf::Mouse::getPosition(window));
+	// Geometry and label are rebuilt when the value changes, not when drawn
+	return DrawRecording::AnyThread;
+}
+
+sf::FloatRect ProgressBar::getBounds() const
+{
+	sf::FloatRect bounds(_position, _size);
+
+	if (_showText)
+	{
+		bounds = uniteBounds(bounds, _text.getGlobalBounds());
+	}
+
+	return bounds;
+}
 
-	const bool isHovered = _background.getGlobalBounds().contains(mousePos);
+void ProgressBar::handleEvent(const sf::RenderTarget& target, const sf::Event& event)
+{
+	sf::Vector2f mousePos;
+	if (!getEventPosition(target, event, mousePos)) return;
+
+	const bool isHovered = getTransform().transformRect(getInnerRect()).contains(mousePos);
 
 	if (event.type == sf::Event::MouseButtonPressed)
 	{
@@ -449,4 +721,4 @@ void ProgressBar::handleEvent(const sf::RenderWindow& window, const sf::Event& e
 	{
 		updateProgressFromMouse(mousePos);
 	}
-}
+}
\ No newline at end of file
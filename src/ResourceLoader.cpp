@@ -0,0 +1,146 @@
+#include <ResourceLoader.h>
+
+#include <algorithm>
+
+#include <SFML/Graphics/Image.hpp>
+
+#include <Exceptions.h>
+#include <FontCache.h>
+#include <Profiler.h>
+
+ResourceLoader::ResourceLoader(std::size_t threadCount)
+{
+	_threads.reserve(std::max<std::size_t>(threadCount, 1));
+
+	for (std::size_t i = 0; i < std::max<std::size_t>(threadCount, 1); ++i)
+	{
+		_threads.emplace_back([this](std::stop_token stopToken)
+			{
+				work(stopToken);
+			});
+	}
+}
+
+ResourceLoader::~ResourceLoader()
+{
+	_isStopping.store(true, std::memory_order_release);
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_jobs.clear();
+	}
+
+	for (std::jthread& thread : _threads) thread.request_stop();
+	_threads.clear();
+
+	UpdateQueue::getInstance().discard(this);
+}
+
+ResourceHandle<const sf::Font> ResourceLoader::loadFont(const std::string& path)
+{
+	return load<const sf::Font>(path, [path]()
+		{
+			return FontCache::getInstance().prefetch(path);
+		});
+}
+
+ResourceHandle<const sf::Texture> ResourceLoader::loadTexture(const std::string& path)
+{
+	auto promise = std::make_shared<std::promise<std::shared_ptr<const sf::Texture>>>();
+	ResourceHandle<const sf::Texture> handle(promise->get_future().share(), path);
+
+	enqueue(path, [this, promise, path](const Finish& finish)
+		{
+			// Decoding needs no graphics context and is the slow part; the upload waits for the UI thread
+			auto image = std::make_shared<sf::Image>();
+			if (!image->loadFromFile(path))
+			{
+				promise->set_exception(std::make_exception_ptr(FileLoadException(path)));
+				finish(false);
+				return;
+			}
+
+			postToUi([promise, image, finish, path]()
+				{
+					auto texture = std::make_shared<sf::Texture>();
+					if (!texture->loadFromImage(*image))
+					{
+						promise->set_exception(std::make_exception_ptr(FileLoadException(path)));
+						finish(false);
+						return;
+					}
+
+					promise->set_value(std::move(texture));
+					finish(true);
+				});
+		});
+
+	return handle;
+}
+
+float ResourceLoader::getProgress() const
+{
+	const std::size_t queued = getQueuedCount();
+	return queued ? static_cast<float>(getFinishedCount()) / static_cast<float>(queued) : 1.f;
+}
+
+std::vector<ResourceLoader::Timing> ResourceLoader::getTimings() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _timings;
+}
+
+void ResourceLoader::enqueue(const std::string& path, Job job)
+{
+	// Counted first so the finished count never runs ahead of it
+	_queued.fetch_add(1, std::memory_order_release);
+
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_jobs.push_back({ path, std::move(job), Clock::now() });
+	}
+
+	_hasJobs.notify_one();
+}
+
+void ResourceLoader::work(std::stop_token stopToken)
+{
+	while (true)
+	{
+		Queued queued;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			if (!_hasJobs.wait(lock, stopToken, [this]() { return !_jobs.empty(); })) return;
+
+			queued = std::move(_jobs.front());
+			_jobs.pop_front();
+		}
+
+		ScopedTimer timer("ResourceLoader::load");
+		const Clock::time_point startedAt = Clock::now();
+
+		queued.job([this, path = queued.path, queuedAt = queued.queuedAt, startedAt](bool isLoaded)
+			{
+				const Clock::time_point finishedAt = Clock::now();
+				{
+					std::lock_guard<std::mutex> lock(_mutex);
+					_timings.push_back({ path,
+						std::chrono::duration_cast<std::chrono::microseconds>(startedAt - queuedAt),
+						std::chrono::duration_cast<std::chrono::microseconds>(finishedAt - startedAt),
+						isLoaded });
+				}
+
+				_finished.fetch_add(1, std::memory_order_release);
+			});
+	}
+}
+
+void ResourceLoader::postToUi(UpdateQueue::Command command)
+{
+	// The UI thread drains every frame, so a full queue only means waiting a frame
+	while (!UpdateQueue::getInstance().post(this, command))
+	{
+		if (_isStopping.load(std::memory_order_acquire)) return;
+		std::this_thread::yield();
+	}
+}
\ No newline at end of file
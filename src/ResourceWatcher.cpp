@@ -0,0 +1,276 @@
+#include <ResourceWatcher.h>
+
+#include <algorithm>
+#include <exception>
+
+#ifdef __linux__
+#include <poll.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#include <sys/eventfd.h>
+#endif
+
+ResourceWatcher::ResourceWatcher(ErrorHandler onError)
+	:_onError(std::move(onError))
+{
+#ifdef __linux__
+	_notifier = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	_wakeUp = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+	// Without both, fall back to polling
+	if (_notifier < 0 || _wakeUp < 0)
+	{
+		if (_notifier >= 0) ::close(_notifier);
+		if (_wakeUp >= 0) ::close(_wakeUp);
+
+		_notifier = -1;
+		_wakeUp = -1;
+	}
+#endif
+}
+
+ResourceWatcher::~ResourceWatcher()
+{
+	stop();
+
+#ifdef __linux__
+	if (_notifier >= 0) ::close(_notifier);
+	if (_wakeUp >= 0) ::close(_wakeUp);
+#endif
+
+	UpdateQueue::getInstance().discard(this);
+}
+
+void ResourceWatcher::watch(const std::string& path, Reload reload)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	auto [found, isNew] = _entries.try_emplace(path);
+	Entry& entry = found->second;
+	entry.reload = std::move(reload);
+
+	if (!isNew) return;
+
+	const std::filesystem::path file(path);
+	entry.fileName = file.filename().string();
+	readStamp(path, entry.time, entry.size);
+
+#ifdef __linux__
+	if (_notifier >= 0)
+	{
+		const std::filesystem::path directory = file.has_parent_path() ? file.parent_path() : std::filesystem::path(".");
+
+		// Watching the same directory twice returns the same descriptor
+		entry.descriptor = ::inotify_add_watch(_notifier, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+	}
+#endif
+}
+
+void ResourceWatcher::unwatch(const std::string& path)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	auto found = _entries.find(path);
+	if (found == _entries.end()) return;
+
+	const int descriptor = found->second.descriptor;
+	_entries.erase(found);
+
+#ifdef __linux__
+	const bool isShared = std::any_of(_entries.begin(), _entries.end(),
+		[descriptor](const auto& entry) { return entry.second.descriptor == descriptor; });
+
+	if (descriptor >= 0 && !isShared) ::inotify_rm_watch(_notifier, descriptor);
+#else
+	(void)descriptor;
+#endif
+}
+
+void ResourceWatcher::start()
+{
+	if (isRunning()) return;
+
+#ifdef __linux__
+	// Forget the wake-up left by the previous stop()
+	std::uint64_t count = 0;
+	if (_wakeUp >= 0) while (::read(_wakeUp, &count, sizeof(count)) > 0) {}
+#endif
+
+	_thread = std::jthread([this](std::stop_token stopToken)
+		{
+			run(stopToken);
+		});
+}
+
+void ResourceWatcher::stop()
+{
+	if (!isRunning()) return;
+
+	_thread.request_stop();
+	_thread.join();
+}
+
+std::size_t ResourceWatcher::getWatchedCount() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _entries.size();
+}
+
+void ResourceWatcher::run(std::stop_token stopToken)
+{
+#ifdef __linux__
+	std::stop_callback wakeUp(stopToken, [this]()
+		{
+			const std::uint64_t one = 1;
+			if (_wakeUp >= 0) (void)::write(_wakeUp, &one, sizeof(one));
+		});
+#endif
+
+	std::vector<std::string> candidates;
+
+	while (!stopToken.stop_requested())
+	{
+		candidates.clear();
+
+		if (waitForChanges(stopToken, candidates))
+		{
+			reloadChanged(stopToken, candidates);
+		}
+	}
+}
+
+bool ResourceWatcher::waitForChanges(std::stop_token stopToken, std::vector<std::string>& candidates)
+{
+#ifdef __linux__
+	if (isNotifying())
+	{
+		pollfd descriptors[2] = { { _notifier, POLLIN, 0 }, { _wakeUp, POLLIN, 0 } };
+
+		if (::poll(descriptors, 2, -1) <= 0 || descriptors[1].revents) return false;
+
+		readEvents(candidates);
+
+		// Let the writer finish: keep collecting until the files have been quiet for a moment
+		const int settleTime = static_cast<int>(ResourceWatcherConstants::SETTLE_TIME.count());
+		while (::poll(descriptors, 2, settleTime) > 0)
+		{
+			if (descriptors[1].revents) return false;
+			readEvents(candidates);
+		}
+
+		std::sort(candidates.begin(), candidates.end());
+		candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+		return !candidates.empty();
+	}
+#endif
+
+	std::unique_lock<std::mutex> lock(_mutex);
+
+	if (_pollWait.wait_for(lock, stopToken, ResourceWatcherConstants::POLL_INTERVAL, []() { return false; })
+		|| stopToken.stop_requested())
+	{
+		return false;
+	}
+
+	// Every file is a candidate; the stamps decide
+	for (const auto& [path, entry] : _entries) candidates.push_back(path);
+
+	return !candidates.empty();
+}
+
+void ResourceWatcher::readEvents(std::vector<std::string>& candidates)
+{
+#ifdef __linux__
+	alignas(inotify_event) char buffer[4096];
+
+	ssize_t length = 0;
+	while ((length = ::read(_notifier, buffer, sizeof(buffer))) > 0)
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		for (const char* it = buffer; it < buffer + length;)
+		{
+			const inotify_event* event = reinterpret_cast<const inotify_event*>(it);
+			it += sizeof(inotify_event) + event->len;
+
+			const bool isOverflow = event->mask & IN_Q_OVERFLOW;
+
+			for (const auto& [path, entry] : _entries)
+			{
+				if (isOverflow || (event->len && entry.descriptor == event->wd && entry.fileName == event->name))
+				{
+					candidates.push_back(path);
+				}
+			}
+		}
+	}
+#else
+	(void)candidates;
+#endif
+}
+
+void ResourceWatcher::reloadChanged(std::stop_token stopToken, const std::vector<std::string>& candidates)
+{
+	for (const std::string& path : candidates)
+	{
+		if (stopToken.stop_requested()) return;
+
+		Reload reload;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+
+			auto found = _entries.find(path);
+			if (found == _entries.end()) continue;
+
+			Entry& entry = found->second;
+
+			// A file missing in the middle of a save is picked up by the write that recreates it
+			std::filesystem::file_time_type time;
+			std::uintmax_t size = 0;
+			if (!readStamp(path, time, size) || (time == entry.time && size == entry.size)) continue;
+
+			entry.time = time;
+			entry.size = size;
+			reload = entry.reload;
+		}
+
+		try
+		{
+			if (UpdateQueue::Command command = reload())
+			{
+				post(stopToken, std::move(command));
+			}
+		}
+		catch (const std::exception& exception)
+		{
+			if (_onError)
+			{
+				post(stopToken, [onError = _onError, path, message = std::string(exception.what())]()
+					{
+						onError(path, message);
+					});
+			}
+		}
+	}
+}
+
+void ResourceWatcher::post(std::stop_token stopToken, UpdateQueue::Command command)
+{
+	while (!UpdateQueue::getInstance().post(this, command))
+	{
+		if (stopToken.stop_requested()) return;
+		std::this_thread::sleep_for(ResourceWatcherConstants::RETRY_INTERVAL);
+	}
+}
+
+bool ResourceWatcher::readStamp(const std::string& path, std::filesystem::file_time_type& time, std::uintmax_t& size)
+{
+	std::error_code error;
+
+	time = std::filesystem::last_write_time(path, error);
+	if (error) return false;
+
+	size = std::filesystem::file_size(path, error);
+	return !error;
+}
\ No newline at end of file
@@ -0,0 +1,287 @@
+#include <Graphics/Rendering/RetainedCanvas.h>
+
+#include <cmath>
+#include <algorithm>
+
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/Sprite.hpp>
+#include <SFML/Graphics/View.hpp>
+
+#include <Exceptions.h>
+#include <JobSystem.h>
+#include <Profiler.h>
+
+namespace RetainedCanvasConstants
+{
+	// Extra pixels around a region so antialiased edges are repainted too
+	constexpr float REGION_PADDING = 2.f;
+	// Above this share of the canvas a single full repaint is cheaper
+	constexpr float FULL_REDRAW_RATIO = 0.5f;
+	// Widgets recorded per job; shorter runs draw on the calling thread
+	constexpr std::size_t RECORD_CHUNK = 256;
+}
+
+RetainedCanvas::RetainedCanvas(const sf::Color& clearColor)
+	:_clearColor(clearColor),
+	_fullRedraw(true)
+{
+}
+
+void RetainedCanvas::create(const sf::Vector2u& size)
+{
+	if (size == _size) return;
+
+	if (!_texture.create(size.x, size.y))
+	{
+		throw WindowNotInitializedException("RetainedCanvas::create() -> ");
+	}
+
+	_size = size;
+	invalidateAll();
+}
+
+void RetainedCanvas::invalidateAll()
+{
+	_fullRedraw = true;
+	_dirtyRegions.clear();
+}
+
+void RetainedCanvas::remove(const Widget& widget)
+{
+	auto it = _drawnBounds.find(&widget);
+	if (it == _drawnBounds.end()) return;
+
+	addDirtyRegion(it->second);
+	_drawnBounds.erase(it);
+}
+
+bool RetainedCanvas::update(const std::vector<Widget*>& widgets, BatchRenderer& renderer)
+{
+	if (_size.x == 0 || _size.y == 0) return false;
+
+	const ScopedTimer timer("RetainedCanvas::update");
+
+	for (Widget* widget : widgets)
+	{
+		if (!widget->isDirty()) continue;
+
+		const sf::FloatRect bounds = widget->getBounds();
+		auto [it, inserted] = _drawnBounds.try_emplace(widget, bounds);
+
+		if (!inserted)
+		{
+			addDirtyRegion(it->second);
+			it->second = bounds;
+		}
+
+		addDirtyRegion(bounds);
+		widget->clearDirty();
+	}
+
+	if (!_fullRedraw && _dirtyRegions.empty()) return false;
+
+	float dirtyArea = 0.f;
+	for (const auto& region : _dirtyRegions)
+	{
+		dirtyArea += region.width * region.height;
+	}
+
+	const float canvasArea = static_cast<float>(_size.x) * static_cast<float>(_size.y);
+	if (dirtyArea > canvasArea * RetainedCanvasConstants::FULL_REDRAW_RATIO)
+	{
+		_fullRedraw = true;
+	}
+
+	if (_fullRedraw)
+	{
+		_texture.setView(_texture.getDefaultView());
+		_texture.clear(_clearColor);
+
+		renderer.begin(_texture);
+		drawWidgets(widgets, nullptr, renderer);
+		renderer.end();
+	}
+	else
+	{
+		for (const auto& region : _dirtyRegions)
+		{
+			repaint(region, widgets, renderer);
+		}
+		_texture.setView(_texture.getDefaultView());
+	}
+
+	_texture.display();
+
+	_fullRedraw = false;
+	_dirtyRegions.clear();
+
+	return true;
+}
+
+void RetainedCanvas::present(sf::RenderTarget& target) const
+{
+	target.draw(sf::Sprite(_texture.getTexture()));
+}
+
+const sf::Texture& RetainedCanvas::getTexture() const
+{
+	return _texture.getTexture();
+}
+
+void RetainedCanvas::addDirtyRegion(const sf::FloatRect& region)
+{
+	if (region.width <= 0.f && region.height <= 0.f) return;
+
+	// Snap to whole pixels and clip against the canvas
+	const float padding = RetainedCanvasConstants::REGION_PADDING;
+	const float left = std::max(0.f, std::floor(region.left - padding));
+	const float top = std::max(0.f, std::floor(region.top - padding));
+	const float right = std::min(static_cast<float>(_size.x), std::ceil(region.left + region.width + padding));
+	const float bottom = std::min(static_cast<float>(_size.y), std::ceil(region.top + region.height + padding));
+
+	if (right <= left || bottom <= top) return;
+
+	sf::FloatRect merged(left, top, right - left, bottom - top);
+
+	// Fold every overlapping region into the new one so each pixel is repainted once
+	for (auto it = _dirtyRegions.begin(); it != _dirtyRegions.end();)
+	{
+		if (it->intersects(merged))
+		{
+			const float mergedLeft = std::min(it->left, merged.left);
+			const float mergedTop = std::min(it->top, merged.top);
+			const float mergedRight = std::max(it->left + it->width, merged.left + merged.width);
+			const float mergedBottom = std::max(it->top + it->height, merged.top + merged.height);
+
+			merged = { mergedLeft, mergedTop, mergedRight - mergedLeft, mergedBottom - mergedTop };
+			_dirtyRegions.erase(it);
+			it = _dirtyRegions.begin();
+		}
+		else
+		{
+			++it;
+		}
+	}
+
+	_dirtyRegions.push_back(merged);
+}
+
+void RetainedCanvas::repaint(const sf::FloatRect& region, const std::vector<Widget*>& widgets, BatchRenderer& renderer)
+{
+	// A view matching the region with the same viewport clips drawing to it
+	sf::View clip(region);
+	clip.setViewport(sf::FloatRect(
+		region.left / static_cast<float>(_size.x),
+		region.top / static_cast<float>(_size.y),
+		region.width / static_cast<float>(_size.x),
+		region.height / static_cast<float>(_size.y)
+	));
+	_texture.setView(clip);
+
+	sf::RectangleShape background({ region.width, region.height });
+	background.setPosition(region.left, region.top);
+	background.setFillColor(_clearColor);
+	_texture.draw(background, sf::RenderStates(sf::BlendNone));
+
+	renderer.begin(_texture);
+	drawWidgets(widgets, &region, renderer);
+	renderer.end();
+}
+
+void RetainedCanvas::drawWidgets(const std::vector<Widget*>& widgets, const sf::FloatRect* region, BatchRenderer& renderer)
+{
+	_drawn.clear();
+	_recordings.clear();
+
+	for (Widget* widget : widgets)
+	{
+		if (region && !widget->getBounds().intersects(*region)) continue;
+
+		_drawn.push_back(widget);
+		_recordings.push_back(widget->prepareDraw());
+	}
+
+	std::size_t first = 0;
+
+	while (first < _drawn.size())
+	{
+		// Recorded up to the next widget that draws to the target itself
+		std::size_t last = first;
+		while (last < _drawn.size() && _recordings[last] != DrawRecording::Direct) ++last;
+
+		record(first, last, renderer);
+
+		if (last < _drawn.size())
+		{
+			const ScopedTimer drawTimer("Widget::draw");
+			_drawn[last]->draw(renderer);
+			++last;
+		}
+
+		first = last;
+	}
+}
+
+void RetainedCanvas::record(std::size_t first, std::size_t last, BatchRenderer& renderer)
+{
+	const std::size_t chunkSize = RetainedCanvasConstants::RECORD_CHUNK;
+	const std::size_t chunkCount = JobSystem::getChunkCount(last - first, chunkSize);
+
+	const bool hasWorkerWidgets = std::find(_recordings.begin() + first, _recordings.begin() + last,
+		DrawRecording::AnyThread) != _recordings.begin() + last;
+
+	if (chunkCount <= 1 || !hasWorkerWidgets)
+	{
+		for (std::size_t i = first; i < last; ++i)
+		{
+			const ScopedTimer drawTimer("Widget::draw");
+			_drawn[i]->draw(renderer);
+		}
+		return;
+	}
+
+	// Widgets bound to this thread are recorded up front; the chunk holding one splices it in
+	{
+		const ScopedTimer pinnedTimer("RetainedCanvas::recordPinned");
+
+		_pinnedSlots.resize(_drawn.size());
+		std::size_t pinnedCount = 0;
+
+		for (std::size_t i = first; i < last; ++i)
+		{
+			if (_recordings[i] != DrawRecording::RenderThread) continue;
+
+			if (_pinned.size() == pinnedCount) _pinned.emplace_back();
+
+			_drawn[i]->draw(_pinned[pinnedCount]);
+			_pinnedSlots[i] = pinnedCount++;
+		}
+	}
+
+	if (_recorders.size() < chunkCount) _recorders.resize(chunkCount);
+
+	JobSystem::getInstance().parallelFor(last - first, chunkSize,
+		[this, first, chunkSize](std::size_t begin, std::size_t end)
+		{
+			BatchRenderer& recorder = _recorders[begin / chunkSize];
+
+			for (std::size_t i = first + begin; i < first + end; ++i)
+			{
+				if (_recordings[i] == DrawRecording::AnyThread)
+				{
+					_drawn[i]->draw(recorder);
+				}
+				else
+				{
+					recorder.append(_pinned[_pinnedSlots[i]]);
+				}
+			}
+		});
+
+	const ScopedTimer mergeTimer("RetainedCanvas::merge");
+
+	for (std::size_t chunk = 0; chunk < chunkCount; ++chunk)
+	{
+		renderer.append(_recorders[chunk]);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+#include <SpatialGrid.h>
+
+#include <cmath>
+#include <algorithm>
+
+SpatialGrid::SpatialGrid(float cellSize)
+	:_cellSize(cellSize > 0.f ? cellSize : 64.f)
+{
+}
+
+void SpatialGrid::insert(Widget* widget, const sf::FloatRect& bounds)
+{
+	if (_entries.count(widget))
+	{
+		update(widget, bounds);
+		return;
+	}
+
+	const CellRange cells = cellsFor(bounds);
+	_entries.emplace(widget, Entry{ cells, bounds });
+	link(widget, cells);
+}
+
+void SpatialGrid::update(Widget* widget, const sf::FloatRect& bounds)
+{
+	auto it = _entries.find(widget);
+	if (it == _entries.end())
+	{
+		insert(widget, bounds);
+		return;
+	}
+
+	const CellRange cells = cellsFor(bounds);
+	const CellRange& old = it->second.cells;
+
+	if (old.left != cells.left || old.top != cells.top ||
+		old.right != cells.right || old.bottom != cells.bottom)
+	{
+		unlink(widget, old);
+		link(widget, cells);
+	}
+
+	it->second = { cells, bounds };
+}
+
+void SpatialGrid::remove(Widget* widget)
+{
+	auto it = _entries.find(widget);
+	if (it == _entries.end()) return;
+
+	unlink(widget, it->second.cells);
+	_entries.erase(it);
+}
+
+void SpatialGrid::clear()
+{
+	_cells.clear();
+	_entries.clear();
+}
+
+void SpatialGrid::query(const sf::Vector2f& point, std::vector<Widget*>& result) const
+{
+	auto cell = _cells.find(cellKey(cellCoordinate(point.x), cellCoordinate(point.y)));
+	if (cell == _cells.end()) return;
+
+	for (Widget* widget : cell->second)
+	{
+		if (_entries.at(widget).bounds.contains(point))
+		{
+			result.push_back(widget);
+		}
+	}
+}
+
+std::size_t SpatialGrid::size() const
+{
+	return _entries.size();
+}
+
+std::int64_t SpatialGrid::cellKey(int x, int y)
+{
+	return (static_cast<std::int64_t>(x) << 32) ^ static_cast<std::uint32_t>(y);
+}
+
+int SpatialGrid::cellCoordinate(float value) const
+{
+	return static_cast<int>(std::floor(value / _cellSize));
+}
+
+SpatialGrid::CellRange SpatialGrid::cellsFor(const sf::FloatRect& bounds) const
+{
+	return
+	{
+		cellCoordinate(bounds.left),
+		cellCoordinate(bounds.top),
+		cellCoordinate(bounds.left + bounds.width),
+		cellCoordinate(bounds.top + bounds.height)
+	};
+}
+
+void SpatialGrid::link(Widget* widget, const CellRange& cells)
+{
+	for (int y = cells.top; y <= cells.bottom; ++y)
+	{
+		for (int x = cells.left; x <= cells.right; ++x)
+		{
+			_cells[cellKey(x, y)].push_back(widget);
+		}
+	}
+}
+
+void SpatialGrid::unlink(Widget* widget, const CellRange& cells)
+{
+	for (int y = cells.top; y <= cells.bottom; ++y)
+	{
+		for (int x = cells.left; x <= cells.right; ++x)
+		{
+			auto cell = _cells.find(cellKey(x, y));
+			if (cell == _cells.end()) continue;
+
+			// Empty cells are kept so widgets moving back and forth don't reallocate
+			auto& widgets = cell->second;
+			widgets.erase(std::remove(widgets.begin(), widgets.end(), widget), widgets.end());
+		}
+	}
+}
\ No newline at end of file
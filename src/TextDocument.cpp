@@ -0,0 +1,212 @@
+#include <TextDocument.h>
+
+#include <algorithm>
+
+TextDocument::TextDocument()
+	:_gapStart(0),
+	_gapEnd(0),
+	_lineStarts{ 0 },
+	_lineIds{ 1 },
+	_nextLineId(2)
+{
+}
+
+std::size_t TextDocument::size() const
+{
+	return _buffer.size() - gapSize();
+}
+
+bool TextDocument::empty() const
+{
+	return size() == 0;
+}
+
+sf::Uint32 TextDocument::at(std::size_t position) const
+{
+	return position < _gapStart ? _buffer[position] : _buffer[position + gapSize()];
+}
+
+std::size_t TextDocument::lineCount() const
+{
+	return _lineStarts.size();
+}
+
+std::size_t TextDocument::lineOf(std::size_t position) const
+{
+	auto it = std::upper_bound(_lineStarts.begin(), _lineStarts.end(), position);
+	return static_cast<std::size_t>(it - _lineStarts.begin()) - 1;
+}
+
+std::size_t TextDocument::lineStart(std::size_t line) const
+{
+	return _lineStarts[line];
+}
+
+std::size_t TextDocument::lineEnd(std::size_t line) const
+{
+	return line + 1 < _lineStarts.size() ? _lineStarts[line + 1] - 1 : size();
+}
+
+std::uint64_t TextDocument::lineId(std::size_t line) const
+{
+	return _lineIds[line];
+}
+
+void TextDocument::copy(std::size_t first, std::size_t count, std::basic_string<sf::Uint32>& out) const
+{
+	out.clear();
+
+	const std::size_t last = std::min(first + count, size());
+	if (first >= last) return;
+
+	if (first < _gapStart)
+	{
+		const std::size_t end = std::min(last, _gapStart);
+		out.append(_buffer.data() + first, end - first);
+		first = end;
+	}
+
+	if (first < last)
+	{
+		out.append(_buffer.data() + first + gapSize(), last - first);
+	}
+}
+
+void TextDocument::insert(std::size_t position, const sf::Uint32* text, std::size_t count)
+{
+	if (count == 0) return;
+
+	position = std::min(position, size());
+
+	reserveGap(count);
+	moveGap(position);
+
+	std::copy(text, text + count, _buffer.begin() + static_cast<std::ptrdiff_t>(_gapStart));
+	_gapStart += count;
+
+	const std::size_t line = lineOf(position);
+
+	for (std::size_t i = line + 1; i < _lineStarts.size(); ++i)
+	{
+		_lineStarts[i] += count;
+	}
+
+	_newLineStarts.clear();
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		if (text[i] == L'\n') _newLineStarts.push_back(position + i + 1);
+	}
+
+	_lineIds[line] = _nextLineId++;
+
+	if (!_newLineStarts.empty())
+	{
+		const auto offset = static_cast<std::ptrdiff_t>(line + 1);
+
+		_lineStarts.insert(_lineStarts.begin() + offset, _newLineStarts.begin(), _newLineStarts.end());
+		_lineIds.insert(_lineIds.begin() + offset, _newLineStarts.size(), 0);
+
+		for (std::size_t i = 0; i < _newLineStarts.size(); ++i)
+		{
+			_lineIds[line + 1 + i] = _nextLineId++;
+		}
+	}
+}
+
+void TextDocument::erase(std::size_t position, std::size_t count)
+{
+	position = std::min(position, size());
+	count = std::min(count, size() - position);
+
+	if (count == 0) return;
+
+	const std::size_t firstLine = lineOf(position);
+	const std::size_t lastLine = lineOf(position + count);
+
+	moveGap(position);
+	_gapEnd += count;
+
+	// Lines whose newline was removed merge into the first one
+	const auto first = static_cast<std::ptrdiff_t>(firstLine + 1);
+	const auto last = static_cast<std::ptrdiff_t>(lastLine + 1);
+
+	_lineStarts.erase(_lineStarts.begin() + first, _lineStarts.begin() + last);
+	_lineIds.erase(_lineIds.begin() + first, _lineIds.begin() + last);
+
+	for (std::size_t i = firstLine + 1; i < _lineStarts.size(); ++i)
+	{
+		_lineStarts[i] -= count;
+	}
+
+	_lineIds[firstLine] = _nextLineId++;
+}
+
+void TextDocument::assign(const sf::Uint32* text, std::size_t count)
+{
+	clear();
+	insert(0, text, count);
+}
+
+void TextDocument::clear()
+{
+	_gapStart = 0;
+	_gapEnd = _buffer.size();
+
+	_lineStarts.assign(1, 0);
+	_lineIds.assign(1, _nextLineId++);
+}
+
+void TextDocument::reserve(std::size_t capacity)
+{
+	if (capacity > size()) reserveGap(capacity - size());
+}
+
+std::size_t TextDocument::gapSize() const
+{
+	return _gapEnd - _gapStart;
+}
+
+void TextDocument::moveGap(std::size_t position)
+{
+	if (position < _gapStart)
+	{
+		const std::size_t distance = _gapStart - position;
+
+		std::copy_backward(_buffer.begin() + static_cast<std::ptrdiff_t>(position),
+			_buffer.begin() + static_cast<std::ptrdiff_t>(_gapStart),
+			_buffer.begin() + static_cast<std::ptrdiff_t>(_gapEnd));
+
+		_gapStart -= distance;
+		_gapEnd -= distance;
+	}
+	else if (position > _gapStart)
+	{
+		const std::size_t distance = position - _gapStart;
+
+		std::copy(_buffer.begin() + static_cast<std::ptrdiff_t>(_gapEnd),
+			_buffer.begin() + static_cast<std::ptrdiff_t>(_gapEnd + distance),
+			_buffer.begin() + static_cast<std::ptrdiff_t>(_gapStart));
+
+		_gapStart += distance;
+		_gapEnd += distance;
+	}
+}
+
+void TextDocument::reserveGap(std::size_t count)
+{
+	if (gapSize() >= count) return;
+
+	const std::size_t length = size();
+	const std::size_t capacity = std::max(_buffer.size() * 2, length + count + TextDocumentConstants::MIN_GAP);
+
+	std::vector<sf::Uint32> buffer(capacity);
+
+	const std::size_t tail = _buffer.size() - _gapEnd;
+
+	std::copy(_buffer.begin(), _buffer.begin() + static_cast<std::ptrdiff_t>(_gapStart), buffer.begin());
+	std::copy(_buffer.end() - static_cast<std::ptrdiff_t>(tail), _buffer.end(),
+		buffer.end() - static_cast<std::ptrdiff_t>(tail));
+
+	_gapEnd = capacity - tail;
+	_buffer.swap(buffer);
+}
\ No newline at end of file
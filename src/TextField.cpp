@@ -1,21 +1,42 @@
 #include <Graphics/InterfaceElements/TextField.h>
 
-TextField::TextField()
-	: _isActive(false),
-	_characterSize(24),
-	_activeColor(sf::Color::White),
-	_inactiveColor(sf::Color(180, 180, 180)),
-	_maxLength(20)
+#include <cmath>
+#include <iterator>
+
+#include <SFML/System/Utf.hpp>
+#include <SFML/Window/Clipboard.hpp>
+#include <SFML/Window/Keyboard.hpp>
+
+#include <Profiler.h>
+
+namespace
 {
-	if (!_font.loadFromFile(RESOURCES_DIR "fonts/defaultFont.otf"))
+	bool isShiftPressed()
 	{
-		throw FontException(RESOURCES_DIR "fonts/defaultFont.otf");
+		return sf::Keyboard::isKeyPressed(sf::Keyboard::LShift) ||
+			sf::Keyboard::isKeyPressed(sf::Keyboard::RShift);
 	}
+}
 
-	_text.setFont(_font);
-	_text.setCharacterSize(_characterSize);
-	_text.setFillColor(_inactiveColor);
-	_text.setPosition(sf::Vector2f(50.f, 100.f));
+TextField::TextField()
+	:_activeColor(sf::Color::White),
+	_inactiveColor(sf::Color(180, 180, 180)),
+	_selectionColor(sf::Color(70, 110, 200, 140)),
+	_textColor(_inactiveColor),
+	_isActive(false),
+	_isMultiline(false),
+	_isSelecting(false),
+	_cursor(0),
+	_anchor(0),
+	_preferredX(-1.f),
+	_firstLine(0),
+	_scrollX(0.f),
+	_drawStamp(0),
+	_isInputStringStale(false),
+	_characterSize(24),
+	_maxLength(TextFieldConstants::UNLIMITED_LENGTH)
+{
+	_font = FontCache::getInstance().acquireDefault(_characterSize);
 
 	_background.setSize(sf::Vector2f(100.f, 50.f));
 	_background.setFillColor(sf::Color::Transparent);
@@ -25,84 +46,205 @@ TextField::TextField()
 
 const std::string& TextField::getText() const
 {
+	if (_isInputStringStale)
+	{
+		_document.copy(0, _document.size(), _scratch);
+
+		_inputString.clear();
+		sf::Utf32::toUtf8(_scratch.begin(), _scratch.end(), std::back_inserter(_inputString));
+		_isInputStringStale = false;
+	}
+
 	return _inputString;
 }
 
 void TextField::setCharacterSize(unsigned int characterSize)
 {
+	if (_characterSize == characterSize) return;
+
 	_characterSize = characterSize;
-	_text.setCharacterSize(characterSize);
+	_font = FontCache::getInstance().acquireDefault(_characterSize);
+	_lineLayouts.clear();
+
+	ensureCursorVisible();
+	invalidate();
 }
 
 void TextField::setSize(const float& width, const float& height)
 {
-	_background.setSize(sf::Vector2f(width, height));
+	setSize(sf::Vector2f(width, height));
 }
 
 void TextField::setSize(const sf::Vector2f& size)
 {
+	if (_background.getSize() == size) return;
+
 	_background.setSize(size);
+	ensureCursorVisible();
+	invalidateBounds();
 }
 
 void TextField::setMaxLength(unsigned int length)
 {
 	_maxLength = length;
+	if (_maxLength == TextFieldConstants::UNLIMITED_LENGTH) return;
+
+	_document.reserve(_maxLength);
+	_scratch.reserve(_maxLength);
+	_pending.reserve(_maxLength);
+
+	for (LineLayout& entry : _lineLayouts)
+	{
+		entry.layout.vertices.reserve(_maxLength * TextLayoutConstants::VERTICES_PER_GLYPH);
+		entry.columns.reserve(_maxLength + 1);
+	}
+}
+
+void TextField::setMultiline(bool multiline)
+{
+	if (_isMultiline == multiline) return;
+
+	_isMultiline = multiline;
+	ensureCursorVisible();
+	invalidate();
+}
+
+bool TextField::isMultiline() const
+{
+	return _isMultiline;
 }
 
 void TextField::setText(const std::string& text)
 {
-	_inputString = text;
-	_text.setString(_inputString);
+	_scratch.clear();
+	sf::Utf8::toUtf32(text.begin(), text.end(), std::back_inserter(_scratch));
+
+	_document.clear();
+	_cursor = 0;
+	_anchor = 0;
+	_firstLine = 0;
+	_scrollX = 0.f;
+
+	insertText(_scratch.data(), _scratch.size());
+	ensureCursorVisible();
+}
+
+void TextField::append(const std::string& text)
+{
+	// Keep following the end like a log view, unless the user moved away from it
+	const bool follow = _cursor == _document.size() && !hasSelection();
+	const std::size_t cursor = _cursor;
+	const std::size_t anchor = _anchor;
+
+	_scratch.clear();
+	sf::Utf8::toUtf32(text.begin(), text.end(), std::back_inserter(_scratch));
+
+	_cursor = _document.size();
+	_anchor = _cursor;
+	insertText(_scratch.data(), _scratch.size());
+
+	if (follow)
+	{
+		ensureCursorVisible();
+	}
+	else
+	{
+		_cursor = cursor;
+		_anchor = anchor;
+	}
 }
 
 void TextField::setPosition(const sf::Vector2f& pos)
 {
-	_background.setPosition(sf::Vector2f(pos));
-	_text.setPosition(pos.x + 10.f, pos.y + 10);
-} 
+	if (_background.getPosition() == pos) return;
+
+	_background.setPosition(pos);
+	invalidateBounds();
+}
+
+std::size_t TextField::getLineCount() const
+{
+	return _document.lineCount();
+}
 
-void TextField::handleEvent(const sf::RenderWindow& window, const sf::Event& event)
+std::size_t TextField::getCursor() const
 {
+	return _cursor;
+}
+
+void TextField::setCursor(std::size_t position, bool extendSelection)
+{
+	_cursor = std::min(position, _document.size());
+	if (!extendSelection) _anchor = _cursor;
+
+	_preferredX = -1.f;
+	ensureCursorVisible();
+	invalidate();
+}
+
+void TextField::selectAll()
+{
+	_anchor = 0;
+	_cursor = _document.size();
+	ensureCursorVisible();
+	invalidate();
+}
+
+std::string TextField::getSelectedText() const
+{
+	std::string result;
+
+	_document.copy(selectionStart(), selectionEnd() - selectionStart(), _scratch);
+	sf::Utf32::toUtf8(_scratch.begin(), _scratch.end(), std::back_inserter(result));
+
+	return result;
+}
+
+void TextField::handleEvent(const sf::RenderTarget& target, const sf::Event& event)
+{
+	sf::Vector2f mousePos;
+	getEventPosition(target, event, mousePos);
+
 	if (event.type == sf::Event::MouseButtonPressed &&
 		event.mouseButton.button == sf::Mouse::Left &&
 		(std::chrono::steady_clock::now() - _lastClickTime) > _clickDelay)
 	{
 		_lastClickTime = std::chrono::steady_clock::now();
 
-		const auto mousePos = window.mapPixelToCoords(
-			{ event.mouseButton.x, event.mouseButton.y },
-			window.getView()
-		);
+		const bool isInside = _background.getGlobalBounds().contains(mousePos);
+		setActive(isInside);
 
-		const bool wasActive = _isActive;
-
-		_isActive = _background.getGlobalBounds().contains(mousePos);
-
-		if (wasActive != _isActive)
-		{
-			_text.setFillColor(_isActive ? _activeColor : _inactiveColor);
-			_background.setOutlineColor(_isActive ? _activeColor : _inactiveColor);
-		}
-		if (_isActive)
+		if (isInside)
 		{
-			_keyRepeatClock.restart();
+			setCursor(positionAt(mousePos), isShiftPressed());
+			_isSelecting = true;
 		}
 	}
+	else if (event.type == sf::Event::MouseButtonReleased &&
+		event.mouseButton.button == sf::Mouse::Left)
+	{
+		_isSelecting = false;
+	}
+	else if (event.type == sf::Event::MouseMoved && _isSelecting)
+	{
+		setCursor(positionAt(mousePos), true);
+	}
+	else if (event.type == sf::Event::MouseWheelScrolled &&
+		_background.getGlobalBounds().contains(mousePos))
+	{
+		scrollLines(-static_cast<long>(std::lround(event.mouseWheelScroll.delta)) *
+			static_cast<long>(TextFieldConstants::WHEEL_LINES));
+	}
 
-	if (_isActive && event.type == sf::Event::TextEntered)
+	if (!_isActive) return;
+
+	if (event.type == sf::Event::TextEntered)
 	{
 		handleTextInput(event.text.unicode);
 	}
-
-	if (_isActive && event.type == sf::Event::KeyPressed)
+	else if (event.type == sf::Event::KeyPressed)
 	{
-		if (event.key.code == sf::Keyboard::Enter ||
-			event.key.code == sf::Keyboard::Tab)
-		{
-			_isActive = false;
-			_text.setFillColor(_inactiveColor);
-			_background.setOutlineColor(_inactiveColor);
-		}
+		handleKey(event.key);
 	}
 }
 
@@ -115,22 +257,487 @@ void TextField::handleTextInput(sf::Uint32 unicode)
 
 	if (unicode == '\b')
 	{
-		if (!_inputString.empty())
+		if (!eraseSelection() && _cursor > 0)
 		{
-			_inputString.pop_back();
+			_document.erase(--_cursor, 1);
+			_anchor = _cursor;
 		}
+
+		onTextChanged();
+		ensureCursorVisible();
 	}
-	else if (unicode >= 32 && unicode <= 128 && _inputString.size() < _maxLength)
+	else if (unicode == '\r' || unicode == '\n')
 	{
-		_inputString += static_cast<char>(unicode);
+		if (_isMultiline)
+		{
+			const sf::Uint32 newline = '\n';
+			insertText(&newline, 1);
+			ensureCursorVisible();
+		}
+	}
+	else if (unicode >= 32 && unicode != 127)
+	{
+		insertText(&unicode, 1);
+		ensureCursorVisible();
 	}
 
-	_text.setString(_inputString);
 	_keyRepeatClock.restart();
 }
 
-void TextField::draw(sf::RenderWindow& window)
+void TextField::draw(sf::RenderTarget& target)
+{
+	target.draw(_background);
+
+	emitContent(
+		[&](const sf::FloatRect& rect, const sf::Color& color)
+		{
+			_highlight.setPosition(rect.left, rect.top);
+			_highlight.setSize({ rect.width, rect.height });
+			_highlight.setFillColor(color);
+			target.draw(_highlight);
+		},
+		[&](const sf::Vertex* vertices, std::size_t count, const sf::Texture* texture, const sf::Transform& transform)
+		{
+			_coloredGlyphs.assign(vertices, vertices + count);
+			for (sf::Vertex& vertex : _coloredGlyphs)
+			{
+				vertex.color = _textColor;
+			}
+
+			sf::RenderStates states(transform);
+			states.texture = texture;
+			target.draw(_coloredGlyphs.data(), _coloredGlyphs.size(), sf::Triangles, states);
+		});
+}
+
+void TextField::draw(BatchRenderer& renderer)
+{
+	renderer.addShape(_background);
+
+	emitContent(
+		[&](const sf::FloatRect& rect, const sf::Color& color)
+		{
+			renderer.addRect(rect, color);
+		},
+		[&](const sf::Vertex* vertices, std::size_t count, const sf::Texture* texture, const sf::Transform& transform)
+		{
+			renderer.addGlyphs(vertices, count, texture, _textColor, transform);
+		});
+}
+
+DrawRecording TextField::prepareDraw()
+{
+	// Lines are laid out from the font while drawing
+	return DrawRecording::RenderThread;
+}
+
+sf::FloatRect TextField::getBounds() const
+{
+	// Text is clipped to the box, so the box is all the field ever covers
+	return _background.getGlobalBounds();
+}
+
+void TextField::setActive(bool active)
+{
+	if (_isActive == active) return;
+
+	_isActive = active;
+	_isSelecting = false;
+	_textColor = _isActive ? _activeColor : _inactiveColor;
+	_background.setOutlineColor(_textColor);
+
+	if (_isActive)
+	{
+		_keyRepeatClock.restart();
+	}
+
+	invalidate();
+}
+
+void TextField::handleKey(const sf::Event::KeyEvent& key)
+{
+	switch (key.code)
+	{
+	case sf::Keyboard::Enter:
+		// Multiline fields get their newline from the TextEntered event
+		if (!_isMultiline) setActive(false);
+		break;
+	case sf::Keyboard::Tab:
+		setActive(false);
+		break;
+	case sf::Keyboard::Left:
+		if (hasSelection() && !key.shift) setCursor(selectionStart());
+		else setCursor(_cursor > 0 ? _cursor - 1 : 0, key.shift);
+		break;
+	case sf::Keyboard::Right:
+		if (hasSelection() && !key.shift) setCursor(selectionEnd());
+		else setCursor(_cursor + 1, key.shift);
+		break;
+	case sf::Keyboard::Up:
+		moveVertically(-1, key.shift);
+		break;
+	case sf::Keyboard::Down:
+		moveVertically(1, key.shift);
+		break;
+	case sf::Keyboard::PageUp:
+		moveVertically(-static_cast<long>(visibleLineCount()), key.shift);
+		break;
+	case sf::Keyboard::PageDown:
+		moveVertically(static_cast<long>(visibleLineCount()), key.shift);
+		break;
+	case sf::Keyboard::Home:
+		setCursor(key.control ? 0 : _document.lineStart(_document.lineOf(_cursor)), key.shift);
+		break;
+	case sf::Keyboard::End:
+		setCursor(key.control ? _document.size() : _document.lineEnd(_document.lineOf(_cursor)), key.shift);
+		break;
+	case sf::Keyboard::Delete:
+		if (!eraseSelection() && _cursor < _document.size())
+		{
+			_document.erase(_cursor, 1);
+		}
+		onTextChanged();
+		ensureCursorVisible();
+		break;
+	case sf::Keyboard::A:
+		if (key.control) selectAll();
+		break;
+	case sf::Keyboard::C:
+	case sf::Keyboard::X:
+		if (key.control && hasSelection())
+		{
+			_document.copy(selectionStart(), selectionEnd() - selectionStart(), _scratch);
+			sf::Clipboard::setString(sf::String(_scratch));
+
+			if (key.code == sf::Keyboard::X)
+			{
+				eraseSelection();
+				onTextChanged();
+				ensureCursorVisible();
+			}
+		}
+		break;
+	case sf::Keyboard::V:
+		if (key.control)
+		{
+			const sf::String clipboard = sf::Clipboard::getString();
+			insertText(clipboard.getData(), clipboard.getSize());
+			ensureCursorVisible();
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+void TextField::insertText(const sf::Uint32* text, std::size_t count)
+{
+	eraseSelection();
+
+	const std::size_t length = _document.size();
+	const std::size_t available = _maxLength > length ? _maxLength - length : 0;
+
+	std::basic_string<sf::Uint32>& filtered = _pending;
+	filtered.clear();
+
+	for (std::size_t i = 0; i < count && filtered.size() < available; ++i)
+	{
+		const sf::Uint32 codePoint = text[i];
+
+		if (codePoint == '\n')
+		{
+			filtered.push_back(_isMultiline ? '\n' : ' ');
+		}
+		else if (codePoint == '\t' || (codePoint >= 32 && codePoint != 127))
+		{
+			filtered.push_back(codePoint);
+		}
+	}
+
+	_document.insert(_cursor, filtered.data(), filtered.size());
+	_cursor += filtered.size();
+	_anchor = _cursor;
+
+	onTextChanged();
+}
+
+bool TextField::eraseSelection()
+{
+	if (!hasSelection()) return false;
+
+	const std::size_t start = selectionStart();
+	_document.erase(start, selectionEnd() - start);
+
+	_cursor = start;
+	_anchor = start;
+
+	return true;
+}
+
+void TextField::onTextChanged()
+{
+	_isInputStringStale = true;
+	_preferredX = -1.f;
+
+	invalidate();
+}
+
+bool TextField::hasSelection() const
+{
+	return _cursor != _anchor;
+}
+
+std::size_t TextField::selectionStart() const
+{
+	return std::min(_cursor, _anchor);
+}
+
+std::size_t TextField::selectionEnd() const
+{
+	return std::max(_cursor, _anchor);
+}
+
+float TextField::lineHeight() const
+{
+	return _font->getLineSpacing(_characterSize);
+}
+
+std::size_t TextField::visibleLineCount() const
+{
+	if (!_isMultiline) return 1;
+
+	const float innerHeight = _background.getSize().y - 2.f * TextFieldConstants::PADDING;
+	const auto count = static_cast<std::size_t>(std::max(0.f, std::floor(innerHeight / lineHeight())));
+
+	return std::max<std::size_t>(count, 1);
+}
+
+float TextField::columnX(std::size_t position)
+{
+	const std::size_t line = _document.lineOf(position);
+
+	return lineLayout(line).columns[position - _document.lineStart(line)];
+}
+
+std::size_t TextField::columnAt(std::size_t line, float x)
+{
+	const std::vector<float>& columns = lineLayout(line).columns;
+
+	// Same pick as TextLayout::indexAt: a boundary wins up to halfway to the next one
+	auto next = std::upper_bound(columns.begin(), columns.end(), x);
+	if (next == columns.begin()) return 0;
+	if (next == columns.end()) return columns.size() - 1;
+
+	const auto index = static_cast<std::size_t>(next - columns.begin());
+	return x < (columns[index - 1] + columns[index]) / 2.f ? index - 1 : index;
+}
+
+std::size_t TextField::positionAt(const sf::Vector2f& point)
+{
+	const sf::Vector2f local = point - _background.getPosition() -
+		sf::Vector2f(TextFieldConstants::PADDING, TextFieldConstants::PADDING);
+
+	const auto row = static_cast<std::size_t>(std::max(0.f, std::floor(local.y / lineHeight())));
+	const std::size_t line = std::min(_firstLine + row, _document.lineCount() - 1);
+
+	return _document.lineStart(line) + columnAt(line, local.x + _scrollX);
+}
+
+void TextField::moveVertically(long lines, bool extendSelection)
+{
+	// Remember the column of the first move so passing short lines doesn't drift the caret
+	const float preferredX = _preferredX >= 0.f ? _preferredX : columnX(_cursor);
+
+	const long last = static_cast<long>(_document.lineCount()) - 1;
+	const long line = std::clamp(static_cast<long>(_document.lineOf(_cursor)) + lines, 0L, last);
+
+	const auto target = static_cast<std::size_t>(line);
+	setCursor(_document.lineStart(target) + columnAt(target, preferredX), extendSelection);
+	_preferredX = preferredX;
+}
+
+void TextField::scrollLines(long lines)
+{
+	const std::size_t visible = visibleLineCount();
+	const std::size_t count = _document.lineCount();
+	const long maxFirstLine = count > visible ? static_cast<long>(count - visible) : 0;
+
+	const auto firstLine = static_cast<std::size_t>(
+		std::clamp(static_cast<long>(_firstLine) + lines, 0L, maxFirstLine));
+
+	if (firstLine == _firstLine) return;
+
+	_firstLine = firstLine;
+	invalidate();
+}
+
+void TextField::ensureCursorVisible()
+{
+	const std::size_t line = _document.lineOf(_cursor);
+	const std::size_t visible = visibleLineCount();
+
+	if (line < _firstLine)
+	{
+		_firstLine = line;
+	}
+	else if (line >= _firstLine + visible)
+	{
+		_firstLine = line - visible + 1;
+	}
+
+	const float innerWidth = std::max(0.f, _background.getSize().x - 2.f * TextFieldConstants::PADDING);
+	const float x = columnX(_cursor);
+
+	if (x < _scrollX)
+	{
+		_scrollX = x;
+	}
+	else if (x > _scrollX + innerWidth)
+	{
+		_scrollX = x - innerWidth;
+	}
+}
+
+void TextField::prepareLineLayouts()
 {
-	window.draw(_background);
-	window.draw(_text);
+	const std::size_t slotCount = 2 * visibleLineCount() + 2;
+	if (_lineLayouts.size() >= slotCount) return;
+
+	// All at once, so references handed out during a draw stay valid
+	_lineLayouts.resize(slotCount);
+
+	if (_maxLength == TextFieldConstants::UNLIMITED_LENGTH) return;
+
+	for (LineLayout& entry : _lineLayouts)
+	{
+		entry.layout.vertices.reserve(_maxLength * TextLayoutConstants::VERTICES_PER_GLYPH);
+		entry.columns.reserve(_maxLength + 1);
+	}
+}
+
+const TextField::LineLayout& TextField::lineLayout(std::size_t line)
+{
+	const std::uint64_t id = _document.lineId(line);
+	LineLayout* slot = nullptr;
+
+	for (LineLayout& entry : _lineLayouts)
+	{
+		if (entry.id == id)
+		{
+			entry.lastUse = _drawStamp;
+			return entry;
+		}
+
+		// Least recently drawn line that is not on screen this frame
+		if (entry.lastUse != _drawStamp && (!slot || entry.lastUse < slot->lastUse))
+		{
+			slot = &entry;
+		}
+	}
+
+	if (!slot)
+	{
+		_lineLayouts.emplace_back();
+		slot = &_lineLayouts.back();
+	}
+
+	Profiler::getInstance().increment(ProfilerCounter::TextLayouts);
+
+	const std::size_t start = _document.lineStart(line);
+	_document.copy(start, _document.lineEnd(line) - start, _scratch);
+
+	slot->id = id;
+	slot->lastUse = _drawStamp;
+	slot->layout.texture = &_font->getTexture(_characterSize);
+	slot->layout.vertices.clear();
+	TextLayout::appendGlyphs(slot->layout.vertices, slot->layout.bounds, *_font,
+		std::basic_string_view<sf::Uint32>(_scratch), _characterSize);
+	TextLayout::measureColumns(slot->columns, *_font, _scratch, _characterSize);
+
+	return *slot;
 }
+
+template<class RectFunction, class GlyphFunction>
+void TextField::emitContent(RectFunction&& emitRect, GlyphFunction&& emitGlyphs)
+{
+	++_drawStamp;
+	prepareLineLayouts();
+
+	const float padding = TextFieldConstants::PADDING;
+	const float glyphPadding = TextLayoutConstants::GLYPH_PADDING;
+
+	const sf::Vector2f origin = _background.getPosition() + sf::Vector2f(padding, padding);
+	const float innerWidth = std::max(0.f, _background.getSize().x - 2.f * padding);
+	const float height = lineHeight();
+
+	const std::size_t lastLine = std::min(_document.lineCount(), _firstLine + visibleLineCount());
+	const std::size_t selectedFirst = selectionStart();
+	const std::size_t selectedLast = selectionEnd();
+
+	for (std::size_t line = _firstLine; line < lastLine; ++line)
+	{
+		const float top = origin.y + static_cast<float>(line - _firstLine) * height;
+		const std::size_t start = _document.lineStart(line);
+		const std::size_t end = _document.lineEnd(line);
+
+		if (selectedFirst < selectedLast && selectedFirst <= end && selectedLast > start)
+		{
+			// A selected newline shows as a space wide block at the end of the line
+			const float newlineWidth = selectedLast > end ?
+				_font->getGlyph(L' ', _characterSize, false).advance : 0.f;
+
+			const float left = std::clamp(columnX(std::max(selectedFirst, start)) - _scrollX, 0.f, innerWidth);
+			const float right = std::clamp(columnX(std::min(selectedLast, end)) + newlineWidth - _scrollX, 0.f, innerWidth);
+
+			if (right > left)
+			{
+				emitRect(sf::FloatRect(origin.x + left, top, right - left, height), _selectionColor);
+			}
+		}
+
+		const TextLayout& layout = lineLayout(line).layout;
+		const std::size_t quads = layout.vertices.size() / 6;
+
+		// Quads run left to right on a line: the first one past a bound is found by bisection
+		auto firstQuadWhere = [quads](std::size_t low, auto&& isPast)
+			{
+				std::size_t high = quads;
+				while (low < high)
+				{
+					const std::size_t middle = low + (high - low) / 2;
+					if (isPast(middle)) high = middle;
+					else low = middle + 1;
+				}
+				return low;
+			};
+
+		// Keep the run that fits the box
+		const std::size_t first = firstQuadWhere(0, [&](std::size_t quad)
+			{
+				return layout.vertices[quad * 6].position.x + glyphPadding >= _scrollX;
+			});
+		const std::size_t last = firstQuadWhere(first, [&](std::size_t quad)
+			{
+				return layout.vertices[quad * 6 + 1].position.x - glyphPadding > _scrollX + innerWidth;
+			});
+
+		if (last > first)
+		{
+			sf::Transform transform;
+			transform.translate(origin.x - _scrollX, top);
+
+			emitGlyphs(layout.vertices.data() + first * 6, (last - first) * 6, layout.texture, transform);
+		}
+	}
+
+	if (!_isActive) return;
+
+	const std::size_t cursorLine = _document.lineOf(_cursor);
+	if (cursorLine < _firstLine || cursorLine >= lastLine) return;
+
+	const float x = columnX(_cursor) - _scrollX;
+	if (x < 0.f || x > innerWidth) return;
+
+	const float top = origin.y + static_cast<float>(cursorLine - _firstLine) * height;
+	emitRect(sf::FloatRect(origin.x + x, top, TextFieldConstants::CARET_WIDTH, height), _textColor);
+}
\ No newline at end of file
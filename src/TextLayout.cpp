@@ -0,0 +1,281 @@
+#include <Graphics/Rendering/TextLayout.h>
+
+#include <algorithm>
+
+#include <Profiler.h>
+
+namespace
+{
+	float advanceOf(const sf::Font& font, sf::Uint32 previous, sf::Uint32 current,
+		unsigned int characterSize, bool isBold, float whitespaceWidth)
+	{
+		const float kerning = font.getKerning(previous, current, characterSize, isBold);
+
+		switch (current)
+		{
+		case L'\r':
+		case L'\n':
+			return 0.f;
+		case L' ':
+			return kerning + whitespaceWidth;
+		case L'\t':
+			return kerning + whitespaceWidth * 4;
+		default:
+			return kerning + font.getGlyph(current, characterSize, isBold).advance;
+		}
+	}
+}
+
+void TextLayout::appendGlyphs(std::vector<sf::Vertex>& vertices, sf::FloatRect& bounds,
+	const sf::Font& font, const sf::String& string,
+	unsigned int characterSize, bool isBold, float lineSpacing)
+{
+	appendGlyphs(vertices, bounds, font,
+		std::basic_string_view<sf::Uint32>(string.getData(), string.getSize()),
+		characterSize, isBold, lineSpacing);
+}
+
+void TextLayout::appendGlyphs(std::vector<sf::Vertex>& vertices, sf::FloatRect& bounds,
+	const sf::Font& font, std::basic_string_view<sf::Uint32> string,
+	unsigned int characterSize, bool isBold, float lineSpacing)
+{
+	bounds = sf::FloatRect();
+
+	if (string.empty()) return;
+
+	const float whitespaceWidth = font.getGlyph(L' ', characterSize, isBold).advance;
+	const float lineHeight = font.getLineSpacing(characterSize) * lineSpacing;
+	const float padding = TextLayoutConstants::GLYPH_PADDING;
+
+	float x = 0.f;
+	float y = static_cast<float>(characterSize);
+	sf::Uint32 previous = 0;
+
+	float minX = static_cast<float>(characterSize);
+	float minY = static_cast<float>(characterSize);
+	float maxX = 0.f;
+	float maxY = 0.f;
+
+	for (const sf::Uint32 current : string)
+	{
+		if (current == L'\r') continue;
+
+		x += font.getKerning(previous, current, characterSize, isBold);
+		previous = current;
+
+		if (current == L' ' || current == L'\n' || current == L'\t')
+		{
+			minX = std::min(minX, x);
+			minY = std::min(minY, y);
+
+			switch (current)
+			{
+			case L' ':
+				x += whitespaceWidth;
+				break;
+			case L'\t':
+				x += whitespaceWidth * 4;
+				break;
+			case L'\n':
+				y += lineHeight;
+				x = 0.f;
+				break;
+			}
+
+			maxX = std::max(maxX, x);
+			maxY = std::max(maxY, y);
+			continue;
+		}
+
+		const sf::Glyph& glyph = font.getGlyph(current, characterSize, isBold);
+
+		const float left = x + glyph.bounds.left;
+		const float top = y + glyph.bounds.top;
+		const float right = left + glyph.bounds.width;
+		const float bottom = top + glyph.bounds.height;
+
+		const float u1 = static_cast<float>(glyph.textureRect.left) - padding;
+		const float v1 = static_cast<float>(glyph.textureRect.top) - padding;
+		const float u2 = static_cast<float>(glyph.textureRect.left + glyph.textureRect.width) + padding;
+		const float v2 = static_cast<float>(glyph.textureRect.top + glyph.textureRect.height) + padding;
+
+		const sf::Vertex topLeft({ left - padding, top - padding }, sf::Color::White, { u1, v1 });
+		const sf::Vertex topRight({ right + padding, top - padding }, sf::Color::White, { u2, v1 });
+		const sf::Vertex bottomRight({ right + padding, bottom + padding }, sf::Color::White, { u2, v2 });
+		const sf::Vertex bottomLeft({ left - padding, bottom + padding }, sf::Color::White, { u1, v2 });
+
+		vertices.push_back(topLeft);
+		vertices.push_back(topRight);
+		vertices.push_back(bottomLeft);
+		vertices.push_back(bottomLeft);
+		vertices.push_back(topRight);
+		vertices.push_back(bottomRight);
+
+		minX = std::min(minX, left);
+		minY = std::min(minY, top);
+		maxX = std::max(maxX, right);
+		maxY = std::max(maxY, bottom);
+
+		x += glyph.advance;
+	}
+
+	if (maxX >= minX && maxY >= minY)
+	{
+		bounds = sf::FloatRect(minX, minY, maxX - minX, maxY - minY);
+	}
+}
+
+float TextLayout::measure(const sf::Font& font, std::basic_string_view<sf::Uint32> text,
+	unsigned int characterSize, bool isBold)
+{
+	const float whitespaceWidth = font.getGlyph(L' ', characterSize, isBold).advance;
+
+	float x = 0.f;
+	sf::Uint32 previous = 0;
+
+	for (const sf::Uint32 current : text)
+	{
+		x += advanceOf(font, previous, current, characterSize, isBold, whitespaceWidth);
+		previous = current;
+	}
+
+	return x;
+}
+
+void TextLayout::measureColumns(std::vector<float>& columns, const sf::Font& font,
+	std::basic_string_view<sf::Uint32> text, unsigned int characterSize, bool isBold)
+{
+	const float whitespaceWidth = font.getGlyph(L' ', characterSize, isBold).advance;
+
+	float x = 0.f;
+	sf::Uint32 previous = 0;
+
+	columns.clear();
+	columns.push_back(x);
+
+	for (const sf::Uint32 current : text)
+	{
+		x += advanceOf(font, previous, current, characterSize, isBold, whitespaceWidth);
+		previous = current;
+
+		columns.push_back(x);
+	}
+}
+
+std::size_t TextLayout::indexAt(const sf::Font& font, std::basic_string_view<sf::Uint32> text,
+	unsigned int characterSize, float x, bool isBold)
+{
+	const float whitespaceWidth = font.getGlyph(L' ', characterSize, isBold).advance;
+
+	float pen = 0.f;
+	sf::Uint32 previous = 0;
+
+	for (std::size_t i = 0; i < text.size(); ++i)
+	{
+		const float advance = advanceOf(font, previous, text[i], characterSize, isBold, whitespaceWidth);
+
+		if (x < pen + advance / 2.f) return i;
+
+		pen += advance;
+		previous = text[i];
+	}
+
+	return text.size();
+}
+
+std::shared_ptr<const TextLayout> TextLayout::create(const sf::Font& font, const sf::String& string,
+	unsigned int characterSize, bool isBold)
+{
+	Profiler::getInstance().increment(ProfilerCounter::TextLayouts);
+
+	auto layout = std::make_shared<TextLayout>();
+	layout->texture = &font.getTexture(characterSize);
+	layout->vertices.reserve(string.getSize() * 6);
+
+	appendGlyphs(layout->vertices, layout->bounds, font, string, characterSize, isBold);
+
+	return layout;
+}
+
+std::size_t TextLayoutCache::KeyHash::operator()(const KeyView& key) const
+{
+	// FNV-1a over the code points, seeded with the font and size
+	std::size_t hash = std::hash<const void*>()(key.font);
+	hash ^= (static_cast<std::size_t>(key.characterSize) << 1) ^ static_cast<std::size_t>(key.isBold);
+
+	for (const sf::Uint32 codePoint : key.text)
+	{
+		hash ^= codePoint;
+		hash *= 1099511628211ull;
+	}
+
+	return hash;
+}
+
+TextLayoutCache& TextLayoutCache::getInstance()
+{
+	static TextLayoutCache instance;
+	return instance;
+}
+
+std::shared_ptr<const TextLayout> TextLayoutCache::acquire(const std::shared_ptr<const sf::Font>& font,
+	const sf::String& string, unsigned int characterSize, bool isBold)
+{
+	if (!font) return nullptr;
+
+	const KeyView view
+	{
+		font.get(),
+		characterSize,
+		isBold,
+		std::basic_string_view<sf::Uint32>(string.getData(), string.getSize())
+	};
+
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	auto it = _layouts.find(view);
+	if (it != _layouts.end())
+	{
+		return it->second.layout;
+	}
+
+	if (_layouts.size() >= TextLayoutConstants::MAX_CACHED_LAYOUTS)
+	{
+		evictUnused();
+	}
+
+	std::shared_ptr<const TextLayout> layout = TextLayout::create(*font, string, characterSize, isBold);
+
+	_layouts.emplace(
+		Key{ view.font, view.characterSize, view.isBold, std::basic_string<sf::Uint32>(view.text) },
+		Entry{ font, layout });
+
+	return layout;
+}
+
+void TextLayoutCache::clear()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_layouts.clear();
+}
+
+std::size_t TextLayoutCache::size() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _layouts.size();
+}
+
+void TextLayoutCache::evictUnused()
+{
+	for (auto it = _layouts.begin(); it != _layouts.end();)
+	{
+		if (it->second.layout.use_count() == 1)
+		{
+			it = _layouts.erase(it);
+		}
+		else
+		{
+			++it;
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,474 @@
+#include <Graphics/Rendering/TextureAtlas.h>
+
+#include <cctype>
+#include <limits>
+#include <numeric>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <stdexcept>
+#include <filesystem>
+
+#include <Exceptions.h>
+
+namespace
+{
+	constexpr std::size_t BYTES_PER_PIXEL = 4;
+
+	struct SkylineSegment
+	{
+		int x;
+		int y;
+		int width;
+	};
+
+	// Top edge of everything packed on a page so far, left to right
+	class Skyline
+	{
+	public:
+		explicit Skyline(int size)
+			:_size(size),
+			_segments{ { 0, 0, size } }
+		{
+		}
+
+		// Lowest spot first, then the narrowest segment, to leave wide gaps for wide images
+		bool insert(int width, int height, sf::Vector2i& position)
+		{
+			int bestBottom = std::numeric_limits<int>::max();
+			int bestWidth = std::numeric_limits<int>::max();
+			std::size_t bestIndex = _segments.size();
+
+			for (std::size_t i = 0; i < _segments.size(); ++i)
+			{
+				int y = 0;
+				if (!fits(i, width, height, y)) continue;
+
+				if (y + height < bestBottom || (y + height == bestBottom && _segments[i].width < bestWidth))
+				{
+					bestBottom = y + height;
+					bestWidth = _segments[i].width;
+					bestIndex = i;
+					position = { _segments[i].x, y };
+				}
+			}
+
+			if (bestIndex == _segments.size()) return false;
+
+			raise(bestIndex, position, width, height);
+			_used.x = std::max(_used.x, position.x + width);
+			_used.y = std::max(_used.y, position.y + height);
+
+			return true;
+		}
+
+		const sf::Vector2i& getUsedSize() const { return _used; }
+
+	private:
+		bool fits(std::size_t index, int width, int height, int& y) const
+		{
+			if (_segments[index].x + width > _size) return false;
+
+			y = _segments[index].y;
+			for (int remaining = width; remaining > 0; ++index)
+			{
+				y = std::max(y, _segments[index].y);
+				if (y + height > _size) return false;
+
+				remaining -= _segments[index].width;
+			}
+
+			return true;
+		}
+
+		void raise(std::size_t index, const sf::Vector2i& position, int width, int height)
+		{
+			_segments.insert(_segments.begin() + static_cast<std::ptrdiff_t>(index), { position.x, position.y + height, width });
+
+			// Segments now covered by the new one shrink or disappear
+			for (std::size_t i = index + 1; i < _segments.size();)
+			{
+				const SkylineSegment& previous = _segments[i - 1];
+				const int overlap = previous.x + previous.width - _segments[i].x;
+				if (overlap <= 0) break;
+
+				_segments[i].x += overlap;
+				_segments[i].width -= overlap;
+				if (_segments[i].width > 0) break;
+
+				_segments.erase(_segments.begin() + static_cast<std::ptrdiff_t>(i));
+			}
+
+			for (std::size_t i = 0; i + 1 < _segments.size();)
+			{
+				if (_segments[i].y == _segments[i + 1].y)
+				{
+					_segments[i].width += _segments[i + 1].width;
+					_segments.erase(_segments.begin() + static_cast<std::ptrdiff_t>(i) + 1);
+				}
+				else
+				{
+					++i;
+				}
+			}
+		}
+
+		int _size;
+		std::vector<SkylineSegment> _segments;
+		sf::Vector2i _used;
+	};
+
+	// Copies the image to (left, top) and repeats its edge pixels into the padding around it
+	void blit(std::vector<sf::Uint8>& page, int pageWidth, const sf::Image& image, int left, int top, int padding)
+	{
+		const int width = static_cast<int>(image.getSize().x);
+		const int height = static_cast<int>(image.getSize().y);
+		const sf::Uint8* pixels = image.getPixelsPtr();
+
+		for (int row = -padding; row < height + padding; ++row)
+		{
+			const sf::Uint8* source = pixels + static_cast<std::size_t>(std::clamp(row, 0, height - 1) * width) * BYTES_PER_PIXEL;
+			sf::Uint8* target = page.data() + static_cast<std::size_t>((top + row) * pageWidth + left - padding) * BYTES_PER_PIXEL;
+
+			for (int i = 0; i < padding; ++i)
+			{
+				std::copy_n(source, BYTES_PER_PIXEL, target + static_cast<std::size_t>(i) * BYTES_PER_PIXEL);
+				std::copy_n(source + static_cast<std::size_t>(width - 1) * BYTES_PER_PIXEL, BYTES_PER_PIXEL,
+					target + static_cast<std::size_t>(padding + width + i) * BYTES_PER_PIXEL);
+			}
+
+			std::copy_n(source, static_cast<std::size_t>(width) * BYTES_PER_PIXEL,
+				target + static_cast<std::size_t>(padding) * BYTES_PER_PIXEL);
+		}
+	}
+
+	// Sums in unsigned so large values in a damaged index can't overflow past the checks
+	bool fitsPage(const PackedAtlas::Entry& entry, const sf::Vector2u& pageSize)
+	{
+		const sf::IntRect& rect = entry.rect;
+		const NineSlice& slice = entry.slice;
+
+		if (rect.left < 0 || rect.top < 0 || rect.width <= 0 || rect.height <= 0) return false;
+		if (slice.left < 0 || slice.top < 0 || slice.right < 0 || slice.bottom < 0) return false;
+
+		return static_cast<unsigned int>(rect.left) + static_cast<unsigned int>(rect.width) <= pageSize.x
+			&& static_cast<unsigned int>(rect.top) + static_cast<unsigned int>(rect.height) <= pageSize.y
+			&& static_cast<unsigned int>(slice.left) + static_cast<unsigned int>(slice.right) <= static_cast<unsigned int>(rect.width)
+			&& static_cast<unsigned int>(slice.top) + static_cast<unsigned int>(slice.bottom) <= static_cast<unsigned int>(rect.height);
+	}
+
+	bool isValidName(const std::string& name)
+	{
+		return !name.empty() && std::none_of(name.begin(), name.end(),
+			[](char character) { return std::isspace(static_cast<unsigned char>(character)); });
+	}
+}
+
+void AtlasRegion::append(sf::VertexArray& vertices, const sf::FloatRect& area, const sf::Color& color,
+	const sf::Transform& transform) const
+{
+	sf::Vertex built[TextureAtlasConstants::REGION_VERTICES];
+	const std::size_t count = build(built, area, color, transform);
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		vertices.append(built[i]);
+	}
+}
+
+std::size_t AtlasRegion::build(sf::Vertex* vertices, const sf::FloatRect& area, const sf::Color& color,
+	const sf::Transform& transform) const
+{
+	float left = static_cast<float>(slice.left);
+	float right = static_cast<float>(slice.right);
+	float top = static_cast<float>(slice.top);
+	float bottom = static_cast<float>(slice.bottom);
+
+	// Borders wider than the area shrink together so opposite corners never overlap
+	if (left + right > area.width && left + right > 0.f)
+	{
+		const float scale = area.width / (left + right);
+		left *= scale;
+		right *= scale;
+	}
+	if (top + bottom > area.height && top + bottom > 0.f)
+	{
+		const float scale = area.height / (top + bottom);
+		top *= scale;
+		bottom *= scale;
+	}
+
+	const float x[4] = { area.left, area.left + left, area.left + area.width - right, area.left + area.width };
+	const float y[4] = { area.top, area.top + top, area.top + area.height - bottom, area.top + area.height };
+
+	const float u[4] =
+	{
+		static_cast<float>(rect.left),
+		static_cast<float>(rect.left + slice.left),
+		static_cast<float>(rect.left + rect.width - slice.right),
+		static_cast<float>(rect.left + rect.width)
+	};
+	const float v[4] =
+	{
+		static_cast<float>(rect.top),
+		static_cast<float>(rect.top + slice.top),
+		static_cast<float>(rect.top + rect.height - slice.bottom),
+		static_cast<float>(rect.top + rect.height)
+	};
+
+	std::size_t count = 0;
+
+	for (int row = 0; row < 3; ++row)
+	{
+		for (int column = 0; column < 3; ++column)
+		{
+			// Plain regions and zero borders leave empty cells
+			if (x[column + 1] <= x[column] || y[row + 1] <= y[row]) continue;
+
+			const sf::Vertex topLeft(transform.transformPoint(x[column], y[row]), color, { u[column], v[row] });
+			const sf::Vertex topRight(transform.transformPoint(x[column + 1], y[row]), color, { u[column + 1], v[row] });
+			const sf::Vertex bottomRight(transform.transformPoint(x[column + 1], y[row + 1]), color, { u[column + 1], v[row + 1] });
+			const sf::Vertex bottomLeft(transform.transformPoint(x[column], y[row + 1]), color, { u[column], v[row + 1] });
+
+			vertices[count++] = topLeft;
+			vertices[count++] = topRight;
+			vertices[count++] = bottomLeft;
+			vertices[count++] = bottomLeft;
+			vertices[count++] = topRight;
+			vertices[count++] = bottomRight;
+		}
+	}
+
+	return count;
+}
+
+void AtlasRegion::draw(sf::RenderTarget& target, const sf::FloatRect& area, const sf::Color& color,
+	const sf::Transform& transform) const
+{
+	if (!texture) return;
+
+	sf::Vertex vertices[TextureAtlasConstants::REGION_VERTICES];
+	target.draw(vertices, build(vertices, area, color, transform), sf::Triangles, sf::RenderStates(texture));
+}
+
+bool PackedAtlas::save(const std::string& indexPath) const
+{
+	const std::filesystem::path index(indexPath);
+
+	std::ofstream file(index);
+	if (!file) return false;
+
+	file << TextureAtlasConstants::INDEX_HEADER << '\n';
+
+	for (std::size_t i = 0; i < pages.size(); ++i)
+	{
+		const std::string pageName = index.stem().string() + '_' + std::to_string(i) + ".png";
+		if (!pages[i].saveToFile((index.parent_path() / pageName).string())) return false;
+
+		file << "page " << pageName << '\n';
+	}
+
+	for (const Entry& entry : entries)
+	{
+		file << "region " << entry.name << ' ' << entry.page << ' '
+			<< entry.rect.left << ' ' << entry.rect.top << ' ' << entry.rect.width << ' ' << entry.rect.height << ' '
+			<< entry.slice.left << ' ' << entry.slice.top << ' ' << entry.slice.right << ' ' << entry.slice.bottom << '\n';
+	}
+
+	return static_cast<bool>(file);
+}
+
+PackedAtlas PackedAtlas::load(const std::string& indexPath)
+{
+	std::ifstream file(indexPath);
+	std::string line;
+
+	if (!file || !std::getline(file, line) || line != TextureAtlasConstants::INDEX_HEADER)
+	{
+		throw FileLoadException(indexPath);
+	}
+
+	const std::filesystem::path directory = std::filesystem::path(indexPath).parent_path();
+	PackedAtlas packed;
+
+	while (std::getline(file, line))
+	{
+		std::istringstream stream(line);
+		std::string kind;
+		stream >> kind;
+
+		if (kind == "page")
+		{
+			std::string pageName;
+			stream >> pageName;
+
+			const std::string pagePath = (directory / pageName).string();
+			if (!packed.pages.emplace_back().loadFromFile(pagePath)) throw FileLoadException(pagePath);
+		}
+		else if (kind == "region")
+		{
+			Entry entry;
+			stream >> entry.name >> entry.page
+				>> entry.rect.left >> entry.rect.top >> entry.rect.width >> entry.rect.height
+				>> entry.slice.left >> entry.slice.top >> entry.slice.right >> entry.slice.bottom;
+
+			if (!stream || entry.page >= packed.pages.size()) throw FileLoadException(indexPath);
+
+			if (!fitsPage(entry, packed.pages[entry.page].getSize())) throw FileLoadException(indexPath);
+
+			packed.entries.push_back(std::move(entry));
+		}
+		else if (!kind.empty())
+		{
+			throw FileLoadException(indexPath);
+		}
+	}
+
+	return packed;
+}
+
+void TextureAtlasBuilder::add(const std::string& name, const sf::Image& image, const NineSlice& slice)
+{
+	const sf::Vector2u size = image.getSize();
+
+	if (!isValidName(name))
+	{
+		throw std::invalid_argument("Atlas image names can't be empty or contain spaces: '" + name + "'");
+	}
+	if (std::any_of(_images.begin(), _images.end(), [&name](const Source& source) { return source.name == name; }))
+	{
+		throw std::invalid_argument("Atlas image '" + name + "' is already added");
+	}
+	if (size.x == 0 || size.y == 0)
+	{
+		throw std::invalid_argument("Atlas image '" + name + "' is empty");
+	}
+	if (slice.left < 0 || slice.top < 0 || slice.right < 0 || slice.bottom < 0
+		|| static_cast<unsigned int>(slice.left + slice.right) > size.x
+		|| static_cast<unsigned int>(slice.top + slice.bottom) > size.y)
+	{
+		throw std::invalid_argument("Nine-slice borders of '" + name + "' don't fit the image");
+	}
+
+	_images.push_back({ name, image, slice });
+}
+
+void TextureAtlasBuilder::addFile(const std::string& name, const std::string& path, const NineSlice& slice)
+{
+	sf::Image image;
+	if (!image.loadFromFile(path)) throw FileLoadException(path);
+
+	add(name, image, slice);
+}
+
+PackedAtlas TextureAtlasBuilder::pack(unsigned int pageSize) const
+{
+	const int size = static_cast<int>(pageSize);
+	const int padding = static_cast<int>(TextureAtlasConstants::PADDING);
+
+	// Tallest first keeps the skyline flat
+	std::vector<std::size_t> order(_images.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b)
+		{
+			const sf::Vector2u first = _images[a].image.getSize();
+			const sf::Vector2u second = _images[b].image.getSize();
+			return first.y != second.y ? first.y > second.y : first.x > second.x;
+		});
+
+	std::vector<Skyline> skylines;
+	std::vector<std::pair<std::size_t, sf::Vector2i>> slots(_images.size());
+
+	for (std::size_t index : order)
+	{
+		const sf::Vector2u imageSize = _images[index].image.getSize();
+		const int width = static_cast<int>(imageSize.x) + 2 * padding;
+		const int height = static_cast<int>(imageSize.y) + 2 * padding;
+
+		if (width > size || height > size)
+		{
+			throw std::invalid_argument("Atlas image '" + _images[index].name + "' is larger than a "
+				+ std::to_string(pageSize) + " pixel page");
+		}
+
+		std::size_t page = 0;
+		sf::Vector2i position;
+
+		while (page < skylines.size() && !skylines[page].insert(width, height, position)) ++page;
+
+		if (page == skylines.size())
+		{
+			skylines.emplace_back(size);
+			skylines.back().insert(width, height, position);
+		}
+
+		slots[index] = { page, position };
+	}
+
+	std::vector<std::vector<sf::Uint8>> pixels(skylines.size());
+	for (std::size_t page = 0; page < skylines.size(); ++page)
+	{
+		const sf::Vector2i& used = skylines[page].getUsedSize();
+		pixels[page].assign(static_cast<std::size_t>(used.x * used.y) * BYTES_PER_PIXEL, 0);
+	}
+
+	PackedAtlas packed;
+	packed.entries.reserve(_images.size());
+
+	for (std::size_t i = 0; i < _images.size(); ++i)
+	{
+		const auto& [page, position] = slots[i];
+		const Source& source = _images[i];
+		const sf::Vector2u imageSize = source.image.getSize();
+
+		blit(pixels[page], skylines[page].getUsedSize().x, source.image,
+			position.x + padding, position.y + padding, padding);
+
+		packed.entries.push_back({ source.name, page,
+			sf::IntRect(position.x + padding, position.y + padding, static_cast<int>(imageSize.x), static_cast<int>(imageSize.y)),
+			source.slice });
+	}
+
+	packed.pages.resize(skylines.size());
+	for (std::size_t page = 0; page < skylines.size(); ++page)
+	{
+		const sf::Vector2i& used = skylines[page].getUsedSize();
+		packed.pages[page].create(static_cast<unsigned int>(used.x), static_cast<unsigned int>(used.y), pixels[page].data());
+	}
+
+	return packed;
+}
+
+TextureAtlas::TextureAtlas(const PackedAtlas& packed)
+{
+	_pages.reserve(packed.pages.size());
+
+	for (const sf::Image& page : packed.pages)
+	{
+		auto texture = std::make_unique<sf::Texture>();
+		if (!texture->loadFromImage(page)) throw FileLoadException("texture atlas page");
+
+		// Safe with the edge padding: filtering never samples a neighbouring region
+		texture->setSmooth(true);
+		_pages.push_back(std::move(texture));
+	}
+
+	for (const PackedAtlas::Entry& entry : packed.entries)
+	{
+		_regions[entry.name] = AtlasRegion{ _pages[entry.page].get(), entry.rect, entry.slice };
+	}
+}
+
+const AtlasRegion* TextureAtlas::find(const std::string& name) const
+{
+	auto found = _regions.find(name);
+	return found != _regions.end() ? &found->second : nullptr;
+}
+
+const AtlasRegion& TextureAtlas::get(const std::string& name) const
+{
+	const AtlasRegion* region = find(name);
+	if (!region) throw std::invalid_argument("No atlas region named '" + name + "'");
+
+	return *region;
+}
\ No newline at end of file
@@ -0,0 +1,139 @@
+#include <UpdateQueue.h>
+
+#include <algorithm>
+#include <cstdint>
+
+#include <Profiler.h>
+
+namespace
+{
+	constexpr std::size_t POSITION_MASK = UpdateQueueConstants::CAPACITY - 1;
+
+	static_assert((UpdateQueueConstants::CAPACITY & POSITION_MASK) == 0,
+		"UpdateQueue capacity must be a power of two");
+}
+
+UpdateQueue& UpdateQueue::getInstance()
+{
+	static UpdateQueue instance;
+	return instance;
+}
+
+UpdateQueue::UpdateQueue()
+	:_cells(std::make_unique<Cell[]>(UpdateQueueConstants::CAPACITY))
+{
+	for (std::size_t i = 0; i < UpdateQueueConstants::CAPACITY; ++i)
+	{
+		_cells[i].sequence.store(i, std::memory_order_relaxed);
+	}
+}
+
+bool UpdateQueue::post(const void* owner, Command command)
+{
+	std::size_t position = _enqueuePosition.load(std::memory_order_relaxed);
+
+	// Each cell's sequence says whose turn it is: equal to the position when free
+	// for this lap, one ahead once written, a lap ahead once the UI thread took it
+	for (;;)
+	{
+		Cell& cell = _cells[position & POSITION_MASK];
+		const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+		const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+
+		if (difference == 0)
+		{
+			if (_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+			{
+				cell.owner = owner;
+				cell.command = std::move(command);
+				cell.sequence.store(position + 1, std::memory_order_release);
+				return true;
+			}
+		}
+		else if (difference < 0)
+		{
+			return false;
+		}
+		else
+		{
+			position = _enqueuePosition.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+std::size_t UpdateQueue::drain()
+{
+	std::size_t position = _dequeuePosition.load(std::memory_order_relaxed);
+
+	// Commands posted while draining wait for the next frame
+	const std::size_t end = _enqueuePosition.load(std::memory_order_acquire);
+	if (position == end) return 0;
+
+	const ScopedTimer timer("UpdateQueue::drain");
+	std::size_t executed = 0;
+
+	while (position != end)
+	{
+		Cell& cell = _cells[position & POSITION_MASK];
+
+		// A producer claimed this cell but hasn't finished writing it
+		if (cell.sequence.load(std::memory_order_acquire) != position + 1) break;
+
+		const void* owner = cell.owner;
+		Command command = std::move(cell.command);
+		cell.command = nullptr;
+		cell.sequence.store(position + UpdateQueueConstants::CAPACITY, std::memory_order_release);
+
+		_dequeuePosition.store(++position, std::memory_order_relaxed);
+
+		if (isDiscarded(owner, position - 1)) continue;
+
+		command();
+		++executed;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_discardedMutex);
+		std::erase_if(_discarded, [position](const Discarded& discarded)
+			{
+				return discarded.before <= position;
+			});
+	}
+
+	Profiler::getInstance().increment(ProfilerCounter::QueuedUpdates, static_cast<std::uint32_t>(executed));
+	return executed;
+}
+
+void UpdateQueue::discard(const void* owner)
+{
+	const std::size_t before = _enqueuePosition.load(std::memory_order_acquire);
+	if (before == _dequeuePosition.load(std::memory_order_relaxed)) return;
+
+	// Only commands posted so far belong to the old owner; a new object at the same address keeps its own
+	std::lock_guard<std::mutex> lock(_discardedMutex);
+	_discarded.push_back({ owner, before });
+}
+
+bool UpdateQueue::isEmpty() const
+{
+	return getPendingCount() == 0;
+}
+
+std::size_t UpdateQueue::getPendingCount() const
+{
+	const std::size_t dequeued = _dequeuePosition.load(std::memory_order_relaxed);
+	const std::size_t enqueued = _enqueuePosition.load(std::memory_order_relaxed);
+
+	return enqueued > dequeued ? enqueued - dequeued : 0;
+}
+
+bool UpdateQueue::isDiscarded(const void* owner, std::size_t position)
+{
+	// Not held while a command runs: the command may destroy a widget and discard it in turn
+	std::lock_guard<std::mutex> lock(_discardedMutex);
+
+	return std::any_of(_discarded.begin(), _discarded.end(), [owner, position](const Discarded& discarded)
+		{
+			return discarded.owner == owner && position < discarded.before;
+		});
+}
\ No newline at end of file
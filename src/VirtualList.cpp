@@ -0,0 +1,495 @@
+#include <Graphics/InterfaceElements/VirtualList.h>
+
+#include <cmath>
+#include <stdexcept>
+
+#include <Profiler.h>
+
+VirtualList::VirtualList(RowFactory factory, RowBinder binder)
+	:_factory(std::move(factory)),
+	_binder(std::move(binder)),
+	_itemCount(0),
+	_columns(1),
+	_rowHeight(32.f),
+	_spacing(4.f),
+	_offset(0.f),
+	_targetOffset(0.f),
+	_firstItem(0),
+	_hoveredItem(VirtualListConstants::NO_ITEM),
+	_capturedItem(VirtualListConstants::NO_ITEM),
+	_focusedItem(VirtualListConstants::NO_ITEM)
+{
+	if (!_factory || !_binder)
+	{
+		throw std::invalid_argument("VirtualList needs a row factory and a binder");
+	}
+
+	_background.setSize({ 200.f, 300.f });
+	_background.setFillColor(sf::Color(30, 30, 30));
+
+	_scrollbar.setFillColor(sf::Color(120, 120, 120));
+}
+
+VirtualList::~VirtualList()
+{
+	AnimationScheduler::getInstance().cancel(this);
+}
+
+void VirtualList::setItemCount(std::size_t count)
+{
+	_itemCount = count;
+
+	auto forget = [count](std::size_t& item)
+		{
+			if (item != VirtualListConstants::NO_ITEM && item >= count) item = VirtualListConstants::NO_ITEM;
+		};
+
+	forget(_hoveredItem);
+	forget(_capturedItem);
+	forget(_focusedItem);
+
+	clampScroll();
+	layoutRows(true);
+}
+
+std::size_t VirtualList::getItemCount() const
+{
+	return _itemCount;
+}
+
+void VirtualList::setRowHeight(float height)
+{
+	if (height <= 0.f || height == _rowHeight) return;
+
+	_rowHeight = height;
+	clampScroll();
+	layoutRows();
+}
+
+void VirtualList::setColumns(std::size_t columns)
+{
+	if (columns == 0 || columns == _columns) return;
+
+	_columns = columns;
+	clampScroll();
+	layoutRows();
+}
+
+void VirtualList::setSpacing(float spacing)
+{
+	if (spacing < 0.f || spacing == _spacing) return;
+
+	_spacing = spacing;
+	clampScroll();
+	layoutRows();
+}
+
+void VirtualList::setBackgroundColor(const sf::Color& color)
+{
+	_background.setFillColor(color);
+	invalidate();
+}
+
+void VirtualList::refresh()
+{
+	layoutRows(true);
+}
+
+void VirtualList::scrollTo(std::size_t index)
+{
+	if (index >= _itemCount) return;
+
+	const float top = static_cast<float>(index / _columns) * rowStride();
+	const float height = _background.getSize().y;
+
+	if (top < _targetOffset)
+	{
+		setScrollOffset(top);
+	}
+	else if (top + _rowHeight > _targetOffset + height)
+	{
+		setScrollOffset(top + _rowHeight - height);
+	}
+}
+
+void VirtualList::setScrollOffset(float offset, bool smooth)
+{
+	_targetOffset = std::clamp(offset, 0.f, maxOffset());
+
+	if (_offset == _targetOffset) return;
+
+	if (smooth)
+	{
+		AnimationScheduler::getInstance().tween(this, 0, _offset, _targetOffset,
+			VirtualListConstants::SCROLL_DURATION, Easing::OutCubic,
+			[this](float value)
+			{
+				_offset = value;
+				layoutRows();
+			});
+	}
+	else
+	{
+		AnimationScheduler::getInstance().cancel(this);
+		_offset = _targetOffset;
+		layoutRows();
+	}
+}
+
+float VirtualList::getScrollOffset() const
+{
+	return _offset;
+}
+
+void VirtualList::update()
+{
+	// Rows animate on their own (hover fades etc.), the canvas only sees the list
+	for (const Row* row : _window)
+	{
+		if (row->widget->isDirty())
+		{
+			invalidate();
+			break;
+		}
+	}
+}
+
+void VirtualList::forEachRow(const std::function<void(Widget& row, std::size_t index)>& callback)
+{
+	for (Row* row : _window)
+	{
+		callback(*row->widget, row->index);
+	}
+}
+
+void VirtualList::setPosition(const sf::Vector2f& pos)
+{
+	if (_background.getPosition() == pos) return;
+
+	_background.setPosition(pos);
+	layoutRows();
+	invalidateBounds();
+}
+
+void VirtualList::setSize(const sf::Vector2f& size)
+{
+	if (size.x <= 0.f || size.y <= 0.f || _background.getSize() == size) return;
+
+	_background.setSize(size);
+	clampScroll();
+	layoutRows();
+	invalidateBounds();
+}
+
+void VirtualList::draw(sf::RenderTarget& target)
+{
+	target.draw(_background);
+
+	sf::View clip;
+	if (makeClipView(target, clip))
+	{
+		const sf::View previous = target.getView();
+		target.setView(clip);
+
+		for (Row* row : _window)
+		{
+			row->widget->draw(target);
+			row->widget->clearDirty();
+		}
+
+		target.setView(previous);
+	}
+
+	if (maxOffset() > 0.f)
+	{
+		const sf::FloatRect thumb = scrollbarThumb();
+		_scrollbar.setPosition(thumb.left, thumb.top);
+		_scrollbar.setSize({ thumb.width, thumb.height });
+		target.draw(_scrollbar);
+	}
+}
+
+void VirtualList::draw(BatchRenderer& renderer)
+{
+	renderer.addShape(_background);
+
+	sf::RenderTarget& target = renderer.getTarget();
+
+	sf::View clip;
+	if (makeClipView(target, clip))
+	{
+		// Everything queued so far belongs to the outer view
+		renderer.flush();
+
+		const sf::View previous = target.getView();
+		target.setView(clip);
+
+		for (Row* row : _window)
+		{
+			row->widget->draw(renderer);
+			row->widget->clearDirty();
+		}
+
+		renderer.flush();
+		target.setView(previous);
+	}
+
+	if (maxOffset() > 0.f)
+	{
+		renderer.addRect(scrollbarThumb(), _scrollbar.getFillColor());
+	}
+}
+
+void VirtualList::handleEvent(const sf::RenderTarget& target, const sf::Event& event)
+{
+	sf::Vector2f mousePos;
+
+	if (!getEventPosition(target, event, mousePos))
+	{
+		// Keyboard and text input belong to the row that was clicked last
+		deliver(_focusedItem, target, event);
+		return;
+	}
+
+	const std::size_t item = itemAt(mousePos);
+
+	switch (event.type)
+	{
+	case sf::Event::MouseWheelScrolled:
+		if (getBounds().contains(mousePos))
+		{
+			setScrollOffset(_targetOffset -
+				event.mouseWheelScroll.delta * VirtualListConstants::WHEEL_ROWS * rowStride());
+		}
+		break;
+	case sf::Event::MouseMoved:
+		// Rows the cursor left still see the move so they can drop their hover state
+		if (_hoveredItem != item) deliver(_hoveredItem, target, event);
+		if (_capturedItem != item && _capturedItem != _hoveredItem) deliver(_capturedItem, target, event);
+
+		_hoveredItem = item;
+		deliver(item, target, event);
+		break;
+	case sf::Event::MouseButtonPressed:
+		if (_focusedItem != item) deliver(_focusedItem, target, event);
+
+		_focusedItem = item;
+		_capturedItem = item;
+		deliver(item, target, event);
+		break;
+	case sf::Event::MouseButtonReleased:
+		deliver(item, target, event);
+		if (_capturedItem != item) deliver(_capturedItem, target, event);
+
+		_capturedItem = VirtualListConstants::NO_ITEM;
+		break;
+	default:
+		break;
+	}
+}
+
+sf::FloatRect VirtualList::getBounds() const
+{
+	return _background.getGlobalBounds();
+}
+
+float VirtualList::rowStride() const
+{
+	return _rowHeight + _spacing;
+}
+
+std::size_t VirtualList::rowCount() const
+{
+	return (_itemCount + _columns - 1) / _columns;
+}
+
+float VirtualList::maxOffset() const
+{
+	const float content = static_cast<float>(rowCount()) * rowStride() - _spacing;
+	return std::max(0.f, content - _background.getSize().y);
+}
+
+sf::Vector2f VirtualList::cellSize() const
+{
+	// The scrollbar keeps its own column on the right
+	const float width = _background.getSize().x - VirtualListConstants::SCROLLBAR_WIDTH - _spacing;
+	const float columns = static_cast<float>(_columns);
+
+	return { std::max(1.f, (width - (columns - 1.f) * _spacing) / columns), _rowHeight };
+}
+
+void VirtualList::clampScroll()
+{
+	const float limit = maxOffset();
+
+	_offset = std::clamp(_offset, 0.f, limit);
+	_targetOffset = std::clamp(_targetOffset, 0.f, limit);
+}
+
+void VirtualList::ensurePool()
+{
+	const float stride = rowStride();
+	const auto visibleRows = static_cast<std::size_t>(std::ceil(_background.getSize().y / stride)) + 1;
+	const std::size_t needed = visibleRows * _columns;
+
+	while (_rows.size() < needed)
+	{
+		std::unique_ptr<Widget> widget = _factory();
+		if (!widget)
+		{
+			throw std::invalid_argument("VirtualList row factory returned no widget");
+		}
+
+		_rows.push_back({ std::move(widget), VirtualListConstants::NO_ITEM });
+	}
+}
+
+void VirtualList::layoutRows(bool rebindAll)
+{
+	const ScopedTimer timer("VirtualList::layoutRows");
+
+	ensurePool();
+
+	const float stride = rowStride();
+	const auto visibleRows = static_cast<std::size_t>(std::ceil(_background.getSize().y / stride)) + 1;
+	const auto firstRow = static_cast<std::size_t>(_offset / stride);
+
+	_firstItem = std::min(firstRow * _columns, _itemCount);
+	const std::size_t lastItem = std::min(_firstItem + visibleRows * _columns, _itemCount);
+
+	// Rows still showing an item of the new window keep it, the rest get recycled
+	_window.assign(lastItem - _firstItem, nullptr);
+	_freeRows.clear();
+
+	for (Row& row : _rows)
+	{
+		if (!rebindAll && row.index >= _firstItem && row.index < lastItem)
+		{
+			_window[row.index - _firstItem] = &row;
+		}
+		else
+		{
+			row.index = VirtualListConstants::NO_ITEM;
+			_freeRows.push_back(&row);
+		}
+	}
+
+	const sf::Vector2f cell = cellSize();
+	const sf::Vector2f origin = _background.getPosition();
+
+	for (std::size_t i = 0; i < _window.size(); ++i)
+	{
+		const std::size_t index = _firstItem + i;
+		Row*& row = _window[i];
+
+		if (!row)
+		{
+			row = _freeRows.back();
+			_freeRows.pop_back();
+
+			row->index = index;
+			_binder(*row->widget, index);
+		}
+
+		const float column = static_cast<float>(index % _columns);
+		const float line = static_cast<float>(index / _columns);
+
+		row->widget->setPosition({
+			origin.x + column * (cell.x + _spacing),
+			origin.y + line * stride - _offset });
+		row->widget->setSize(cell);
+	}
+
+	invalidate();
+}
+
+Widget* VirtualList::rowFor(std::size_t index) const
+{
+	if (index == VirtualListConstants::NO_ITEM || index < _firstItem || index - _firstItem >= _window.size())
+	{
+		return nullptr;
+	}
+
+	return _window[index - _firstItem]->widget.get();
+}
+
+std::size_t VirtualList::itemAt(const sf::Vector2f& point) const
+{
+	if (!getBounds().contains(point)) return VirtualListConstants::NO_ITEM;
+
+	const sf::Vector2f local = point - _background.getPosition();
+	const sf::Vector2f cell = cellSize();
+	const float stride = rowStride();
+
+	const float y = local.y + _offset;
+	const auto line = static_cast<std::size_t>(y / stride);
+	const auto column = static_cast<std::size_t>(local.x / (cell.x + _spacing));
+
+	// Gaps between cells belong to no item
+	if (y - static_cast<float>(line) * stride > _rowHeight ||
+		local.x - static_cast<float>(column) * (cell.x + _spacing) > cell.x ||
+		column >= _columns)
+	{
+		return VirtualListConstants::NO_ITEM;
+	}
+
+	const std::size_t index = line * _columns + column;
+	return index < _itemCount ? index : VirtualListConstants::NO_ITEM;
+}
+
+void VirtualList::deliver(std::size_t index, const sf::RenderTarget& target, const sf::Event& event)
+{
+	Widget* row = rowFor(index);
+	if (!row) return;
+
+	row->handleEvent(target, event);
+
+	if (row->isDirty())
+	{
+		invalidate();
+	}
+}
+
+bool VirtualList::makeClipView(const sf::RenderTarget& target, sf::View& clip) const
+{
+	// Intersect with the current view so the list also clips inside a canvas region repaint;
+	// assumes the view is not rotated
+	const sf::View& current = target.getView();
+	const sf::FloatRect visible(current.getCenter() - current.getSize() / 2.f, current.getSize());
+
+	sf::FloatRect region;
+	if (!getBounds().intersects(visible, region)) return false;
+
+	const sf::IntRect viewport = target.getViewport(current);
+	const sf::Vector2u size = target.getSize();
+
+	const float scaleX = static_cast<float>(viewport.width) / visible.width;
+	const float scaleY = static_cast<float>(viewport.height) / visible.height;
+
+	clip.reset(region);
+	clip.setViewport(sf::FloatRect(
+		(static_cast<float>(viewport.left) + (region.left - visible.left) * scaleX) / static_cast<float>(size.x),
+		(static_cast<float>(viewport.top) + (region.top - visible.top) * scaleY) / static_cast<float>(size.y),
+		region.width * scaleX / static_cast<float>(size.x),
+		region.height * scaleY / static_cast<float>(size.y)));
+
+	return true;
+}
+
+sf::FloatRect VirtualList::scrollbarThumb() const
+{
+	const sf::Vector2f position = _background.getPosition();
+	const sf::Vector2f size = _background.getSize();
+
+	const float content = static_cast<float>(rowCount()) * rowStride() - _spacing;
+	const float height = std::clamp(size.y * size.y / content, 20.f, size.y);
+	const float limit = maxOffset();
+	const float progress = limit > 0.f ? _offset / limit : 0.f;
+
+	return {
+		position.x + size.x - VirtualListConstants::SCROLLBAR_WIDTH,
+		position.y + (size.y - height) * progress,
+		VirtualListConstants::SCROLLBAR_WIDTH,
+		height
+	};
+}
\ No newline at end of file
@@ -0,0 +1,241 @@
+#include <WidgetContainer.h>
+
+#include <algorithm>
+
+#include <Profiler.h>
+
+WidgetContainer::WidgetContainer(float cellSize)
+	:_grid(cellSize),
+	_nextSequence(0),
+	_focus(nullptr),
+	_capture(nullptr),
+	_boundsListener(nullptr)
+{
+}
+
+WidgetContainer::~WidgetContainer()
+{
+	for (Widget* widget : _widgets)
+	{
+		widget->setObserver(nullptr);
+	}
+}
+
+void WidgetContainer::add(Widget& widget)
+{
+	if (_order.count(&widget)) return;
+
+	_order.emplace(&widget, Entry{ _nextSequence++, false });
+	_widgets.push_back(&widget);
+
+	widget.setObserver(this);
+	_grid.insert(&widget, widget.getBounds());
+}
+
+void WidgetContainer::remove(Widget& widget)
+{
+	auto it = _order.find(&widget);
+	if (it == _order.end()) return;
+
+	const Entry entry = it->second;
+
+	// _widgets is in insertion order, so its slot is found by sequence
+	auto position = std::lower_bound(_widgets.begin(), _widgets.end(), entry.sequence,
+		[this](const Widget* other, std::uint64_t sequence)
+		{
+			return _order.at(other).sequence < sequence;
+		});
+
+	_widgets.erase(position);
+	_order.erase(it);
+
+	if (entry.isStale) std::erase(_staleWidgets, &widget);
+
+	// A handler may remove widgets while dispatch() walks these, so the slots are cleared instead of erased
+	std::replace(_hits.begin(), _hits.end(), &widget, static_cast<Widget*>(nullptr));
+	std::replace(_hovered.begin(), _hovered.end(), &widget, static_cast<Widget*>(nullptr));
+	std::replace(_delivered.begin(), _delivered.end(), &widget, static_cast<Widget*>(nullptr));
+
+	if (_focus == &widget) _focus = nullptr;
+	if (_capture == &widget) _capture = nullptr;
+
+	widget.setObserver(nullptr);
+	_grid.remove(&widget);
+}
+
+void WidgetContainer::clear()
+{
+	for (Widget* widget : _widgets)
+	{
+		widget->setObserver(nullptr);
+	}
+
+	_widgets.clear();
+	_order.clear();
+	_staleWidgets.clear();
+	std::fill(_hits.begin(), _hits.end(), nullptr);
+	std::fill(_hovered.begin(), _hovered.end(), nullptr);
+	std::fill(_delivered.begin(), _delivered.end(), nullptr);
+	_grid.clear();
+
+	_focus = nullptr;
+	_capture = nullptr;
+
+	for (auto& [type, pool] : _pools)
+	{
+		pool->clear();
+	}
+}
+
+void WidgetContainer::dispatch(const sf::RenderTarget& target, const sf::Event& event)
+{
+	refreshIndex();
+	_delivered.clear();
+
+	switch (event.type)
+	{
+	case sf::Event::MouseMoved:
+	{
+		widgetsAt(target.mapPixelToCoords({ event.mouseMove.x, event.mouseMove.y }), _hits);
+
+		for (Widget* widget : _hits) deliver(widget, target, event);
+		// Widgets the cursor just left still need the move to drop their hover state
+		for (Widget* widget : _hovered) deliver(widget, target, event);
+		deliver(_capture, target, event);
+
+		_hovered.swap(_hits);
+		std::erase(_hovered, nullptr);
+		break;
+	}
+	case sf::Event::MouseButtonPressed:
+	{
+		widgetsAt(target.mapPixelToCoords({ event.mouseButton.x, event.mouseButton.y }), _hits);
+
+		for (Widget* widget : _hits) deliver(widget, target, event);
+		// The previous focus sees the click so it can deactivate itself
+		deliver(_focus, target, event);
+
+		// Topmost hit that is still in the container and takes input; an overlay on top must not steal the focus
+		auto top = std::find_if(_hits.rbegin(), _hits.rend(), [](const Widget* widget)
+			{
+				return widget && widget->acceptsInput();
+			});
+
+		_focus = top == _hits.rend() ? nullptr : *top;
+		_capture = _focus;
+		break;
+	}
+	case sf::Event::MouseButtonReleased:
+	{
+		widgetsAt(target.mapPixelToCoords({ event.mouseButton.x, event.mouseButton.y }), _hits);
+
+		for (Widget* widget : _hits) deliver(widget, target, event);
+		deliver(_capture, target, event);
+
+		_capture = nullptr;
+		break;
+	}
+	case sf::Event::MouseWheelScrolled:
+	{
+		widgetsAt(target.mapPixelToCoords({ event.mouseWheelScroll.x, event.mouseWheelScroll.y }), _hits);
+
+		for (Widget* widget : _hits) deliver(widget, target, event);
+		break;
+	}
+	case sf::Event::TextEntered:
+	case sf::Event::KeyPressed:
+	case sf::Event::KeyReleased:
+		deliver(_focus, target, event);
+		break;
+	default:
+		broadcast(target, event);
+		break;
+	}
+}
+
+void WidgetContainer::setFocus(Widget* widget)
+{
+	_focus = widget;
+}
+
+Widget* WidgetContainer::getFocus() const
+{
+	return _focus;
+}
+
+void WidgetContainer::widgetsAt(const sf::Vector2f& point, std::vector<Widget*>& result)
+{
+	refreshIndex();
+
+	result.clear();
+	_grid.query(point, result);
+
+	std::sort(result.begin(), result.end(), [this](const Widget* a, const Widget* b)
+		{
+			return _order.at(a).sequence < _order.at(b).sequence;
+		});
+}
+
+const std::vector<Widget*>& WidgetContainer::getWidgets() const
+{
+	return _widgets;
+}
+
+void WidgetContainer::setBoundsListener(WidgetObserver* listener)
+{
+	_boundsListener = listener;
+}
+
+void WidgetContainer::onBoundsChanged(Widget& widget)
+{
+	auto it = _order.find(&widget);
+
+	if (it != _order.end() && !it->second.isStale)
+	{
+		it->second.isStale = true;
+		_staleWidgets.push_back(&widget);
+	}
+
+	if (_boundsListener) _boundsListener->onBoundsChanged(widget);
+}
+
+void WidgetContainer::refreshIndex()
+{
+	for (Widget* widget : _staleWidgets)
+	{
+		_grid.update(widget, widget->getBounds());
+		_order.at(widget).isStale = false;
+	}
+
+	_staleWidgets.clear();
+}
+
+void WidgetContainer::deliver(Widget* widget, const sf::RenderTarget& target, const sf::Event& event)
+{
+	if (!widget || wasDelivered(widget)) return;
+
+	_delivered.push_back(widget);
+
+	const ScopedTimer timer("Widget::handleEvent");
+	Profiler::getInstance().increment(ProfilerCounter::EventDispatches);
+	widget->handleEvent(target, event);
+}
+
+void WidgetContainer::broadcast(const sf::RenderTarget& target, const sf::Event& event)
+{
+	const ScopedTimer timer("WidgetContainer::broadcast");
+	Profiler::getInstance().increment(ProfilerCounter::EventDispatches, static_cast<std::uint32_t>(_widgets.size()));
+
+	// Walks a snapshot: handlers may remove widgets, which only clears their slots in _hits
+	_hits.assign(_widgets.begin(), _widgets.end());
+
+	for (Widget* widget : _hits)
+	{
+		if (widget) widget->handleEvent(target, event);
+	}
+}
+
+bool WidgetContainer::wasDelivered(const Widget* widget) const
+{
+	return std::find(_delivered.begin(), _delivered.end(), widget) != _delivered.end();
+}
\ No newline at end of file
@@ -0,0 +1,209 @@
+#include <Graphics/InterfaceElements/WidgetGroup.h>
+
+#include <algorithm>
+
+#include <SFML/Graphics/View.hpp>
+
+#include <Profiler.h>
+
+WidgetGroup::WidgetGroup()
+{
+	_children.setBoundsListener(this);
+}
+
+WidgetGroup::~WidgetGroup()
+{
+	_children.setBoundsListener(nullptr);
+}
+
+void WidgetGroup::add(Widget& child, const sf::Vector2f& localPosition)
+{
+	if (find(child)) return;
+
+	_entries.push_back({ &child, localPosition, dynamic_cast<WidgetGroup*>(&child) });
+	place(_entries.back());
+
+	_children.add(child);
+
+	_areBoundsStale = true;
+	invalidateBounds();
+}
+
+void WidgetGroup::remove(Widget& child)
+{
+	auto it = std::find_if(_entries.begin(), _entries.end(), [&child](const Child& entry) { return entry.widget == &child; });
+	if (it == _entries.end()) return;
+
+	_entries.erase(it);
+	_children.remove(child);
+
+	_areBoundsStale = true;
+	invalidateBounds();
+}
+
+void WidgetGroup::clear()
+{
+	_entries.clear();
+	_children.clear();
+
+	_areBoundsStale = true;
+	invalidateBounds();
+}
+
+void WidgetGroup::setLocalPosition(Widget& child, const sf::Vector2f& localPosition)
+{
+	Child* entry = find(child);
+	if (!entry || entry->localPosition == localPosition) return;
+
+	entry->localPosition = localPosition;
+	place(*entry);
+}
+
+sf::Vector2f WidgetGroup::getLocalPosition(const Widget& child) const
+{
+	const Child* entry = find(child);
+	return entry ? entry->localPosition : sf::Vector2f();
+}
+
+const std::vector<Widget*>& WidgetGroup::getChildren() const
+{
+	return _children.getWidgets();
+}
+
+void WidgetGroup::update(const sf::FloatRect& visibleArea)
+{
+	if (!getBounds().intersects(visibleArea))
+	{
+		Profiler::getInstance().increment(ProfilerCounter::CulledWidgets);
+		return;
+	}
+
+	bool hasChanged = false;
+
+	for (Child& child : _entries)
+	{
+		if (child.group) child.group->update(visibleArea);
+
+		// Hidden children stay dirty and are picked up once they come into view
+		if (child.widget->isDirty() && child.widget->getBounds().intersects(visibleArea))
+		{
+			child.widget->clearDirty();
+			hasChanged = true;
+		}
+	}
+
+	if (hasChanged) invalidate();
+}
+
+sf::FloatRect WidgetGroup::getVisibleArea(const sf::RenderTarget& target)
+{
+	const sf::View& view = target.getView();
+	return { view.getCenter() - view.getSize() / 2.f, view.getSize() };
+}
+
+void WidgetGroup::setPosition(const sf::Vector2f& pos)
+{
+	if (_position == pos) return;
+
+	_position = pos;
+
+	_isPlacing = true;
+	for (Child& child : _entries)
+	{
+		place(child);
+	}
+	_isPlacing = false;
+
+	_areBoundsStale = true;
+	invalidateBounds();
+}
+
+const sf::Vector2f& WidgetGroup::getPosition() const
+{
+	return _position;
+}
+
+void WidgetGroup::setSize(const sf::Vector2f&)
+{
+}
+
+void WidgetGroup::draw(sf::RenderTarget& target)
+{
+	const sf::FloatRect visibleArea = getVisibleArea(target);
+	if (!getBounds().intersects(visibleArea)) return;
+
+	for (Widget* child : _children.getWidgets())
+	{
+		if (child->getBounds().intersects(visibleArea))
+		{
+			child->draw(target);
+		}
+		else
+		{
+			Profiler::getInstance().increment(ProfilerCounter::CulledWidgets);
+		}
+	}
+}
+
+void WidgetGroup::draw(BatchRenderer& renderer)
+{
+	// The retained canvas narrows the view to the region it repaints, so this culls to that region too
+	const sf::FloatRect visibleArea = getVisibleArea(renderer.getTarget());
+	if (!getBounds().intersects(visibleArea)) return;
+
+	for (Widget* child : _children.getWidgets())
+	{
+		if (child->getBounds().intersects(visibleArea))
+		{
+			child->draw(renderer);
+		}
+		else
+		{
+			Profiler::getInstance().increment(ProfilerCounter::CulledWidgets);
+		}
+	}
+}
+
+sf::FloatRect WidgetGroup::getBounds() const
+{
+	if (!_areBoundsStale) return _bounds;
+
+	_bounds = sf::FloatRect(_position, {});
+	for (Widget* child : _children.getWidgets())
+	{
+		_bounds = uniteBounds(_bounds, child->getBounds());
+	}
+
+	_areBoundsStale = false;
+	return _bounds;
+}
+
+void WidgetGroup::handleEvent(const sf::RenderTarget& target, const sf::Event& event)
+{
+	_children.dispatch(target, event);
+}
+
+void WidgetGroup::onBoundsChanged(Widget&)
+{
+	if (_isPlacing) return;
+
+	_areBoundsStale = true;
+	invalidateBounds();
+}
+
+void WidgetGroup::place(Child& child)
+{
+	child.widget->setPosition(_position + child.localPosition);
+}
+
+WidgetGroup::Child* WidgetGroup::find(const Widget& widget)
+{
+	auto it = std::find_if(_entries.begin(), _entries.end(), [&widget](const Child& entry) { return entry.widget == &widget; });
+	return it != _entries.end() ? &*it : nullptr;
+}
+
+const WidgetGroup::Child* WidgetGroup::find(const Widget& widget) const
+{
+	auto it = std::find_if(_entries.begin(), _entries.end(), [&widget](const Child& entry) { return entry.widget == &widget; });
+	return it != _entries.end() ? &*it : nullptr;
+}
\ No newline at end of file
@@ -4,26 +4,11 @@ void Engine::initVariables()
 {
 	_windowTitle = "Test";
 	_window = nullptr;
-	_event = {};
 }
 
 void Engine::uploadResources()
 {
-	if (!_font.loadFromFile(_fontPath))
-	{
-		throw FontException(_fontPath);
-	}
-
-	DefaultButtonFactory defaultButtonFactory(_font);
-	DefaultCheckBoxFactory defaultCheckBoxFactory;
-
-	_buttons.push_back(defaultButtonFactory.createButton("some kind of method", { 400, 50 }));
-	_buttons.push_back(defaultButtonFactory.createButton("some kind of method", { 400, 50 }));
-	_buttons.push_back(defaultButtonFactory.createButton("some kind of method", { 400, 50 }));
-	_buttons.push_back(defaultButtonFactory.createButton("some kind of method", { 400, 50 }));
-	_buttons.push_back(defaultButtonFactory.createButton("some kind of method", { 400, 50 }));
-
-	auto createCheckboxCallback = [](const std::string& name)
+	auto printToggle = [](const std::string& name)
 		{
 			return [name](bool checked)
 				{
@@ -43,77 +28,206 @@ void Engine::uploadResources()
 				};
 		};
 
-	auto checkbox = defaultCheckBoxFactory.createCheckBox(_font, "checkBox", { 300, 400 });
-	checkbox->setCallback(createCheckboxCallback("checkBox"));
-	auto checkbox1 = defaultCheckBoxFactory.createCheckBox(_font, "checkBox1", { 300, 400 });
-	checkbox1->setCallback(createCheckboxCallback("checkBox1"));
-	auto checkbox2 = defaultCheckBoxFactory.createCheckBox(_font, "checkBox2", { 300, 400 });
-	checkbox2->setCallback(createCheckboxCallback("checkBox2"));
-	_checkboxes.push_back(std::move(checkbox));
-	_checkboxes.push_back(std::move(checkbox1));
-	_checkboxes.push_back(std::move(checkbox2));
-
-	auto textField = std::make_unique<TextField>();
-	textField->setSize(sf::Vector2f(300.f, 50.f));
-	textField->setPosition(sf::Vector2f(400.f, 100.f));
-	_textFields.emplace_back(std::move(textField));
-
-	_volumeBar = std::make_unique<ProgressBar>(sf::Vector2f(300, 50), sf::Color(50, 50, 50), sf::Color::Green);
-	_volumeBar->setPosition(sf::Vector2f(30.f, 300.f));
-	_volumeBar->setOrientation(true);
-	_volumeBar->showPercentage(true, _font, 16);
-	_volumeBar->setMaxValue(100.f);
-	_volumeBar->setValue(1.f);
-	_volumeBar->_onValueChanged = [](float value)
+	for (const std::string name : { "checkBox", "checkBox1", "checkBox2" })
+	{
+		_bindings.bindToggle(name, printToggle(name));
+	}
+
+	_bindings.bindClick("generate", []()
+		{
+			std::cout << "Generate..." << std::endl;
+		});
+	_bindings.bindClick("second", []()
+		{
+			std::cout << "..." << std::endl;
+		});
+	_bindings.bindChange("volume", [](float value)
 		{
 			std::cout << "Volume changed: " << value << "%\n";
-		};
+		});
+
+	// Parsed and decoded in the background; the window opens meanwhile
+	_layoutDocument = _loader.load<LayoutDocument>(_layoutPath, [this]()
+		{
+			return std::make_shared<LayoutDocument>(LayoutDocument::load(_layoutPath, _layoutCachePath));
+		});
+	_fonts.push_back(_loader.loadFont(FontCacheConstants::DEFAULT_FONT_PATH));
+
+	_loadingBar = std::make_unique<ProgressBar>(sf::Vector2f(300.f, 12.f), sf::Color(50, 50, 50), sf::Color::Green);
+	_loadingBar->setSmoothness(0.3f);
+	_loadingBar->setPosition(sf::Vector2f(
+		(static_cast<float>(_window->getSize().x) - 300.f) / 2.f,
+		(static_cast<float>(_window->getSize().y) - 12.f) / 2.f));
+
+	_widgets.add(*_loadingBar);
+}
+
+void Engine::updateLoading()
+{
+	_loadingBar->setValue(_loader.getProgress() * 100.f);
 
-	auto setupAnchors = [](auto& anchors, auto& container, auto... args)
+	try
+	{
+		if (!_layoutDocument.isReady()) return;
+
+		// The layout names its fonts only once it's parsed
+		if (!_areLayoutFontsQueued)
 		{
-			anchors.resize(container.size());
-			for (size_t i = 0; i < container.size(); ++i)
+			for (const std::string& path : LayoutInstance::getFontPaths(*_layoutDocument.get()))
 			{
-				anchors[i].emplace(args..., [&container, i](const auto& offset, const auto& size)
-					{
-						if (i < container.size())
-						{
-
-							sf::Vector2f finalOffset =
-							{
-								offset.x,
-								offset.y + (static_cast<float>(i) * (size.y + 10))
-							};
-							container[i]->setPosition(finalOffset);
-							container[i]->setSize(size);
-						}
-					});
+				if (path != _fonts.front().getPath()) _fonts.push_back(_loader.loadFont(path));
 			}
-		};
+			_areLayoutFontsQueued = true;
+		}
+
+		if (!_loader.isIdle()) return;
+
+		// Rethrows what failed to load
+		for (const ResourceHandle<const sf::Font>& font : _fonts) font.get();
+
+		finishLoading();
+	}
+	catch (const BaseException& exception)
+	{
+		std::cerr << "RESOURCE ERROR: " << exception.what() << std::endl;
+		exit(EXIT_FAILURE);
+	}
+}
+
+void Engine::finishLoading()
+{
+	_screen = std::make_unique<LayoutInstance>(std::move(*_layoutDocument.get()), _widgets, _bindings);
+	_screen->setWindowSize(_window->getSize());
+
+	// The widgets own what they use now; holding on would keep replaced fonts alive across reloads
+	_layoutDocument = {};
+	_fonts.clear();
+
+	_widgets.remove(*_loadingBar);
+	_loadingBar.reset();
+
+	for (const ResourceLoader::Timing& timing : _loader.getTimings())
+	{
+		std::cout << "Loaded " << timing.path << " in " << timing.load.count() / 1000.f
+			<< " ms (queued " << timing.wait.count() / 1000.f << " ms)" << std::endl;
+	}
+	std::cout << "Screen ready " << _startupClock.getElapsedTime().asMilliseconds() << " ms after start" << std::endl;
+
+	_operatorList = std::make_unique<VirtualList>(
+		[]() -> std::unique_ptr<Widget>
+		{
+			DefaultButtonFactory factory;
+			return factory.createButton("row", { 0.f, 0.f }, { 180.f, 28.f });
+		},
+		[](Widget& row, std::size_t index)
+		{
+			static_cast<Button&>(row).setText("Row " + std::to_string(index));
+		});
+	_operatorList->setRowHeight(28.f);
+	_operatorList->setItemCount(_OPERATOR_ROWS);
+
+	_layout.add(AnchorHorizontal::RIGHT, AnchorVertical::TOP,
+		sf::Vector2f(-10, 90), sf::Vector2f(200, 300),
+		[this](const auto& offset, const auto& size)
+		{
+			_toolPanel.setPosition(offset);
+			_operatorList->setSize(size);
+		});
+
+	_layout.add(AnchorHorizontal::LEFT, AnchorVertical::BOTTOM,
+		sf::Vector2f(10, -10), sf::Vector2f(200, 122),
+		[this](const auto& offset, const auto& size)
+		{
+			_opsPanel.setPosition(offset);
+			_opsPanel.setSize(size);
+		});
+
+	_profilerOverlay = std::make_unique<ProfilerOverlay>();
+	_profilerOverlay->setPosition(sf::Vector2f(430.f, 10.f));
+
+	_toolPanel.add(*_operatorList);
+
+	_widgets.add(_toolPanel);
+	_widgets.add(*_profilerOverlay);
+	_widgets.add(_opsPanel);
+
+	startDownloadWorker();
+	watchResources();
+}
 
+void Engine::startDownloadWorker()
+{
+	// Stops the previous worker first: a reload may have replaced the bar it was feeding
+	_downloadWorker = std::jthread();
 
-	setupAnchors(_buttonAnchors, _buttons,
-		AnchorHorizontal::CENTER,
-		AnchorVertical::BOTTOM,
-		sf::Vector2f(-70, -300),
-		sf::Vector2f(240, 50)
-	);
+	// Stands in for a download reporting progress from its own thread
+	if (ProgressBar* downloadBar = _screen->find<ProgressBar>("download"))
+	{
+		_downloadWorker = std::jthread([this, downloadBar](std::stop_token stopToken)
+			{
+				while (!stopToken.stop_requested())
+				{
+					_downloadReceived = _downloadReceived >= 100.f ? 0.f : _downloadReceived + 0.01f;
+					downloadBar->postValue(_downloadReceived);
+					std::this_thread::sleep_for(std::chrono::microseconds(100));
+				}
+			});
+	}
+}
 
+void Engine::watchResources()
+{
+	_watcher.watch(_layoutPath, [this]() -> UpdateQueue::Command
+		{
+			// Parsed on the watcher thread; the frame only pays for the widgets that changed
+			auto document = std::make_shared<LayoutDocument>(LayoutDocument::load(_layoutPath, _layoutCachePath));
 
-	setupAnchors(_checkboxAnchors, _checkboxes,
-		AnchorHorizontal::LEFT,
-		AnchorVertical::TOP,
-		sf::Vector2f(-0, 20),
-		sf::Vector2f(150, 15)
-	);
+			return [this, document]()
+				{
+					rebuildScreen([&]() { return _screen->reload(std::move(*document)); }, _layoutPath);
+				};
+		});
+
+	watchFonts();
+	_watcher.start();
+}
 
-	setupAnchors(_textFieldsAnchors, _textFields,
-		AnchorHorizontal::CENTER,
-		AnchorVertical::TOP,
-		sf::Vector2f(0, 20),
-		sf::Vector2f(300, 50)
-	);
+void Engine::watchFonts()
+{
+	for (const std::string& path : _screen->getFontPaths())
+	{
+		_watcher.watch(path, [this, path]() -> UpdateQueue::Command
+			{
+				std::shared_ptr<sf::Font> font = FontCache::load(path);
 
+				return [this, path, font]()
+					{
+						FontCache::getInstance().replace(path, font);
+						rebuildScreen([&]() { return _screen->reloadFont(path); }, path);
+					};
+			});
+	}
+}
+
+void Engine::rebuildScreen(const std::function<std::size_t()>& rebuild, const std::string& path)
+{
+	// The worker holds a pointer into the screen; keep it out while widgets are replaced
+	_downloadWorker = std::jthread();
+
+	try
+	{
+		const std::size_t rebuilt = rebuild();
+		std::cout << "Reloaded " << path << ", " << rebuilt << " widgets rebuilt" << std::endl;
+	}
+	catch (const std::exception& exception)
+	{
+		// Runs inside UpdateQueue::drain(): one bad save must leave the previous screen up, not end the app
+		std::cerr << "RESOURCE ERROR: " << exception.what() << std::endl;
+	}
+
+	// A new layout may use fonts nothing watched yet
+	watchFonts();
+	startDownloadWorker();
 }
 
 void Engine::initWindow()
@@ -126,12 +240,14 @@ void Engine::initWindow()
 	{
 		throw WindowNotInitializedException("Game::initWindow() -> ");
 	}
+
+	_canvas.create(_window->getSize());
+	_layout.setWindowSize(_window->getSize());
 }
 
 void Engine::init()
 {
 	initVariables();
-	uploadResources();
 
 	try
 	{
@@ -150,6 +266,8 @@ void Engine::init()
 	{
 		std::cerr << "UNKNOWN ERROR: " << exception.what() << std::endl;
 	}
+
+	uploadResources();
 }
 
 void Engine::update()
@@ -159,106 +277,127 @@ void Engine::update()
 
 	handleInput();
 
-	_volumeBar->handleEvent(*_window, _event);
+	// Before layout, so widgets swapped in by a reload are placed in the same frame
+	UpdateQueue::getInstance().drain();
+
+	if (!_screen)
+	{
+		updateLoading();
+		AnimationScheduler::getInstance().tick();
+		return;
+	}
+
+	_layout.apply();
+	_screen->apply();
+	_profilerOverlay->update();
+	updateOpsPanel();
 
-	const sf::Vector2u windowSize = _window->getSize();
+	AnimationScheduler::getInstance().tick();
 
-	auto updateAnchors = [windowSize](auto& anchors)
+	_operatorList->forEachRow([](Widget& row, std::size_t index)
 		{
-			for (auto& anchor : anchors)
+			Button& button = static_cast<Button&>(row);
+
+			if (button.isClicked())
 			{
-				if (anchor) anchor->update(windowSize);
+				std::cout << "Row " << index << " selected" << std::endl;
 			}
-		};
+		});
+	_operatorList->update();
+	_toolPanel.update(WidgetGroup::getVisibleArea(*_window));
+}
 
-	updateAnchors(_buttonAnchors);
-	updateAnchors(_checkboxAnchors);
-	updateAnchors(_textFieldsAnchors);
+void Engine::updateOpsPanel()
+{
+	_opsPanel.begin();
 
-	for (auto const& textField : _textFields)
+	if (_opsPanel.button("Restart download"))
+	{
+		startDownloadWorker();
+	}
+	if (_opsPanel.button(Profiler::getInstance().isCapturing() ? "Stop trace###trace" : "Capture trace###trace"))
 	{
-		if (textField) textField->handleEvent(*_window, _event);
+		toggleTraceCapture();
 	}
 
-	for (auto const& box : _checkboxes)
+	bool isProfilerShown = _profilerOverlay->isVisible();
+	if (_opsPanel.checkbox("Profiler overlay", isProfilerShown))
 	{
-		if (box) box->handleEvent(*_window, _event);
+		_profilerOverlay->setVisible(isProfilerShown);
 	}
 
-	for (auto const& button : _buttons)
+	// Off runs layout, tweens and widget recording on this thread alone; the frame looks the same either way
+	bool isParallel = JobSystem::getInstance().getWorkerCount() > 0;
+	if (_opsPanel.checkbox("Parallel frame", isParallel))
 	{
-		if (button) button->handleEvent(*_window, _event);
+		JobSystem::getInstance().setWorkerCount(isParallel ? JobSystem::getDefaultWorkerCount() : 0);
 	}
 
-	updateButtons();
+	_opsPanel.end();
 }
 
 void Engine::render()
 {
-	_window->clear();
-
-	_volumeBar->draw(*_window);
-
-	for (auto const& button : _buttons)
-	{
-		button->draw(*_window);
-	}
-
-	for (const auto& box : _checkboxes)
+	if (!_canvas.update(_widgets.getWidgets(), _renderer))
 	{
-		box->draw(*_window);
-	}
-
-	for (const auto& textField : _textFields)
-	{
-		textField->draw(*_window);
+		// Nothing changed: keep the last frame on screen and give the CPU back
+		const sf::Time elapsed = _frameClock.getElapsedTime();
+		if (elapsed < _FRAME_TIME)
+		{
+			sf::sleep(_FRAME_TIME - elapsed);
+		}
+		_frameClock.restart();
+		return;
 	}
 
-
-
+	_window->clear();
+	_canvas.present(*_window);
 	_window->display();
-}
 
-void Engine::updateButtons()
-{
-	if (_buttons.at(0)->isClicked())
-	{
-		std::cout << "Generate..." << std::endl;
-	}
-	else if (_buttons.at(1)->isClicked())
-	{
-		std::cout << "..." << std::endl;
-	}
+	_frameClock.restart();
 }
 
 void Engine::handleInput()
 {
+	_input.poll(*_window);
 
-	while (_window->pollEvent(_event))
+	for (const sf::Event& event : _input)
 	{
-		switch (_event.type)
+		switch (event.type)
 		{
 		case sf::Event::Closed:
 			_window->close();
 			break;
 		case sf::Event::KeyPressed:
-			if (_event.key.code == sf::Keyboard::Escape)
+			if (event.key.code == sf::Keyboard::Escape)
 			{
 				_window->close();
 			}
-			break;
-		case sf::Event::Resized:
-			for (size_t i = 0; i < _buttonAnchors.size() && _checkboxAnchors.size(); ++i)
+			else if (event.key.code == sf::Keyboard::F3 && _profilerOverlay)
+			{
+				_profilerOverlay->setVisible(!_profilerOverlay->isVisible());
+			}
+			else if (event.key.code == sf::Keyboard::F12 && _profilerOverlay)
 			{
-				_buttonAnchors[i]->update(_window->getSize());
-				_checkboxAnchors[i]->update(_window->getSize());
-				_textFields[i]->handleEvent(*_window, _event);
+				toggleTraceCapture();
 			}
 			break;
+		case sf::Event::GainedFocus:
+			_canvas.invalidateAll();
+			break;
+		case sf::Event::Resized:
+			_canvas.create(_window->getSize());
+			_layout.setWindowSize(_window->getSize());
+			if (_screen) _screen->setWindowSize(_window->getSize());
+			break;
 		default:
 			break;
 		}
+
+		_widgets.dispatch(*_window, event);
 	}
+
+	_input.clear();
 }
 
 void Engine::run()
@@ -267,9 +406,35 @@ void Engine::run()
 
 	while (_window->isOpen())
 	{
+		Profiler::getInstance().beginFrame();
 		update();
 		render();
+		Profiler::getInstance().endFrame();
+	}
+}
+
+void Engine::toggleTraceCapture()
+{
+	Profiler& profiler = Profiler::getInstance();
+
+	if (!profiler.isCapturing())
+	{
+		profiler.setEnabled(true);
+		profiler.beginCapture();
+		std::cout << "Trace capture started" << std::endl;
+		return;
+	}
+
+	if (profiler.endCapture(_tracePath))
+	{
+		std::cout << "Trace written to " << _tracePath << std::endl;
+	}
+	else
+	{
+		std::cerr << "RESOURCE ERROR: failed to write " << _tracePath << std::endl;
 	}
+
+	profiler.setEnabled(_profilerOverlay->isVisible());
 }
 
 Engine& Engine::getInstance()
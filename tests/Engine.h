@@ -7,6 +7,8 @@
 #include <memory>
 #include <string>
 #include <vector>
+#include <thread>
+#include <functional>
 
 #include <GraphicsManager.h>
 
@@ -16,7 +18,15 @@ private:
 	void init();
 	void initVariables();
 	void uploadResources();
+	void updateLoading();
+	void finishLoading();
 	void initWindow();
+	void toggleTraceCapture();
+	void watchResources();
+	void watchFonts();
+	void rebuildScreen(const std::function<std::size_t()>& rebuild, const std::string& path);
+	void startDownloadWorker();
+	void updateOpsPanel();
 
 
 	Engine() = default;
@@ -24,22 +34,50 @@ private:
 	Engine(const Engine&) = delete;
 
 	std::unique_ptr<sf::RenderWindow> _window;
-	sf::Event _event{};
+	BatchRenderer _renderer;
+	RetainedCanvas _canvas;
+	sf::Clock _frameClock;
+	const sf::Time _FRAME_TIME = sf::seconds(1.f / 60.f);
+	InputQueue _input;
 	sf::VideoMode _videoMode;
 	std::string _windowTitle;
 
-	std::unique_ptr<ProgressBar> _volumeBar;
+	std::unique_ptr<ProfilerOverlay> _profilerOverlay;
+	std::unique_ptr<VirtualList> _operatorList;
+	// Holds the operator list; declared after it so it lets go of the list first
+	WidgetGroup _toolPanel;
+	// Debug controls, declared every frame in update()
+	ImmediateUi _opsPanel;
+	const std::size_t _OPERATOR_ROWS = 100000;
+	const std::string _tracePath = "profile_trace.json";
 
-	std::vector<std::optional<AnchoredElement>> _buttonAnchors;
-	std::vector<std::optional<AnchoredElement>> _checkboxAnchors;
-	std::vector<std::optional<AnchoredElement>> _textFieldsAnchors;
+	AnchorLayout _layout;
 
-	const std::string _fontPath = RESOURCES_DIR "Fonts/defaultFont.otf";
-	sf::Font _font;
+	WidgetContainer _widgets;
 
-	std::vector<std::unique_ptr<Button>> _buttons;
-	std::vector<std::unique_ptr<CheckBox>> _checkboxes;
-	std::vector<std::unique_ptr<TextField>> _textFields;
+	LayoutBindings _bindings;
+	std::unique_ptr<LayoutInstance> _screen;
+	const std::string _layoutPath = RESOURCES_DIR "Layouts/main.layout";
+	const std::string _layoutCachePath = RESOURCES_DIR "Layouts/main.layoutc";
+
+	ResourceLoader _loader;
+	ResourceHandle<LayoutDocument> _layoutDocument;
+	std::vector<ResourceHandle<const sf::Font>> _fonts;
+	bool _areLayoutFontsQueued = false;
+	// Shown until the screen can be built
+	std::unique_ptr<ProgressBar> _loadingBar;
+	sf::Clock _startupClock;
+
+	ResourceWatcher _watcher{ [](const std::string& path, const std::string& message)
+		{
+			std::cerr << "RESOURCE ERROR: reloading " << path << ": " << message << std::endl;
+		} };
+
+	// Owned by whichever download worker is running
+	float _downloadReceived = 0.f;
+
+	// Declared last so it stops before the widgets it feeds go away
+	std::jthread _downloadWorker;
 
 
 public:
@@ -56,7 +94,6 @@ public:
 	void handleInput();
 	void run();
 	void render();
-	void updateButtons();
 	void update();
 };
 
@@ -0,0 +1,168 @@
+#include <vector>
+#include <cstdlib>
+#include <iostream>
+#include <functional>
+
+#include <SFML/Graphics/RenderTexture.hpp>
+
+#include <WidgetContainer.h>
+
+//--------------------------------------------------------------
+//	Event handlers that destroy widgets in the middle of a
+//	dispatch: the widgets still due the event must be skipped
+//	or reached, never touched after they are gone. Also checks
+//	that a click only focuses widgets that take input.
+//
+//	Usage: WidgetContainerTest
+//	Without a display, run it under a virtual one (xvfb-run) or
+//	with a software GL driver (LIBGL_ALWAYS_SOFTWARE=1).
+//--------------------------------------------------------------
+
+namespace
+{
+	// Outlives the widget, so a handler that destroys its own widget can still be counted
+	struct Probe
+	{
+		int received = 0;
+		bool acceptsInput = true;
+		std::function<void()> onEvent;
+	};
+
+	class ProbeWidget : public Widget
+	{
+	public:
+		ProbeWidget(const sf::FloatRect& bounds, Probe& probe)
+			:_bounds(bounds),
+			_probe(probe)
+		{
+		}
+
+		void draw(sf::RenderTarget&) override {}
+
+		void handleEvent(const sf::RenderTarget&, const sf::Event&) override
+		{
+			// The handler may destroy this widget: nothing of it is used afterwards
+			Probe& probe = _probe;
+			++probe.received;
+			if (probe.onEvent) probe.onEvent();
+		}
+
+		void setPosition(const sf::Vector2f& position) override
+		{
+			_bounds.left = position.x;
+			_bounds.top = position.y;
+			invalidateBounds();
+		}
+
+		void setSize(const sf::Vector2f& size) override
+		{
+			_bounds.width = size.x;
+			_bounds.height = size.y;
+			invalidateBounds();
+		}
+
+		bool acceptsInput() const override
+		{
+			return _probe.acceptsInput;
+		}
+
+		sf::FloatRect getBounds() const override
+		{
+			return _bounds;
+		}
+
+	private:
+		sf::FloatRect _bounds;
+		Probe& _probe;
+	};
+
+	int failures = 0;
+
+	void check(bool condition, const char* what)
+	{
+		if (condition) return;
+
+		std::cerr << "TEST FAILED: " << what << std::endl;
+		++failures;
+	}
+
+	// Three stacked widgets; the bottom one destroys itself and the one above it on the first event
+	void runDestroyingHandler(const sf::RenderTarget& target, const sf::Event& event)
+	{
+		WidgetContainer container;
+		const sf::FloatRect bounds(0.f, 0.f, 32.f, 32.f);
+
+		Probe bottomProbe;
+		Probe middleProbe;
+		Probe topProbe;
+
+		const WidgetHandle<ProbeWidget> bottom = container.create<ProbeWidget>(bounds, bottomProbe);
+		const WidgetHandle<ProbeWidget> middle = container.create<ProbeWidget>(bounds, middleProbe);
+		const WidgetHandle<ProbeWidget> top = container.create<ProbeWidget>(bounds, topProbe);
+
+		bottomProbe.onEvent = [&container, bottom, middle]()
+			{
+				container.destroy(bottom);
+				container.destroy(middle);
+			};
+
+		container.dispatch(target, event);
+
+		check(bottomProbe.received == 1, "the destroying handler runs once");
+		check(middleProbe.received == 0, "a destroyed sibling gets no event");
+		check(topProbe.received == 1, "the widgets after a destroyed one still get the event");
+		check(container.getWidgets().size() == 1, "both destroyed widgets leave the container");
+		check(!container.get(bottom) && !container.get(middle), "handles of destroyed widgets stop resolving");
+
+		std::vector<Widget*> hits;
+		container.widgetsAt({ 16.f, 16.f }, hits);
+		check(hits.size() == 1 && hits.front() == container.get(top), "destroyed widgets leave the spatial index");
+
+		if (event.type == sf::Event::MouseButtonPressed)
+		{
+			check(container.getFocus() == container.get(top), "the click focuses the topmost surviving widget");
+		}
+	}
+
+	// A display-only widget on top, like the profiler overlay, sees the click but leaves the focus below it
+	void runClickThroughOverlay(const sf::RenderTarget& target, const sf::Event& click)
+	{
+		WidgetContainer container;
+		const sf::FloatRect bounds(0.f, 0.f, 32.f, 32.f);
+
+		Probe fieldProbe;
+		Probe overlayProbe;
+		overlayProbe.acceptsInput = false;
+
+		const WidgetHandle<ProbeWidget> field = container.create<ProbeWidget>(bounds, fieldProbe);
+		container.create<ProbeWidget>(bounds, overlayProbe);
+
+		container.dispatch(target, click);
+
+		check(overlayProbe.received == 1 && fieldProbe.received == 1, "both widgets under the click get it");
+		check(container.getFocus() == container.get(field), "a display-only widget never takes the focus");
+	}
+}
+
+int main()
+{
+	sf::RenderTexture texture;
+	if (!texture.create(64, 64))
+	{
+		std::cerr << "TEST ERROR: could not create the render texture" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	sf::Event click{};
+	click.type = sf::Event::MouseButtonPressed;
+	click.mouseButton = { sf::Mouse::Left, 16, 16 };
+	runDestroyingHandler(texture, click);
+	runClickThroughOverlay(texture, click);
+
+	// Not a mouse or keyboard event, so every widget gets it
+	sf::Event lostFocus{};
+	lostFocus.type = sf::Event::LostFocus;
+	runDestroyingHandler(texture, lostFocus);
+
+	return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+#include <string>
+#include <cstdlib>
+#include <sstream>
+#include <iostream>
+#include <filesystem>
+
+#include <Graphics/Rendering/TextureAtlas.h>
+
+//--------------------------------------------------------------
+//	Packs skin and icon images into an atlas ahead of time, so
+//	the program only loads the pages (PackedAtlas::load) instead
+//	of packing on every start.
+//
+//	Usage: AtlasPacker <index> <image[:left,top,right,bottom]>...
+//	Regions are named after the image file without extension;
+//	the optional numbers are its nine-slice borders.
+//--------------------------------------------------------------
+
+namespace
+{
+	bool parseSlice(const std::string& text, NineSlice& slice)
+	{
+		std::istringstream stream(text);
+		char first = 0;
+		char second = 0;
+		char third = 0;
+
+		stream >> slice.left >> first >> slice.top >> second >> slice.right >> third >> slice.bottom;
+
+		return stream && first == ',' && second == ',' && third == ',' && (stream >> std::ws).eof();
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 3)
+	{
+		std::cerr << "Usage: " << argv[0] << " <index> <image[:left,top,right,bottom]>..." << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	try
+	{
+		TextureAtlasBuilder builder;
+
+		for (int i = 2; i < argc; ++i)
+		{
+			std::string path = argv[i];
+			NineSlice slice;
+
+			// Only a trailing border list counts, so Windows drive letters pass through
+			const std::size_t separator = path.rfind(':');
+			if (separator != std::string::npos && parseSlice(path.substr(separator + 1), slice))
+			{
+				path.erase(separator);
+			}
+
+			builder.addFile(std::filesystem::path(path).stem().string(), path, slice);
+		}
+
+		const PackedAtlas packed = builder.pack();
+		if (!packed.save(argv[1]))
+		{
+			std::cerr << "Failed to write " << argv[1] << std::endl;
+			return EXIT_FAILURE;
+		}
+
+		std::cout << "Packed " << builder.size() << " images into " << packed.pages.size() << " page(s)" << std::endl;
+	}
+	catch (const std::exception& exception)
+	{
+		std::cerr << "ATLAS ERROR: " << exception.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
\ No newline at end of file